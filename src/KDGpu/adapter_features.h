@@ -116,6 +116,8 @@ struct AdapterFeatures {
     bool samplerYCbCrConversion;
     bool dynamicRendering;
     bool dynamicRenderingLocalRead;
+    bool drawIndirectCount;
+    bool descriptorBuffer;
 };
 
 /*! @} */
@@ -69,6 +69,33 @@ void BindGroup::update(const BindGroupEntry &entry)
     apiBindGroup->update(entry);
 }
 
+/**
+ * @brief Updates the resources bound at each of @a entries.
+ *
+ * All the writes are submitted to the driver at once, which is considerably cheaper than calling
+ * update() once per entry when many bindings change (e.g. large bindless arrays).
+ */
+void BindGroup::update(std::span<const BindGroupEntry> entries)
+{
+    auto *apiBindGroup = m_api->resourceManager()->getBindGroup(m_bindGroup);
+    apiBindGroup->update(entries);
+}
+
+/**
+ * @brief Rewrites every descriptor of the BindGroup from @a resources using a descriptor update
+ * template owned by the BindGroupLayout.
+ *
+ * @a resources must hold exactly one BindingResource per descriptor of the layout, ordered by
+ * binding index and then by array element. This skips building a write per entry and is the
+ * fastest way to refresh a BindGroup whose contents are rewritten every frame. Layouts with
+ * variable sized bindings are not supported.
+ */
+void BindGroup::updateWithTemplate(std::span<const BindingResource> resources)
+{
+    auto *apiBindGroup = m_api->resourceManager()->getBindGroup(m_bindGroup);
+    apiBindGroup->updateWithTemplate(resources);
+}
+
 bool operator==(const BindGroup &a, const BindGroup &b)
 {
     return a.m_api == b.m_api && a.m_device == b.m_device && a.m_bindGroup == b.m_bindGroup;
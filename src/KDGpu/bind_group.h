@@ -14,9 +14,12 @@
 #include <KDGpu/kdgpu_export.h>
 #include <KDGpu/graphics_api.h>
 
+#include <span>
+
 namespace KDGpu {
 
 struct BindGroupEntry;
+class BindingResource;
 struct BindGroup_t;
 struct Device_t;
 struct BindGroupOptions;
@@ -47,6 +50,8 @@ public:
     operator Handle<BindGroup_t>() const noexcept { return m_bindGroup; }
 
     void update(const BindGroupEntry &entry);
+    void update(std::span<const BindGroupEntry> entries);
+    void updateWithTemplate(std::span<const BindingResource> resources);
 
 private:
     explicit BindGroup(GraphicsApi *api, const Handle<Device_t> &device, const BindGroupOptions &options);
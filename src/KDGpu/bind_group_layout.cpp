@@ -54,6 +54,9 @@ bool BindGroupLayout::isCompatibleWith(const Handle<BindGroupLayout_t> &other) c
 {
     if (!isValid() || !other.isValid())
         return false;
+    // Identical layouts share a handle when interned (see DeviceOptions::deduplicateLayouts)
+    if (handle() == other)
+        return true;
 
     auto *apiLayout = m_api->resourceManager()->getBindGroupLayout(handle());
     auto *otherApiLayout = m_api->resourceManager()->getBindGroupLayout(other);
@@ -61,6 +61,7 @@ struct hash<KDGpu::BindGroupLayoutOptions> {
                 KDGpu::hash_combine(hash, sampler);
             }
         }
+        KDGpu::hash_combine(hash, options.flags.toInt());
         return hash;
     }
 };
@@ -0,0 +1,44 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace KDGpu {
+
+/**
+ * @brief Number of descriptors of each type, as found in BindGroupPoolOptions.
+ */
+struct BindGroupDescriptorCounts {
+    uint64_t uniformBufferCount{ 0 };
+    uint64_t dynamicUniformBufferCount{ 0 };
+    uint64_t storageBufferCount{ 0 };
+    uint64_t textureSamplerCount{ 0 };
+    uint64_t textureCount{ 0 };
+    uint64_t samplerCount{ 0 };
+    uint64_t imageCount{ 0 };
+    uint64_t inputAttachmentCount{ 0 };
+    uint64_t accelerationStructureCount{ 0 };
+};
+
+/**
+ * @brief Counters reported by the Device for the BindGroupPools it manages internally.
+ */
+struct BindGroupPoolStatistics {
+    uint32_t poolCount{ 0 };
+    uint32_t bindGroupCapacity{ 0 }; // Sum of maxBindGroupCount over the internal pools
+    uint32_t allocatedBindGroupCount{ 0 }; // BindGroups currently allocated from the internal pools
+    uint64_t totalBindGroupAllocations{ 0 }; // BindGroups allocated from the internal pools since the Device was created
+    BindGroupDescriptorCounts descriptorCapacity; // Summed over the internal pools
+    BindGroupDescriptorCounts totalDescriptorAllocations; // Descriptors allocated from the internal pools since the Device was created
+};
+
+} // namespace KDGpu
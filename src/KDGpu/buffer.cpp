@@ -74,16 +74,34 @@ void Buffer::unmap()
     m_mapped = nullptr;
 }
 
-void Buffer::invalidate()
+void Buffer::invalidate(DeviceSize offset, DeviceSize size)
 {
     auto apiBuffer = m_api->resourceManager()->getBuffer(m_buffer);
-    apiBuffer->invalidate();
+    apiBuffer->invalidate(offset, size);
 }
 
-void Buffer::flush()
+void Buffer::invalidate(std::span<const MappedBufferRange> ranges)
 {
     auto apiBuffer = m_api->resourceManager()->getBuffer(m_buffer);
-    apiBuffer->flush();
+    apiBuffer->invalidate(ranges);
+}
+
+void Buffer::flush(DeviceSize offset, DeviceSize size)
+{
+    auto apiBuffer = m_api->resourceManager()->getBuffer(m_buffer);
+    apiBuffer->flush(offset, size);
+}
+
+void Buffer::flush(std::span<const MappedBufferRange> ranges)
+{
+    auto apiBuffer = m_api->resourceManager()->getBuffer(m_buffer);
+    apiBuffer->flush(ranges);
+}
+
+bool Buffer::isHostCoherent() const
+{
+    auto apiBuffer = m_api->resourceManager()->getBuffer(m_buffer);
+    return apiBuffer->hostCoherent;
 }
 
 MemoryHandle Buffer::externalMemoryHandle() const
@@ -15,6 +15,8 @@
 #include <KDGpu/gpu_core.h>
 #include <KDGpu/graphics_api.h>
 
+#include <span>
+
 namespace KDGpu {
 
 struct Device_t;
@@ -45,8 +47,11 @@ public:
     void *map();
     void unmap();
 
-    void invalidate();
-    void flush();
+    void invalidate(DeviceSize offset = 0, DeviceSize size = WholeSize);
+    void invalidate(std::span<const MappedBufferRange> ranges);
+    void flush(DeviceSize offset = 0, DeviceSize size = WholeSize);
+    void flush(std::span<const MappedBufferRange> ranges);
+    bool isHostCoherent() const;
 
     MemoryHandle externalMemoryHandle() const;
     BufferDeviceAddress bufferDeviceAddress() const;
@@ -24,6 +24,9 @@ struct BufferOptions {
     SharingMode sharingMode{ SharingMode::Exclusive };
     std::vector<uint32_t> queueTypeIndices{};
     ExternalMemoryHandleTypeFlags externalMemoryHandleType{ ExternalMemoryHandleTypeFlagBits::None };
+    // If true and memoryUsage results in host visible memory, the buffer is mapped once on creation and stays
+    // mapped for its whole lifetime. map() then only returns the pointer and unmap() does nothing.
+    bool persistentlyMapped{ false };
 };
 
 } // namespace KDGpu
@@ -0,0 +1,26 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace KDGpu {
+
+/**
+ * @brief Counters reported by the Device for its internal resource caches.
+ */
+struct CacheStatistics {
+    uint64_t hits{ 0 };
+    uint64_t misses{ 0 };
+    uint32_t entryCount{ 0 }; // Number of distinct resources currently held by the cache
+};
+
+} // namespace KDGpu
@@ -0,0 +1,77 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include "command_pool.h"
+
+#include <KDGpu/api/graphics_api_impl.h>
+
+namespace KDGpu {
+
+CommandPool::CommandPool() = default;
+
+CommandPool::CommandPool(CommandPool &&other) noexcept
+{
+    m_api = std::exchange(other.m_api, nullptr);
+    m_device = std::exchange(other.m_device, {});
+    m_commandPool = std::exchange(other.m_commandPool, {});
+}
+
+CommandPool &CommandPool::operator=(CommandPool &&other) noexcept
+{
+    if (this != &other) {
+
+        if (isValid())
+            m_api->resourceManager()->deleteCommandPool(handle());
+
+        m_api = std::exchange(other.m_api, nullptr);
+        m_device = std::exchange(other.m_device, {});
+        m_commandPool = std::exchange(other.m_commandPool, {});
+    }
+    return *this;
+}
+
+CommandPool::CommandPool(GraphicsApi *api, const Handle<Device_t> &device, const CommandPoolOptions &options)
+    : m_api(api)
+    , m_device(device)
+    , m_commandPool(m_api->resourceManager()->createCommandPool(m_device, options))
+{
+}
+
+CommandPool::~CommandPool()
+{
+    if (isValid())
+        m_api->resourceManager()->deleteCommandPool(handle());
+}
+
+/**
+ * @brief Returns all command buffers recorded from this pool to the pool
+ *
+ * The command buffers are kept allocated and handed out again by subsequent
+ * recordings. This must only be called once the GPU has finished executing
+ * them, any CommandBuffer recorded from this pool must not be submitted
+ * afterwards.
+ */
+void CommandPool::reset()
+{
+    if (isValid())
+        m_api->resourceManager()->resetCommandPool(handle());
+}
+
+bool operator==(const CommandPool &a, const CommandPool &b)
+{
+    return a.m_api == b.m_api && a.m_device == b.m_device && a.m_commandPool == b.m_commandPool;
+}
+
+bool operator!=(const CommandPool &a, const CommandPool &b)
+{
+    return !(a == b);
+}
+
+} // namespace KDGpu
@@ -0,0 +1,71 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpu/handle.h>
+#include <KDGpu/kdgpu_export.h>
+#include <KDGpu/graphics_api.h>
+
+#include <string_view>
+
+namespace KDGpu {
+
+struct CommandPool_t;
+struct Device_t;
+struct Queue_t;
+
+struct CommandPoolOptions {
+    std::string_view label;
+    Handle<Queue_t> queue; // Command buffers allocated from the pool can be submitted on queues of the same family. If not set, defaults to first queue of the device
+};
+
+/**
+ * @brief CommandPool
+ * @ingroup public
+ *
+ * Command buffers recorded through a CommandPool are recycled rather than freed
+ * and all of them are returned to the pool at once by reset(). A CommandPool
+ * must only be used from one thread at a time.
+ */
+class KDGPU_EXPORT CommandPool
+{
+public:
+    CommandPool();
+    ~CommandPool();
+
+    CommandPool(CommandPool &&) noexcept;
+    CommandPool &operator=(CommandPool &&) noexcept;
+
+    CommandPool(const CommandPool &) = delete;
+    CommandPool &operator=(const CommandPool &) = delete;
+
+    const Handle<CommandPool_t> &handle() const noexcept { return m_commandPool; }
+    bool isValid() const noexcept { return m_commandPool.isValid(); }
+
+    operator Handle<CommandPool_t>() const noexcept { return m_commandPool; }
+
+    void reset();
+
+private:
+    explicit CommandPool(GraphicsApi *api, const Handle<Device_t> &device, const CommandPoolOptions &options);
+
+    GraphicsApi *m_api{ nullptr };
+    Handle<Device_t> m_device;
+    Handle<CommandPool_t> m_commandPool;
+
+    friend KDGPU_EXPORT bool operator==(const CommandPool &, const CommandPool &);
+    friend class Device;
+};
+
+KDGPU_EXPORT bool operator==(const CommandPool &a, const CommandPool &b);
+KDGPU_EXPORT bool operator!=(const CommandPool &a, const CommandPool &b);
+
+} // namespace KDGpu
@@ -26,6 +26,7 @@ namespace KDGpu {
 
 class VulkanGraphicsApi;
 
+struct CommandPool_t;
 struct CommandRecorder_t;
 struct Device_t;
 struct Queue_t;
@@ -33,6 +34,7 @@ struct Queue_t;
 struct CommandRecorderOptions {
     Handle<Queue_t> queue; // The queue on which you wish to submit the recorded commands. If not set, defaults to first queue of the device
     CommandBufferLevel level{ CommandBufferLevel::Primary };
+    Handle<CommandPool_t> commandPool; // If set, the command buffer is recycled from this pool instead of being allocated. Its queue family takes precedence over queue
 };
 
 struct BufferCopy {
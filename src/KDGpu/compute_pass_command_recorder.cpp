@@ -62,6 +62,20 @@ void ComputePassCommandRecorder::setBindGroup(uint32_t group, const Handle<BindG
     apiComputePassCommandRecorder->setBindGroup(group, bindGroup, pipelineLayout, dynamicBufferOffsets);
 }
 
+/**
+ * @brief Binds several bind groups to consecutive sets starting at firstGroup
+ *
+ * This records a single command. dynamicBufferOffsets holds the dynamic
+ * offsets of all the bind groups, in set and binding order.
+ */
+void ComputePassCommandRecorder::setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                                               const Handle<PipelineLayout_t> &pipelineLayout,
+                                               std::span<const uint32_t> dynamicBufferOffsets)
+{
+    auto *apiComputePassCommandRecorder = m_api->resourceManager()->getComputePassCommandRecorder(m_computePassCommandRecorder);
+    apiComputePassCommandRecorder->setBindGroups(firstGroup, bindGroups, pipelineLayout, dynamicBufferOffsets);
+}
+
 void ComputePassCommandRecorder::dispatchCompute(const ComputeCommand &command)
 {
     auto *apiComputePassCommandRecorder = m_api->resourceManager()->getComputePassCommandRecorder(m_computePassCommandRecorder);
@@ -100,6 +114,18 @@ void ComputePassCommandRecorder::pushBindGroup(uint32_t group,
     apiComputePassCommandRecorder->pushBindGroup(group, bindGroupEntries, pipelineLayout);
 }
 
+/**
+ * @brief Template based variant of pushBindGroup(), see
+ * RenderPassCommandRecorder::pushBindGroupWithTemplate().
+ */
+void ComputePassCommandRecorder::pushBindGroupWithTemplate(uint32_t group,
+                                                           std::span<const BindingResource> resources,
+                                                           const Handle<PipelineLayout_t> &pipelineLayout)
+{
+    auto *apiComputePassCommandRecorder = m_api->resourceManager()->getComputePassCommandRecorder(m_computePassCommandRecorder);
+    apiComputePassCommandRecorder->pushBindGroupWithTemplate(group, resources, pipelineLayout);
+}
+
 void ComputePassCommandRecorder::end()
 {
     auto *apiComputePassCommandRecorder = m_api->resourceManager()->getComputePassCommandRecorder(m_computePassCommandRecorder);
@@ -26,6 +26,7 @@ struct ComputePipeline_t;
 struct ComputePassCommandRecorder_t;
 struct PipelineLayout_t;
 struct BindGroupEntry;
+class BindingResource;
 
 struct PushConstantRange;
 
@@ -68,6 +69,9 @@ public:
     void setBindGroup(uint32_t group, const Handle<BindGroup_t> &bindGroup,
                       const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>(),
                       std::span<const uint32_t> dynamicBufferOffsets = {});
+    void setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                       const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>(),
+                       std::span<const uint32_t> dynamicBufferOffsets = {});
 
     void dispatchCompute(const ComputeCommand &command);
     void dispatchCompute(std::span<const ComputeCommand> commands);
@@ -79,6 +83,9 @@ public:
     void pushBindGroup(uint32_t group,
                        std::span<const BindGroupEntry> bindGroupEntries,
                        const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>());
+    void pushBindGroupWithTemplate(uint32_t group,
+                                   std::span<const BindingResource> resources,
+                                   const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>());
 
     void end();
 
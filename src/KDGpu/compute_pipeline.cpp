@@ -31,6 +31,15 @@ ComputePipeline::ComputePipeline(GraphicsApi *api,
 {
 }
 
+ComputePipeline::ComputePipeline(GraphicsApi *api,
+                                 const Handle<Device_t> &device,
+                                 const Handle<ComputePipeline_t> &computePipeline)
+    : m_api(api)
+    , m_device(device)
+    , m_computePipeline(computePipeline)
+{
+}
+
 ComputePipeline::ComputePipeline(ComputePipeline &&other) noexcept
 {
     m_api = std::exchange(other.m_api, nullptr);
@@ -45,6 +45,9 @@ private:
     explicit ComputePipeline(GraphicsApi *api,
                              const Handle<Device_t> &device,
                              const ComputePipelineOptions &options);
+    explicit ComputePipeline(GraphicsApi *api,
+                             const Handle<Device_t> &device,
+                             const Handle<ComputePipeline_t> &computePipeline); // From batch creation
 
     GraphicsApi *m_api{ nullptr };
     Handle<Device_t> m_device;
@@ -12,6 +12,8 @@
 
 #include <KDGpu/adapter.h>
 #include <KDGpu/device_options.h>
+#include <KDGpu/compute_pipeline_options.h>
+#include <KDGpu/graphics_pipeline_options.h>
 #include <KDGpu/api/graphics_api_impl.h>
 #include <KDGpu/swapchain_options.h>
 
@@ -107,6 +109,57 @@ const Adapter *Device::adapter() const
     return m_adapter;
 }
 
+/**
+ * @brief Returns the current content of the Device's pipeline cache.
+ *
+ * All pipelines created by the Device go through this cache. The returned data can be
+ * stored and passed back through DeviceOptions::pipelineCacheData on the next run to
+ * avoid recompiling pipelines that were already built.
+ *
+ * @sa DeviceOptions::pipelineCacheFilePath
+ */
+std::vector<uint8_t> Device::pipelineCacheData() const
+{
+    auto apiDevice = m_api->resourceManager()->getDevice(m_device);
+    return apiDevice->pipelineCacheData();
+}
+
+/**
+ * @brief Returns the hit and miss counters of the graphics pipeline registry.
+ *
+ * The registry is only active if the Device was created with
+ * DeviceOptions::deduplicateGraphicsPipelines set, otherwise all counters are 0.
+ * The entry count is the number of distinct pipelines currently alive.
+ */
+CacheStatistics Device::graphicsPipelineRegistryStatistics() const
+{
+    return m_api->resourceManager()->graphicsPipelineRegistryStatistics(m_device);
+}
+
+/**
+ * @brief Returns statistics about the BindGroupPools the Device manages internally.
+ *
+ * Internal pools are used by BindGroups created without an explicit
+ * BindGroupOptions::bindGroupPool. Once the first internal pool runs out,
+ * additional pools are sized from the descriptor types actually consumed so far.
+ */
+BindGroupPoolStatistics Device::internalBindGroupPoolStatistics() const
+{
+    return m_api->resourceManager()->internalBindGroupPoolStatistics(m_device);
+}
+
+/**
+ * @brief Returns the hit and miss counters of the sampler cache.
+ *
+ * The cache is only active if the Device was created with
+ * DeviceOptions::deduplicateSamplers set, otherwise all counters are 0.
+ * The entry count is the number of distinct samplers currently alive.
+ */
+CacheStatistics Device::samplerCacheStatistics() const
+{
+    return m_api->resourceManager()->samplerCacheStatistics(m_device);
+}
+
 /**
  * @brief Forces a CPU side blocking wait until the underlying device has completed execution of all its pending commands.
  */
@@ -151,21 +204,142 @@ GraphicsPipeline Device::createGraphicsPipeline(const GraphicsPipelineOptions &o
     return GraphicsPipeline(m_api, m_device, options);
 }
 
+/**
+ * @brief Creates several GraphicsPipelines at once.
+ *
+ * All pipelines are handed to the driver in a single call, which allows it to
+ * compile them in parallel. The returned pipelines are in the same order as
+ * @a options. A pipeline that failed to be created is returned as an invalid
+ * GraphicsPipeline without affecting the others.
+ */
+std::vector<GraphicsPipeline> Device::createGraphicsPipelines(std::span<const GraphicsPipelineOptions> options)
+{
+    const std::vector<Handle<GraphicsPipeline_t>> handles = m_api->resourceManager()->createGraphicsPipelines(m_device, options);
+    std::vector<GraphicsPipeline> pipelines;
+    pipelines.reserve(handles.size());
+    for (const Handle<GraphicsPipeline_t> &handle : handles)
+        pipelines.emplace_back(GraphicsPipeline(m_api, m_device, handle));
+    return pipelines;
+}
+
+/**
+ * @brief Compiles a GraphicsPipeline on a worker thread.
+ *
+ * The options are copied, so they do not need to outlive the call. The shader modules,
+ * pipeline layout and render pass they reference however must remain valid until the
+ * returned future is ready. Use std::future::wait_for with a zero timeout to poll for
+ * completion without blocking the calling thread.
+ *
+ * The worker threads are owned by the Device and are joined when the Device is
+ * destroyed, after any pending compilations have completed.
+ */
+std::future<GraphicsPipeline> Device::createGraphicsPipelineAsync(const GraphicsPipelineOptions &options)
+{
+    auto apiDevice = m_api->resourceManager()->getDevice(m_device);
+    return apiDevice->pipelineCompilationThreadPool()->enqueue(
+            [api = m_api, device = m_device, options, label = std::string(options.label)]() mutable {
+                options.label = label;
+                return GraphicsPipeline(api, device, options);
+            });
+}
+
 ComputePipeline Device::createComputePipeline(const ComputePipelineOptions &options)
 {
     return ComputePipeline(m_api, m_device, options);
 }
 
+/**
+ * @brief Creates several ComputePipelines at once.
+ *
+ * Behaves like createGraphicsPipelines() but for compute pipelines.
+ */
+std::vector<ComputePipeline> Device::createComputePipelines(std::span<const ComputePipelineOptions> options)
+{
+    const std::vector<Handle<ComputePipeline_t>> handles = m_api->resourceManager()->createComputePipelines(m_device, options);
+    std::vector<ComputePipeline> pipelines;
+    pipelines.reserve(handles.size());
+    for (const Handle<ComputePipeline_t> &handle : handles)
+        pipelines.emplace_back(ComputePipeline(m_api, m_device, handle));
+    return pipelines;
+}
+
+/**
+ * @brief Compiles a ComputePipeline on a worker thread.
+ *
+ * Behaves like createGraphicsPipelineAsync() but for compute pipelines.
+ */
+std::future<ComputePipeline> Device::createComputePipelineAsync(const ComputePipelineOptions &options)
+{
+    auto apiDevice = m_api->resourceManager()->getDevice(m_device);
+    return apiDevice->pipelineCompilationThreadPool()->enqueue(
+            [api = m_api, device = m_device, options, label = std::string(options.label)]() mutable {
+                options.label = label;
+                return ComputePipeline(api, device, options);
+            });
+}
+
 RayTracingPipeline Device::createRayTracingPipeline(const RayTracingPipelineOptions &options)
 {
     return RayTracingPipeline(m_api, m_device, options);
 }
 
+/**
+ * @brief Creates several RayTracingPipelines at once.
+ *
+ * Behaves like createGraphicsPipelines() but for ray tracing pipelines.
+ */
+std::vector<RayTracingPipeline> Device::createRayTracingPipelines(std::span<const RayTracingPipelineOptions> options)
+{
+    const std::vector<Handle<RayTracingPipeline_t>> handles = m_api->resourceManager()->createRayTracingPipelines(m_device, options);
+    std::vector<RayTracingPipeline> pipelines;
+    pipelines.reserve(handles.size());
+    for (const Handle<RayTracingPipeline_t> &handle : handles)
+        pipelines.emplace_back(RayTracingPipeline(m_api, m_device, handle));
+    return pipelines;
+}
+
+/**
+ * @brief Create a CommandPool
+ *
+ * Command buffers recorded through an explicit CommandPool (see
+ * CommandRecorderOptions::commandPool) are recycled by CommandPool::reset()
+ * instead of being individually allocated and freed.
+ */
+CommandPool Device::createCommandPool(const CommandPoolOptions &options)
+{
+    return CommandPool(m_api, m_device, options);
+}
+
+/**
+ * @brief Create a CommandRecorder
+ *
+ * Command buffers are allocated from a command pool dedicated to the calling
+ * thread and the queue family, so several threads can record CommandRecorders
+ * concurrently. A CommandRecorder must be recorded and finished on the thread
+ * that created it, the resulting CommandBuffer can then be submitted and
+ * destroyed from any thread.
+ *
+ * @sa releaseThreadCommandPools()
+ */
 CommandRecorder Device::createCommandRecorder(const CommandRecorderOptions &options)
 {
     return CommandRecorder(m_api, m_device, options);
 }
 
+/**
+ * @brief Releases the command pools createCommandRecorder() created for the calling thread.
+ *
+ * Worker threads should call this before exiting, otherwise their pools are
+ * only destroyed with the Device. A pool whose CommandBuffers are still alive
+ * is destroyed once the last of them is. The next CommandRecorder created on
+ * the calling thread gets a new pool.
+ */
+void Device::releaseThreadCommandPools()
+{
+    auto apiDevice = m_api->resourceManager()->getDevice(m_device);
+    apiDevice->releaseThreadCommandPools();
+}
+
 GpuSemaphore Device::createGpuSemaphore(const GpuSemaphoreOptions &options)
 {
     return GpuSemaphore(m_api, m_device, options);
@@ -13,7 +13,10 @@
 #include <KDGpu/bind_group.h>
 #include <KDGpu/bind_group_layout.h>
 #include <KDGpu/bind_group_pool.h>
+#include <KDGpu/bind_group_pool_statistics.h>
 #include <KDGpu/buffer.h>
+#include <KDGpu/cache_statistics.h>
+#include <KDGpu/command_pool.h>
 #include <KDGpu/command_recorder.h>
 #include <KDGpu/compute_pipeline.h>
 #include <KDGpu/fence.h>
@@ -34,6 +37,7 @@
 
 #include <KDGpu/kdgpu_export.h>
 
+#include <future>
 #include <span>
 #include <vector>
 
@@ -79,6 +83,11 @@ public:
 
     [[nodiscard]] const Adapter *adapter() const;
 
+    [[nodiscard]] std::vector<uint8_t> pipelineCacheData() const;
+    [[nodiscard]] CacheStatistics graphicsPipelineRegistryStatistics() const;
+    [[nodiscard]] BindGroupPoolStatistics internalBindGroupPoolStatistics() const;
+    [[nodiscard]] CacheStatistics samplerCacheStatistics() const;
+
     [[nodiscard]] Swapchain createSwapchain(const SwapchainOptions &options);
     [[nodiscard]] Texture createTexture(const TextureOptions &options);
 
@@ -95,12 +104,20 @@ public:
     [[nodiscard]] PipelineLayout createPipelineLayout(const PipelineLayoutOptions &options = PipelineLayoutOptions());
 
     [[nodiscard]] GraphicsPipeline createGraphicsPipeline(const GraphicsPipelineOptions &options);
+    [[nodiscard]] std::future<GraphicsPipeline> createGraphicsPipelineAsync(const GraphicsPipelineOptions &options);
+    [[nodiscard]] std::vector<GraphicsPipeline> createGraphicsPipelines(std::span<const GraphicsPipelineOptions> options);
 
     [[nodiscard]] ComputePipeline createComputePipeline(const ComputePipelineOptions &options);
+    [[nodiscard]] std::future<ComputePipeline> createComputePipelineAsync(const ComputePipelineOptions &options);
+    [[nodiscard]] std::vector<ComputePipeline> createComputePipelines(std::span<const ComputePipelineOptions> options);
 
     [[nodiscard]] RayTracingPipeline createRayTracingPipeline(const RayTracingPipelineOptions &options);
+    [[nodiscard]] std::vector<RayTracingPipeline> createRayTracingPipelines(std::span<const RayTracingPipelineOptions> options);
+
+    [[nodiscard]] CommandPool createCommandPool(const CommandPoolOptions &options = CommandPoolOptions());
 
     [[nodiscard]] CommandRecorder createCommandRecorder(const CommandRecorderOptions &options = CommandRecorderOptions());
+    void releaseThreadCommandPools();
 
     [[nodiscard]] GpuSemaphore createGpuSemaphore(const GpuSemaphoreOptions &options = GpuSemaphoreOptions());
 
@@ -35,6 +35,21 @@ struct DeviceOptions {
     std::vector<QueueRequest> queues;
     AdapterFeatures requestedFeatures;
     AdapterGroup adapterGroup;
+    // Initial content of the pipeline cache, as previously returned by Device::pipelineCacheData().
+    // Data that was produced by a different adapter or driver is discarded.
+    std::vector<uint8_t> pipelineCacheData;
+    // If set, the pipeline cache is seeded from this file when the Device is created
+    // and its content is written back to it when the Device is destroyed.
+    std::string pipelineCacheFilePath;
+    // If true, GraphicsPipelines created with identical GraphicsPipelineOptions (ignoring the label)
+    // share the same underlying pipeline, which is only destroyed once all of them have been released.
+    bool deduplicateGraphicsPipelines{ false };
+    // If true, BindGroupLayouts and PipelineLayouts created with identical options (ignoring the label)
+    // share the same handle, so that layout compatibility checks boil down to comparing handles.
+    bool deduplicateLayouts{ false };
+    // If true, Samplers created with identical SamplerOptions (ignoring the label) share the same
+    // underlying sampler, which helps staying below AdapterLimits::maxSamplerAllocationCount.
+    bool deduplicateSamplers{ false };
 };
 
 } // namespace KDGpu
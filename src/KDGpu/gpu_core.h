@@ -701,6 +701,12 @@ enum class TextureAspectFlagBits : uint32_t {
 };
 using TextureAspectFlags = KDGpu::Flags<TextureAspectFlagBits>;
 
+// Byte range of a mapped buffer to flush or invalidate
+struct MappedBufferRange {
+    DeviceSize offset{ 0 };
+    DeviceSize size{ WholeSize };
+};
+
 struct TextureSubresourceRange {
     TextureAspectFlags aspectMask{ TextureAspectFlagBits::None };
     uint32_t baseMipLevel{ 0 };
@@ -1300,6 +1306,7 @@ enum class BindGroupPoolFlagBits {
     CreateFreeBindGroups = 0x00000001,
     UpdateAfterBind = 0x00000002,
     CreateHostOnly = 0x00000004,
+    DescriptorBuffer = 0x00010000, // BindGroups are written into a descriptor buffer instead of being allocated from a descriptor pool. Requires AdapterFeatures::descriptorBuffer
 };
 using BindGroupPoolFlags = KDGpu::Flags<BindGroupPoolFlagBits>;
 
@@ -1307,6 +1314,7 @@ enum class BindGroupLayoutFlagBits {
     None = 0,
     PushBindGroup = 0x00000001, // BindGroup to be used with RenderPassCommandRecorder::pushBindGroup and not allocated from a BindGroupPool
     UpdateAfterBind = 0x00000002, // BindGroups will have to be allocated with a BindGroupPool that was created with BindGroupPoolFlagBits::UpdateAfterBind
+    DescriptorBuffer = 0x00000010, // BindGroups will have to be allocated with a BindGroupPool that was created with BindGroupPoolFlagBits::DescriptorBuffer
 };
 using BindGroupLayoutFlags = KDGpu::Flags<BindGroupLayoutFlagBits>;
 
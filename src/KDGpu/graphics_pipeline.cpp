@@ -27,6 +27,15 @@ GraphicsPipeline::GraphicsPipeline(GraphicsApi *api,
 {
 }
 
+GraphicsPipeline::GraphicsPipeline(GraphicsApi *api,
+                                   const Handle<Device_t> &device,
+                                   const Handle<GraphicsPipeline_t> &graphicsPipeline)
+    : m_api(api)
+    , m_device(device)
+    , m_graphicsPipeline(graphicsPipeline)
+{
+}
+
 GraphicsPipeline::GraphicsPipeline(GraphicsPipeline &&other) noexcept
 {
     m_api = std::exchange(other.m_api, nullptr);
@@ -44,6 +44,7 @@ public:
 
 private:
     explicit GraphicsPipeline(GraphicsApi *api, const Handle<Device_t> &device, const GraphicsPipelineOptions &options);
+    explicit GraphicsPipeline(GraphicsApi *api, const Handle<Device_t> &device, const Handle<GraphicsPipeline_t> &graphicsPipeline); // From batch creation
 
     GraphicsApi *m_api{ nullptr };
     Handle<Device_t> m_device;
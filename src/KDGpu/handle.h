@@ -46,7 +46,7 @@ private:
     uint32_t m_index;
     uint32_t m_generation;
 
-    template<typename U, typename V>
+    template<typename U, typename V, bool W>
     friend class Pool;
 };
 
@@ -13,6 +13,7 @@
 #include <KDGpu/gpu_core.h>
 #include <KDGpu/bind_group_layout.h>
 #include <KDGpu/handle.h>
+#include <KDGpu/utils/hash_utils.h>
 
 #include <vector>
 
@@ -32,6 +33,31 @@ struct PipelineLayoutOptions {
     std::string_view label;
     std::vector<Handle<BindGroupLayout_t>> bindGroupLayouts;
     std::vector<PushConstantRange> pushConstantRanges;
+
+    // Equality operator for caching
+    friend bool operator==(const PipelineLayoutOptions &, const PipelineLayoutOptions &) = default;
 };
 
 } // namespace KDGpu
+
+// Hash function for PipelineLayoutOptions to enable caching
+namespace std {
+
+template<>
+struct hash<KDGpu::PipelineLayoutOptions> {
+    size_t operator()(const KDGpu::PipelineLayoutOptions &options) const noexcept
+    {
+        size_t hash = 0;
+        KDGpu::hash_combine(hash, std::hash<std::string_view>()(options.label));
+        for (const auto &bindGroupLayout : options.bindGroupLayouts)
+            KDGpu::hash_combine(hash, bindGroupLayout);
+        for (const auto &pushConstantRange : options.pushConstantRanges) {
+            KDGpu::hash_combine(hash, pushConstantRange.offset);
+            KDGpu::hash_combine(hash, pushConstantRange.size);
+            KDGpu::hash_combine(hash, pushConstantRange.shaderStages.toInt());
+        }
+        return hash;
+    }
+};
+
+} // namespace std
@@ -2,8 +2,14 @@
 
 #include "handle.h"
 
+#include <algorithm>
+#include <array>
 #include <assert.h>
+#include <atomic>
+#include <bit>
 #include <limits>
+#include <mutex>
+#include <new>
 #include <vector>
 #include <KDGpu/utils/logging.h>
 
@@ -22,8 +28,11 @@ namespace KDGpu {
 /**
  * @brief Pool
  * @internal
+ *
+ * The default Pool is not synchronized. Pool<T, H, true> is the variant that can
+ * be shared between threads, see below.
  */
-template<typename T, typename H>
+template<typename T, typename H, bool ThreadSafe = false>
 class Pool
 {
 public:
@@ -159,8 +168,8 @@ private:
     uint32_t m_capacity;
 };
 
-template<typename T, typename H>
-void Pool<T, H>::growCapacity()
+template<typename T, typename H, bool ThreadSafe>
+void Pool<T, H, ThreadSafe>::growCapacity()
 {
     // Keep it simple for now and just double the capacity when we need to grow
     m_capacity *= 2;
@@ -172,4 +181,194 @@ void Pool<T, H>::growCapacity()
     m_freeIndices.reserve(m_capacity);
 }
 
+/**
+ * @brief Pool that can be used from several threads at once
+ * @internal
+ *
+ * get() never takes a lock: entries live in blocks that are never reallocated
+ * and the handle generation is checked with an atomic load. emplace() and remove()
+ * only hold a mutex while picking or releasing a slot; constructing the entry
+ * happens outside of it.
+ *
+ * As with the unsynchronized Pool, removing an entry while another thread still
+ * dereferences it is a usage error.
+ */
+template<typename T, typename H>
+class Pool<T, H, true>
+{
+public:
+    Pool() noexcept
+        : Pool(0)
+    {
+    }
+
+    explicit Pool(uint32_t size) noexcept
+        : m_firstBlockShift(size > 1 ? std::bit_width(size - 1) : 0)
+    {
+    }
+
+    ~Pool()
+    {
+        const uint32_t slotCount = m_slotCount.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < slotCount; ++i)
+            slotAt(i).data()->~T();
+        for (auto &block : m_blocks)
+            delete[] block.load(std::memory_order_relaxed);
+    }
+
+    Pool(Pool const &other) = delete;
+    Pool &operator=(Pool const &other) = delete;
+    Pool(Pool &&other) = delete;
+    Pool &operator=(Pool &&other) = delete;
+
+    uint32_t capacity() const noexcept { return m_capacity.load(std::memory_order_relaxed); }
+    uint32_t size() const noexcept { return m_size.load(std::memory_order_relaxed); }
+
+    T *get(const Handle<H> &handle) const noexcept
+    {
+        if (!canUseHandle(handle))
+            return nullptr;
+        return slotAt(handle.m_index).data();
+    }
+
+    template<typename... Args>
+    Handle<H> emplace(Args &&...args)
+    {
+        uint32_t index = 0;
+        bool reuseSlot = false;
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_freeIndices.empty()) {
+                index = m_freeIndices.back();
+                m_freeIndices.pop_back();
+                reuseSlot = true;
+            } else {
+                index = m_slotCount.load(std::memory_order_relaxed);
+                ensureBlockForIndex(index);
+                m_slotCount.store(index + 1, std::memory_order_release);
+            }
+        }
+
+        Slot &slot = slotAt(index);
+        if (reuseSlot) {
+            // The generation was already bumped when this entry was removed
+            *slot.data() = T(std::forward<Args>(args)...);
+        } else {
+            new (slot.storage) T(std::forward<Args>(args)...);
+            slot.generation.store(1, std::memory_order_relaxed);
+        }
+        slot.isAlive.store(true, std::memory_order_release);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+
+        return Handle<H>(index, slot.generation.load(std::memory_order_relaxed));
+    }
+
+    Handle<H> insert(const T &data)
+    {
+        return emplace(data);
+    }
+
+    void remove(const Handle<H> &handle)
+    {
+        std::lock_guard lock(m_mutex);
+        removeLocked(handle);
+    }
+
+    void clear()
+    {
+        std::lock_guard lock(m_mutex);
+        const uint32_t slotCount = m_slotCount.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < slotCount; ++i)
+            removeLocked(handleForIndex(i));
+    }
+
+    // Convert an entry index into a Handle<H>, if possible otherwise returns an invalid handle
+    Handle<H> handleForIndex(uint32_t entryIndex) const
+    {
+        if (entryIndex >= m_slotCount.load(std::memory_order_acquire))
+            return {};
+        const Slot &slot = slotAt(entryIndex);
+        if (!slot.isAlive.load(std::memory_order_acquire))
+            return {};
+        return Handle<H>{ entryIndex, slot.generation.load(std::memory_order_relaxed) };
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> generation{ 0 };
+        std::atomic<bool> isAlive{ false };
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T *data() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+        const T *data() const noexcept { return std::launder(reinterpret_cast<const T *>(storage)); }
+    };
+
+    // Block b holds 2^(m_firstBlockShift + b) slots, so that the blocks together
+    // cover the whole uint32_t index range without ever being reallocated
+    static constexpr size_t MaxBlockCount = 33;
+
+    struct BlockLocation {
+        uint32_t block;
+        uint64_t offset;
+    };
+
+    BlockLocation locate(uint32_t index) const noexcept
+    {
+        const uint64_t shiftedIndex = uint64_t(index) + (uint64_t(1) << m_firstBlockShift);
+        const uint32_t block = static_cast<uint32_t>(std::bit_width(shiftedIndex)) - 1 - m_firstBlockShift;
+        return { block, shiftedIndex - (uint64_t(1) << (m_firstBlockShift + block)) };
+    }
+
+    Slot &slotAt(uint32_t index) const noexcept
+    {
+        const BlockLocation location = locate(index);
+        return m_blocks[location.block].load(std::memory_order_acquire)[location.offset];
+    }
+
+    void ensureBlockForIndex(uint32_t index)
+    {
+        const BlockLocation location = locate(index);
+        assert(location.block < MaxBlockCount);
+        if (m_blocks[location.block].load(std::memory_order_relaxed) != nullptr)
+            return;
+        const uint64_t blockSize = uint64_t(1) << (m_firstBlockShift + location.block);
+        m_blocks[location.block].store(new Slot[blockSize], std::memory_order_release);
+        m_capacity.store(static_cast<uint32_t>(std::min<uint64_t>(m_capacity.load(std::memory_order_relaxed) + blockSize,
+                                                                  std::numeric_limits<uint32_t>::max())),
+                         std::memory_order_relaxed);
+    }
+
+    bool canUseHandle(const Handle<H> &handle) const noexcept
+    {
+        if (handle.m_index >= m_slotCount.load(std::memory_order_acquire))
+            return false;
+        const Slot &slot = slotAt(handle.m_index);
+        return handle.m_generation == slot.generation.load(std::memory_order_acquire) && slot.isAlive.load(std::memory_order_acquire);
+    }
+
+    void removeLocked(const Handle<H> &handle)
+    {
+        if (!canUseHandle(handle))
+            return;
+
+        // As for the unsynchronized Pool, the contained data dtor is not called here.
+        // Bump the generation so we know not to deref this data from any existing handles
+        Slot &slot = slotAt(handle.m_index);
+        slot.generation.fetch_add(1, std::memory_order_release);
+        slot.isAlive.store(false, std::memory_order_release);
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+
+        // Store the position of the unused slot
+        m_freeIndices.push_back(handle.m_index);
+    }
+
+    const uint32_t m_firstBlockShift;
+    mutable std::array<std::atomic<Slot *>, MaxBlockCount> m_blocks{};
+    std::atomic<uint32_t> m_slotCount{ 0 };
+    std::atomic<uint32_t> m_size{ 0 };
+    std::atomic<uint32_t> m_capacity{ 0 };
+    std::vector<uint32_t> m_freeIndices; // Guarded by m_mutex
+    std::mutex m_mutex;
+};
+
 } // namespace KDGpu
@@ -63,6 +63,20 @@ void RayTracingPassCommandRecorder::setBindGroup(uint32_t group, const Handle<Bi
     apiRayTracingPassCommandRecorder->setBindGroup(group, bindGroup, pipelineLayout, dynamicBufferOffsets);
 }
 
+/**
+ * @brief Binds several bind groups to consecutive sets starting at firstGroup
+ *
+ * This records a single command. dynamicBufferOffsets holds the dynamic
+ * offsets of all the bind groups, in set and binding order.
+ */
+void RayTracingPassCommandRecorder::setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                                                  const Handle<PipelineLayout_t> &pipelineLayout,
+                                                  std::span<const uint32_t> dynamicBufferOffsets)
+{
+    auto *apiRayTracingPassCommandRecorder = m_api->resourceManager()->getRayTracingPassCommandRecorder(m_rayTracingCommandRecorder);
+    apiRayTracingPassCommandRecorder->setBindGroups(firstGroup, bindGroups, pipelineLayout, dynamicBufferOffsets);
+}
+
 void RayTracingPassCommandRecorder::traceRays(const RayTracingCommand &rayTracingCommand)
 {
     auto *apiRayTracingPassCommandRecorder = m_api->resourceManager()->getRayTracingPassCommandRecorder(m_rayTracingCommandRecorder);
@@ -83,6 +97,18 @@ void RayTracingPassCommandRecorder::pushBindGroup(uint32_t group,
     apiRayTracingPassCommandRecorder->pushBindGroup(group, bindGroupEntries, pipelineLayout);
 }
 
+/**
+ * @brief Template based variant of pushBindGroup(), see
+ * RenderPassCommandRecorder::pushBindGroupWithTemplate().
+ */
+void RayTracingPassCommandRecorder::pushBindGroupWithTemplate(uint32_t group,
+                                                              std::span<const BindingResource> resources,
+                                                              const Handle<PipelineLayout_t> &pipelineLayout)
+{
+    auto *apiRayTracingPassCommandRecorder = m_api->resourceManager()->getRayTracingPassCommandRecorder(m_rayTracingCommandRecorder);
+    apiRayTracingPassCommandRecorder->pushBindGroupWithTemplate(group, resources, pipelineLayout);
+}
+
 void RayTracingPassCommandRecorder::end()
 {
     auto *apiRayTracingPassCommandRecorder = m_api->resourceManager()->getRayTracingPassCommandRecorder(m_rayTracingCommandRecorder);
@@ -27,6 +27,7 @@ struct PipelineLayout_t;
 struct RayTracingPipeline_t;
 struct RayTracingPassCommandRecorder_t;
 struct BindGroupEntry;
+class BindingResource;
 
 struct StridedDeviceRegion {
     Handle<Buffer_t> buffer;
@@ -72,6 +73,10 @@ public:
                       const Handle<BindGroup_t> &bindGroup,
                       const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>(),
                       std::span<const uint32_t> dynamicBufferOffsets = {});
+    void setBindGroups(uint32_t firstGroup,
+                       std::span<const Handle<BindGroup_t>> bindGroups,
+                       const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>(),
+                       std::span<const uint32_t> dynamicBufferOffsets = {});
 
     void traceRays(const RayTracingCommand &rayTracingCommand);
 
@@ -80,6 +85,9 @@ public:
     void pushBindGroup(uint32_t group,
                        std::span<const BindGroupEntry> bindGroupEntries,
                        const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>());
+    void pushBindGroupWithTemplate(uint32_t group,
+                                   std::span<const BindingResource> resources,
+                                   const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>());
 
     void end();
 
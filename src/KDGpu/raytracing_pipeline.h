@@ -47,6 +47,9 @@ private:
     explicit RayTracingPipeline(GraphicsApi *api,
                                 const Handle<Device_t> &device,
                                 const RayTracingPipelineOptions &options);
+    explicit RayTracingPipeline(GraphicsApi *api,
+                                const Handle<Device_t> &device,
+                                const Handle<RayTracingPipeline_t> &rayTracingPipeline); // From batch creation
 
     GraphicsApi *m_api{ nullptr };
     Handle<Device_t> m_device;
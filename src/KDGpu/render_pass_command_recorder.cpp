@@ -61,6 +61,18 @@ void RenderPassCommandRecorder::setVertexBuffer(uint32_t index, const Handle<Buf
     apiRenderPassCommandRecorder->setVertexBuffer(index, buffer, offset);
 }
 
+/**
+ * @brief Binds several vertex buffers to consecutive bindings starting at firstBinding
+ *
+ * This records a single command. If offsets is not empty, it must hold one
+ * offset per buffer.
+ */
+void RenderPassCommandRecorder::setVertexBuffers(uint32_t firstBinding, std::span<const Handle<Buffer_t>> buffers, std::span<const DeviceSize> offsets)
+{
+    auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
+    apiRenderPassCommandRecorder->setVertexBuffers(firstBinding, buffers, offsets);
+}
+
 void RenderPassCommandRecorder::setIndexBuffer(const Handle<Buffer_t> &buffer, DeviceSize offset, IndexType indexType)
 {
     auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
@@ -75,6 +87,20 @@ void RenderPassCommandRecorder::setBindGroup(uint32_t group, const Handle<BindGr
     apiRenderPassCommandRecorder->setBindGroup(group, bindGroup, pipelineLayout, dynamicBufferOffsets);
 }
 
+/**
+ * @brief Binds several bind groups to consecutive sets starting at firstGroup
+ *
+ * This records a single command. dynamicBufferOffsets holds the dynamic
+ * offsets of all the bind groups, in set and binding order.
+ */
+void RenderPassCommandRecorder::setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                                              const Handle<PipelineLayout_t> &pipelineLayout,
+                                              std::span<const uint32_t> dynamicBufferOffsets)
+{
+    auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
+    apiRenderPassCommandRecorder->setBindGroups(firstGroup, bindGroups, pipelineLayout, dynamicBufferOffsets);
+}
+
 void RenderPassCommandRecorder::setViewport(const Viewport &viewport)
 {
     auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
@@ -99,6 +125,20 @@ void RenderPassCommandRecorder::end()
     apiRenderPassCommandRecorder->end();
 }
 
+/**
+ * @brief Returns how many state changes were skipped since recording started
+ *
+ * Binding a pipeline, vertex buffer, index buffer or bind group that is
+ * already bound, or setting the current viewport or scissor again, does not
+ * record anything into the command buffer. Neither does an indirect draw
+ * merged into the previous one by drawIndirect(std::span<const DrawIndirectCommand>).
+ */
+RedundantStateStatistics RenderPassCommandRecorder::redundantStateStatistics() const
+{
+    auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
+    return apiRenderPassCommandRecorder->redundantStateStatistics;
+}
+
 void RenderPassCommandRecorder::draw(const DrawCommand &drawCommand)
 {
     auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
@@ -129,6 +169,12 @@ void RenderPassCommandRecorder::drawIndirect(const DrawIndirectCommand &drawComm
     apiRenderPassCommandRecorder->drawIndirect(drawCommand);
 }
 
+/**
+ * @brief Records the indirect draws described by @a drawCommands.
+ *
+ * When the multiDrawIndirect feature was requested on the Device, consecutive commands that read
+ * contiguous records from the same buffer with the same stride are merged into a single multi draw.
+ */
 void RenderPassCommandRecorder::drawIndirect(std::span<const DrawIndirectCommand> drawCommands)
 {
     auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
@@ -141,12 +187,52 @@ void RenderPassCommandRecorder::drawIndexedIndirect(const DrawIndexedIndirectCom
     apiRenderPassCommandRecorder->drawIndexedIndirect(drawCommand);
 }
 
+/**
+ * @brief Indexed variant of drawIndirect(std::span<const DrawIndirectCommand>), merging contiguous
+ * commands in the same way.
+ */
 void RenderPassCommandRecorder::drawIndexedIndirect(std::span<const DrawIndexedIndirectCommand> drawCommands)
 {
     auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
     apiRenderPassCommandRecorder->drawIndexedIndirect(drawCommands);
 }
 
+/**
+ * @brief Records a draw whose parameters are read from @a drawCommand.buffer and whose draw
+ * count is read from @a drawCommand.countBuffer at execution time, clamped to
+ * @a drawCommand.maxDrawCount.
+ *
+ * This lets a GPU pass (e.g. culling) decide how many draws are actually issued. Requires
+ * AdapterFeatures::drawIndirectCount to be set in the DeviceOptions::requestedFeatures the Device
+ * was created with, otherwise nothing is recorded.
+ */
+void RenderPassCommandRecorder::drawIndirectCount(const DrawIndirectCountCommand &drawCommand)
+{
+    auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
+    apiRenderPassCommandRecorder->drawIndirectCount(drawCommand);
+}
+
+void RenderPassCommandRecorder::drawIndirectCount(std::span<const DrawIndirectCountCommand> drawCommands)
+{
+    auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
+    apiRenderPassCommandRecorder->drawIndirectCount(drawCommands);
+}
+
+/**
+ * @brief Indexed variant of drawIndirectCount().
+ */
+void RenderPassCommandRecorder::drawIndexedIndirectCount(const DrawIndexedIndirectCountCommand &drawCommand)
+{
+    auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
+    apiRenderPassCommandRecorder->drawIndexedIndirectCount(drawCommand);
+}
+
+void RenderPassCommandRecorder::drawIndexedIndirectCount(std::span<const DrawIndexedIndirectCountCommand> drawCommands)
+{
+    auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
+    apiRenderPassCommandRecorder->drawIndexedIndirectCount(drawCommands);
+}
+
 void RenderPassCommandRecorder::drawMeshTasks(const DrawMeshCommand &drawCommand)
 {
     auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
@@ -185,6 +271,22 @@ void RenderPassCommandRecorder::pushBindGroup(uint32_t group,
     apiRenderPassCommandRecorder->pushBindGroup(group, bindGroupEntries, pipelineLayout);
 }
 
+/**
+ * @brief Pushes the descriptors of @a group using a descriptor update template cached on the
+ * PipelineLayout.
+ *
+ * @a resources must hold one BindingResource per descriptor of the BindGroupLayout at @a group,
+ * ordered by binding index and then by array element. Prefer this over pushBindGroup() for
+ * bind groups that are pushed with the same layout over and over.
+ */
+void RenderPassCommandRecorder::pushBindGroupWithTemplate(uint32_t group,
+                                                          std::span<const BindingResource> resources,
+                                                          const Handle<PipelineLayout_t> &pipelineLayout)
+{
+    auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
+    apiRenderPassCommandRecorder->pushBindGroupWithTemplate(group, resources, pipelineLayout);
+}
+
 void RenderPassCommandRecorder::nextSubpass()
 {
     auto *apiRenderPassCommandRecorder = m_api->resourceManager()->getRenderPassCommandRecorder(m_renderPassCommandRecorder);
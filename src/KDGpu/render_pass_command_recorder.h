@@ -31,6 +31,7 @@ struct Rect2D;
 struct Viewport;
 struct PushConstantRange;
 struct BindGroupEntry;
+class BindingResource;
 
 struct DrawCommand {
     uint32_t vertexCount{ 0 };
@@ -61,6 +62,24 @@ struct DrawIndexedIndirectCommand {
     uint32_t stride{ 0 };
 };
 
+struct DrawIndirectCountCommand {
+    Handle<Buffer_t> buffer;
+    size_t offset{ 0 };
+    Handle<Buffer_t> countBuffer;
+    size_t countBufferOffset{ 0 };
+    uint32_t maxDrawCount{ 0 };
+    uint32_t stride{ 0 };
+};
+
+struct DrawIndexedIndirectCountCommand {
+    Handle<Buffer_t> buffer;
+    size_t offset{ 0 };
+    Handle<Buffer_t> countBuffer;
+    size_t countBufferOffset{ 0 };
+    uint32_t maxDrawCount{ 0 };
+    uint32_t stride{ 0 };
+};
+
 struct DrawMeshCommand {
     uint32_t workGroupX{ 1 };
     uint32_t workGroupY{ 1 };
@@ -74,6 +93,18 @@ struct DrawMeshIndirectCommand {
     uint32_t stride{ 0 };
 };
 
+// Number of state changes that were not recorded because the same state was already set,
+// and of indirect draws that were merged into the previous one
+struct RedundantStateStatistics {
+    uint32_t skippedPipelineBinds{ 0 };
+    uint32_t skippedVertexBufferBinds{ 0 };
+    uint32_t skippedIndexBufferBinds{ 0 };
+    uint32_t skippedBindGroupBinds{ 0 };
+    uint32_t skippedViewports{ 0 };
+    uint32_t skippedScissors{ 0 };
+    uint32_t mergedIndirectDraws{ 0 };
+};
+
 /**
  * @brief RenderPassCommandRecorder
  * @ingroup public
@@ -96,14 +127,18 @@ public:
 
     void setPipeline(const Handle<GraphicsPipeline_t> &pipeline);
 
-    // TODO: Add overload for setting many vertex buffers at once
     void setVertexBuffer(uint32_t index, const Handle<Buffer_t> &buffer, DeviceSize offset = 0);
+    void setVertexBuffers(uint32_t firstBinding, std::span<const Handle<Buffer_t>> buffers, std::span<const DeviceSize> offsets = {});
     void setIndexBuffer(const Handle<Buffer_t> &buffer, DeviceSize offset = 0, IndexType indexType = IndexType::Uint32);
 
     void setBindGroup(uint32_t group,
                       const Handle<BindGroup_t> &bindGroup,
                       const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>(),
                       std::span<const uint32_t> dynamicBufferOffsets = {});
+    void setBindGroups(uint32_t firstGroup,
+                       std::span<const Handle<BindGroup_t>> bindGroups,
+                       const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>(),
+                       std::span<const uint32_t> dynamicBufferOffsets = {});
 
     void setViewport(const Viewport &viewport);
     void setScissor(const Rect2D &scissor);
@@ -121,6 +156,12 @@ public:
     void drawIndexedIndirect(const DrawIndexedIndirectCommand &drawCommand);
     void drawIndexedIndirect(std::span<const DrawIndexedIndirectCommand> drawCommands);
 
+    void drawIndirectCount(const DrawIndirectCountCommand &drawCommand);
+    void drawIndirectCount(std::span<const DrawIndirectCountCommand> drawCommands);
+
+    void drawIndexedIndirectCount(const DrawIndexedIndirectCountCommand &drawCommand);
+    void drawIndexedIndirectCount(std::span<const DrawIndexedIndirectCountCommand> drawCommands);
+
     void drawMeshTasks(const DrawMeshCommand &drawCommand);
     void drawMeshTasks(std::span<const DrawMeshCommand> drawCommands);
 
@@ -131,6 +172,9 @@ public:
     void pushBindGroup(uint32_t group,
                        std::span<const BindGroupEntry> bindGroupEntries,
                        const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>());
+    void pushBindGroupWithTemplate(uint32_t group,
+                                   std::span<const BindingResource> resources,
+                                   const Handle<PipelineLayout_t> &pipelineLayout = Handle<PipelineLayout_t>());
 
     void nextSubpass();
 
@@ -145,6 +189,8 @@ public:
 
     void end();
 
+    RedundantStateStatistics redundantStateStatistics() const;
+
 private:
     explicit RenderPassCommandRecorder(GraphicsApi *api,
                                        const Handle<Device_t> &device,
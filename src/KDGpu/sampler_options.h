@@ -12,6 +12,7 @@
 
 #include <KDGpu/gpu_core.h>
 #include <KDGpu/ycbcr_conversion.h>
+#include <KDGpu/utils/hash_utils.h>
 
 namespace KDGpu {
 
@@ -39,6 +40,38 @@ struct SamplerOptions {
     bool normalizedCoordinates{ true };
 
     Handle<YCbCrConversion_t> yCbCrConversion{};
+
+    // Equality operator for caching
+    friend bool operator==(const SamplerOptions &, const SamplerOptions &) = default;
 };
 
 } // namespace KDGpu
+
+// Hash function for SamplerOptions to enable caching
+namespace std {
+
+template<>
+struct hash<KDGpu::SamplerOptions> {
+    size_t operator()(const KDGpu::SamplerOptions &options) const noexcept
+    {
+        size_t hash = 0;
+        KDGpu::hash_combine(hash, std::hash<std::string_view>()(options.label));
+        KDGpu::hash_combine(hash, static_cast<uint32_t>(options.magFilter));
+        KDGpu::hash_combine(hash, static_cast<uint32_t>(options.minFilter));
+        KDGpu::hash_combine(hash, static_cast<uint32_t>(options.mipmapFilter));
+        KDGpu::hash_combine(hash, static_cast<uint32_t>(options.u));
+        KDGpu::hash_combine(hash, static_cast<uint32_t>(options.v));
+        KDGpu::hash_combine(hash, static_cast<uint32_t>(options.w));
+        KDGpu::hash_combine(hash, options.lodMinClamp);
+        KDGpu::hash_combine(hash, options.lodMaxClamp);
+        KDGpu::hash_combine(hash, options.anisotropyEnabled);
+        KDGpu::hash_combine(hash, options.maxAnisotropy);
+        KDGpu::hash_combine(hash, options.compareEnabled);
+        KDGpu::hash_combine(hash, static_cast<uint32_t>(options.compare));
+        KDGpu::hash_combine(hash, options.normalizedCoordinates);
+        KDGpu::hash_combine(hash, options.yCbCrConversion);
+        return hash;
+    }
+};
+
+} // namespace std
@@ -0,0 +1,75 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpu/kdgpu_export.h>
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace KDGpu {
+
+/**
+ * @brief ThreadPool
+ * @internal
+ *
+ * Fixed size set of worker threads processing jobs in FIFO order.
+ * Jobs still queued when the pool is destroyed are run before the workers are joined.
+ */
+class KDGPU_EXPORT ThreadPool
+{
+public:
+    explicit ThreadPool(uint32_t threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ThreadPool(ThreadPool &&) = delete;
+    ThreadPool &operator=(ThreadPool &&) = delete;
+
+    [[nodiscard]] uint32_t threadCount() const noexcept { return static_cast<uint32_t>(m_threads.size()); }
+
+    template<typename F>
+    [[nodiscard]] std::future<std::invoke_result_t<F>> enqueue(F &&job)
+    {
+        using Result = std::invoke_result_t<F>;
+
+        // std::function requires a copyable callable, std::packaged_task is move only
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+        std::future<Result> future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_jobs.emplace([task]() { (*task)(); });
+        }
+        m_condition.notify_one();
+
+        return future;
+    }
+
+private:
+    void run();
+
+    std::vector<std::thread> m_threads;
+    std::queue<std::function<void()>> m_jobs;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping{ false };
+};
+
+} // namespace KDGpu
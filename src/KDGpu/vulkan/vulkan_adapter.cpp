@@ -547,6 +547,12 @@ AdapterFeatures VulkanAdapter::queryAdapterFeatures()
     addToChain(&dynamicLocalReadFeatures);
 #endif
 
+#if defined(VK_EXT_descriptor_buffer)
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures{};
+    descriptorBufferFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+    addToChain(&descriptorBufferFeatures);
+#endif
+
     vkGetPhysicalDeviceFeatures2(physicalDevice, &deviceFeatures2);
     const VkPhysicalDeviceFeatures &deviceFeatures = deviceFeatures2.features;
 
@@ -646,6 +652,8 @@ AdapterFeatures VulkanAdapter::queryAdapterFeatures()
         .samplerYCbCrConversion = false,
         .dynamicRendering = false,
         .dynamicRenderingLocalRead = false,
+        .drawIndirectCount = false,
+        .descriptorBuffer = false,
     };
 
 #if defined(VK_KHR_acceleration_structure)
@@ -687,6 +695,18 @@ AdapterFeatures VulkanAdapter::queryAdapterFeatures()
     features.dynamicRenderingLocalRead = static_cast<bool>(dynamicLocalReadFeatures.dynamicRenderingLocalRead);
 #endif
 
+#if defined(VK_KHR_draw_indirect_count)
+    // We record through the VK_KHR_draw_indirect_count entry points which only need the extension to be enabled
+    const auto adapterExtensions = extensions();
+    features.drawIndirectCount = std::any_of(adapterExtensions.begin(), adapterExtensions.end(), [](const Extension &extension) {
+        return extension.name == VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME;
+    });
+#endif
+
+#if defined(VK_EXT_descriptor_buffer)
+    features.descriptorBuffer = static_cast<bool>(descriptorBufferFeatures.descriptorBuffer);
+#endif
+
     return features;
 }
 
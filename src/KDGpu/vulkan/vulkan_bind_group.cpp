@@ -14,15 +14,24 @@
 #include <KDGpu/vulkan/vulkan_device.h>
 #include <KDGpu/vulkan/vulkan_resource_manager.h>
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
 namespace KDGpu {
 
 VulkanBindGroup::VulkanBindGroup(VkDescriptorSet _descriptorSet,
                                  const Handle<BindGroupPool_t> &_bindGroupPoolHandle,
+                                 const Handle<BindGroupLayout_t> &_bindGroupLayoutHandle,
                                  VulkanResourceManager *_vulkanResourceManager,
                                  const Handle<Device_t> &_deviceHandle,
-                                 bool _implicitFree)
+                                 bool _implicitFree,
+                                 VkDeviceSize _descriptorBufferOffset)
     : descriptorSet(_descriptorSet)
+    , descriptorBufferOffset(_descriptorBufferOffset)
     , bindGroupPoolHandle(_bindGroupPoolHandle)
+    , bindGroupLayoutHandle(_bindGroupLayoutHandle)
     , vulkanResourceManager(_vulkanResourceManager)
     , deviceHandle(_deviceHandle)
     , implicitFree(_implicitFree)
@@ -31,12 +40,18 @@ VulkanBindGroup::VulkanBindGroup(VkDescriptorSet _descriptorSet,
 
 void VulkanBindGroup::update(const BindGroupEntry &entry)
 {
-    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+    update(std::span<const BindGroupEntry>(&entry, 1));
+}
 
-    VkDescriptorBufferInfo bufferInfo{};
+void VulkanBindGroup::update(std::span<const BindGroupEntry> entries)
+{
+    if (entries.empty())
+        return;
 
-    VkDescriptorImageInfo imageInfo{};
-    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    if (usesDescriptorBuffer()) {
+        updateDescriptorBuffer(entries);
+        return;
+    }
 
     if (descriptorSet == VK_NULL_HANDLE) {
         // If the descriptor set is null, we cannot update it.
@@ -45,11 +60,238 @@ void VulkanBindGroup::update(const BindGroupEntry &entry)
         return;
     }
 
-    WriteBindGroupData bindGroupWriteData;
-    vulkanDevice->fillWriteBindGroupDataForBindGroupEntry(bindGroupWriteData, entry, descriptorSet);
+    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+
+    // The descriptor writes point into their WriteBindGroupData, so the storage must not move once filled
+    std::vector<WriteBindGroupData> bindGroupWriteData(entries.size());
+    std::vector<VkWriteDescriptorSet> descriptorWrites;
+    descriptorWrites.reserve(entries.size());
+    for (size_t i = 0, m = entries.size(); i < m; ++i) {
+        WriteBindGroupData &writeData = bindGroupWriteData[i];
+        vulkanDevice->fillWriteBindGroupDataForBindGroupEntry(writeData, entries[i], descriptorSet);
+        if (writeData.descriptorWrite.descriptorCount > 0)
+            descriptorWrites.push_back(writeData.descriptorWrite);
+    }
+
+    if (!descriptorWrites.empty())
+        vkUpdateDescriptorSets(vulkanDevice->device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+}
+
+void VulkanBindGroup::updateWithTemplate(std::span<const BindingResource> resources)
+{
+    if (usesDescriptorBuffer()) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Descriptor update templates can't be used with BindGroups allocated from a descriptor buffer, use update() instead.");
+        return;
+    }
+
+    if (descriptorSet == VK_NULL_HANDLE) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "BindGroup Vulkan Handle is NULL, unable to update. This can happen if the BindGroupPool has been reset.");
+        return;
+    }
+
+    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+    VulkanBindGroupLayout *bindGroupLayout = vulkanResourceManager->getBindGroupLayout(bindGroupLayoutHandle);
+    if (bindGroupLayout == nullptr) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "BindGroupLayout of the BindGroup no longer exists, unable to update with a template.");
+        return;
+    }
 
-    if (bindGroupWriteData.descriptorWrite.descriptorCount > 0)
-        vkUpdateDescriptorSets(vulkanDevice->device, 1, &bindGroupWriteData.descriptorWrite, 0, nullptr);
+    const VkDescriptorUpdateTemplate updateTemplate = bindGroupLayout->descriptorUpdateTemplate(vulkanDevice->device);
+    if (updateTemplate == VK_NULL_HANDLE)
+        return;
+
+    std::vector<VulkanDescriptorUpdateTemplateData> templateData;
+    if (!vulkanDevice->packDescriptorUpdateTemplateData(templateData, *bindGroupLayout, resources))
+        return;
+
+    vkUpdateDescriptorSetWithTemplate(vulkanDevice->device, descriptorSet, updateTemplate, templateData.data());
+}
+
+bool VulkanBindGroup::bindDescriptorBuffer(VkCommandBuffer commandBuffer,
+                                           VkPipelineBindPoint bindPoint,
+                                           VkPipelineLayout pipelineLayout,
+                                           uint32_t group,
+                                           VkDeviceAddress &boundDescriptorBufferAddress) const
+{
+#if defined(VK_EXT_descriptor_buffer)
+    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+    VulkanBindGroupPool *bindGroupPool = vulkanResourceManager->getBindGroupPool(bindGroupPoolHandle);
+    assert(bindGroupPool != nullptr);
+
+    const VulkanBindGroupPool::DescriptorBuffer &descriptorBuffer = bindGroupPool->descriptorBuffer;
+    const bool rebound = descriptorBuffer.deviceAddress != boundDescriptorBufferAddress;
+    if (rebound) {
+        const VkDescriptorBufferBindingInfoEXT bindingInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT,
+            .address = descriptorBuffer.deviceAddress,
+            .usage = descriptorBuffer.usage,
+        };
+        vulkanDevice->vkCmdBindDescriptorBuffersEXT(commandBuffer, 1, &bindingInfo);
+        boundDescriptorBufferAddress = descriptorBuffer.deviceAddress;
+    }
+
+    const uint32_t bufferIndex = 0;
+    vulkanDevice->vkCmdSetDescriptorBufferOffsetsEXT(commandBuffer, bindPoint, pipelineLayout, group, 1, &bufferIndex, &descriptorBufferOffset);
+    return rebound;
+#else
+    SPDLOG_LOGGER_ERROR(Logger::logger(), "Descriptor buffers are not supported by this build");
+    return false;
+#endif
+}
+
+void VulkanBindGroup::updateDescriptorBuffer(std::span<const BindGroupEntry> entries)
+{
+#if defined(VK_EXT_descriptor_buffer)
+    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+    VulkanBindGroupPool *bindGroupPool = vulkanResourceManager->getBindGroupPool(bindGroupPoolHandle);
+    VulkanBindGroupLayout *bindGroupLayout = vulkanResourceManager->getBindGroupLayout(bindGroupLayoutHandle);
+    if (bindGroupPool == nullptr || bindGroupLayout == nullptr) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "BindGroupPool or BindGroupLayout of the BindGroup no longer exists, unable to update.");
+        return;
+    }
+
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT &properties = vulkanDevice->descriptorBufferProperties;
+    uint8_t *descriptorBufferData = static_cast<uint8_t *>(bindGroupPool->descriptorBuffer.mapped);
+    VkDeviceSize writtenBegin = std::numeric_limits<VkDeviceSize>::max();
+    VkDeviceSize writtenEnd = 0;
+
+    for (const BindGroupEntry &entry : entries) {
+        VkDescriptorGetInfoEXT getInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+        };
+        VkDescriptorImageInfo imageInfo{};
+        VkDescriptorAddressInfoEXT addressInfo = {
+            .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+        };
+        size_t descriptorSize = 0;
+
+        // Fills in addressInfo from a buffer binding, descriptor buffers reference buffers by address rather than handle
+        const auto fillAddressInfo = [&](const Handle<Buffer_t> &bufferHandle, uint32_t offset, uint32_t size, uint32_t wholeSize) {
+            VulkanBuffer *buffer = vulkanResourceManager->getBuffer(bufferHandle);
+            assert(buffer != nullptr);
+            if (buffer->bufferDeviceAddress() == 0) {
+                SPDLOG_LOGGER_ERROR(Logger::logger(), "Buffers referenced by descriptor buffer BindGroups must be created with BufferUsageFlagBits::ShaderDeviceAddressBit");
+                return false;
+            }
+            addressInfo.address = buffer->bufferDeviceAddress() + offset;
+            addressInfo.range = (size == wholeSize) ? buffer->size - offset : size;
+            return true;
+        };
+
+        switch (entry.resource.type()) {
+        case ResourceBindingType::CombinedImageSampler: {
+            const TextureViewSamplerBinding &textureViewBinding = entry.resource.textureViewSamplerBinding();
+            VulkanTextureView *textView = vulkanResourceManager->getTextureView(textureViewBinding.textureView);
+            VulkanSampler *sampler = vulkanResourceManager->getSampler(textureViewBinding.sampler);
+            assert(textView != nullptr);
+            imageInfo.imageView = textView->imageView;
+            imageInfo.imageLayout = textureLayoutToVkImageLayout(textureViewBinding.layout);
+            if (sampler != nullptr)
+                imageInfo.sampler = sampler->sampler;
+            getInfo.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            getInfo.data.pCombinedImageSampler = &imageInfo;
+            descriptorSize = properties.combinedImageSamplerDescriptorSize;
+            break;
+        }
+        case ResourceBindingType::SampledImage: {
+            const TextureViewBinding &textureViewBinding = entry.resource.textureViewBinding();
+            VulkanTextureView *textView = vulkanResourceManager->getTextureView(textureViewBinding.textureView);
+            assert(textView != nullptr);
+            imageInfo.imageView = textView->imageView;
+            imageInfo.imageLayout = textureLayoutToVkImageLayout(textureViewBinding.layout);
+            getInfo.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+            getInfo.data.pSampledImage = &imageInfo;
+            descriptorSize = properties.sampledImageDescriptorSize;
+            break;
+        }
+        case ResourceBindingType::Sampler: {
+            VulkanSampler *sampler = vulkanResourceManager->getSampler(entry.resource.samplerBinding().sampler);
+            assert(sampler != nullptr);
+            imageInfo.sampler = sampler->sampler;
+            getInfo.type = VK_DESCRIPTOR_TYPE_SAMPLER;
+            getInfo.data.pSampler = &imageInfo.sampler;
+            descriptorSize = properties.samplerDescriptorSize;
+            break;
+        }
+        case ResourceBindingType::StorageImage: {
+            const ImageBinding &imageBinding = entry.resource.imageBinding();
+            VulkanTextureView *textView = vulkanResourceManager->getTextureView(imageBinding.textureView);
+            assert(textView != nullptr);
+            imageInfo.imageView = textView->imageView;
+            imageInfo.imageLayout = textureLayoutToVkImageLayout(imageBinding.layout);
+            getInfo.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            getInfo.data.pStorageImage = &imageInfo;
+            descriptorSize = properties.storageImageDescriptorSize;
+            break;
+        }
+        case ResourceBindingType::InputAttachment: {
+            const InputAttachmentBinding &inputAttachmentBinding = entry.resource.inputAttachmentBinding();
+            VulkanTextureView *textView = vulkanResourceManager->getTextureView(inputAttachmentBinding.textureView);
+            assert(textView != nullptr);
+            imageInfo.imageView = textView->imageView;
+            imageInfo.imageLayout = textureLayoutToVkImageLayout(inputAttachmentBinding.layout);
+            getInfo.type = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+            getInfo.data.pInputAttachmentImage = &imageInfo;
+            descriptorSize = properties.inputAttachmentDescriptorSize;
+            break;
+        }
+        case ResourceBindingType::UniformBuffer: {
+            const UniformBufferBinding &bufferBinding = entry.resource.uniformBufferBinding();
+            if (!fillAddressInfo(bufferBinding.buffer, bufferBinding.offset, bufferBinding.size, UniformBufferBinding::WholeSize))
+                continue;
+            getInfo.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            getInfo.data.pUniformBuffer = &addressInfo;
+            descriptorSize = properties.uniformBufferDescriptorSize;
+            break;
+        }
+        case ResourceBindingType::StorageBuffer: {
+            const StorageBufferBinding &bufferBinding = entry.resource.storageBufferBinding();
+            if (!fillAddressInfo(bufferBinding.buffer, bufferBinding.offset, bufferBinding.size, StorageBufferBinding::WholeSize))
+                continue;
+            getInfo.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            getInfo.data.pStorageBuffer = &addressInfo;
+            descriptorSize = properties.storageBufferDescriptorSize;
+            break;
+        }
+#if defined(VK_KHR_acceleration_structure)
+        case ResourceBindingType::AccelerationStructure: {
+            VulkanAccelerationStructure *accelerationStructure = vulkanResourceManager->getAccelerationStructure(entry.resource.accelerationStructure().accelerationStructure);
+            assert(accelerationStructure != nullptr);
+            const VkAccelerationStructureDeviceAddressInfoKHR addressInfoKhr = {
+                .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
+                .accelerationStructure = accelerationStructure->accelerationStructure,
+            };
+            getInfo.type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+            getInfo.data.accelerationStructure = vulkanDevice->vkGetAccelerationStructureDeviceAddressKHR(vulkanDevice->device, &addressInfoKhr);
+            descriptorSize = properties.accelerationStructureDescriptorSize;
+            break;
+        }
+#endif
+        case ResourceBindingType::DynamicUniformBuffer:
+            SPDLOG_LOGGER_ERROR(Logger::logger(), "Dynamic uniform buffers can't be used with descriptor buffers");
+            continue;
+        default:
+            continue;
+        }
+
+        VkDeviceSize bindingOffset = 0;
+        vulkanDevice->vkGetDescriptorSetLayoutBindingOffsetEXT(vulkanDevice->device, bindGroupLayout->descriptorSetLayout, entry.binding, &bindingOffset);
+
+        // Writing a descriptor is a plain copy into the mapped descriptor buffer
+        const VkDeviceSize descriptorOffset = descriptorBufferOffset + bindingOffset + entry.arrayElement * descriptorSize;
+        vulkanDevice->vkGetDescriptorEXT(vulkanDevice->device, &getInfo, descriptorSize, descriptorBufferData + descriptorOffset);
+        writtenBegin = std::min(writtenBegin, descriptorOffset);
+        writtenEnd = std::max(writtenEnd, descriptorOffset + descriptorSize);
+    }
+
+    // The descriptor buffer memory isn't necessarily host coherent
+    if (writtenBegin < writtenEnd) {
+        if (auto result = vmaFlushAllocation(vulkanDevice->allocator, bindGroupPool->descriptorBuffer.allocation, writtenBegin, writtenEnd - writtenBegin); result != VK_SUCCESS)
+            SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when flushing the descriptor buffer: {}", result);
+    }
+#else
+    SPDLOG_LOGGER_ERROR(Logger::logger(), "Descriptor buffers are not supported by this build");
+#endif
 }
 
 } // namespace KDGpu
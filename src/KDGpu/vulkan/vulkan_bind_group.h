@@ -15,11 +15,14 @@
 #include <KDGpu/kdgpu_export.h>
 #include <vulkan/vulkan.h>
 
+#include <span>
+
 namespace KDGpu {
 
 class VulkanResourceManager;
 struct Device_t;
 struct BindGroupPool_t;
+struct BindGroupLayout_t;
 
 /**
  * @brief VulkanBindGroup
@@ -27,20 +30,41 @@ struct BindGroupPool_t;
  *
  */
 struct KDGPU_EXPORT VulkanBindGroup {
+    static constexpr VkDeviceSize InvalidDescriptorBufferOffset = ~VkDeviceSize(0);
+
     explicit VulkanBindGroup(VkDescriptorSet _descriptorSet,
                              const Handle<BindGroupPool_t> &_bindGroupPoolHandle,
+                             const Handle<BindGroupLayout_t> &_bindGroupLayoutHandle,
                              VulkanResourceManager *_vulkanResourceManager,
                              const Handle<Device_t> &_deviceHandle,
-                             bool _implicitFree);
+                             bool _implicitFree,
+                             VkDeviceSize _descriptorBufferOffset = InvalidDescriptorBufferOffset);
 
     void update(const BindGroupEntry &entry);
-    bool hasValidHandle() const { return descriptorSet != VK_NULL_HANDLE; };
+    void update(std::span<const BindGroupEntry> entries);
+    void updateWithTemplate(std::span<const BindingResource> resources);
+    bool hasValidHandle() const { return descriptorSet != VK_NULL_HANDLE || usesDescriptorBuffer(); };
+    bool usesDescriptorBuffer() const { return descriptorBufferOffset != InvalidDescriptorBufferOffset; }
+
+    // Binds the descriptor buffer of our pool if it isn't already and points group at our offset within it.
+    // Returns true if the descriptor buffer had to be bound, which leaves the offsets of the other sets
+    // pointing into it.
+    bool bindDescriptorBuffer(VkCommandBuffer commandBuffer,
+                              VkPipelineBindPoint bindPoint,
+                              VkPipelineLayout pipelineLayout,
+                              uint32_t group,
+                              VkDeviceAddress &boundDescriptorBufferAddress) const;
 
     VkDescriptorSet descriptorSet{ VK_NULL_HANDLE };
+    VkDeviceSize descriptorBufferOffset{ InvalidDescriptorBufferOffset }; // Only valid for BindGroups allocated from a descriptor buffer pool
     Handle<BindGroupPool_t> bindGroupPoolHandle;
+    Handle<BindGroupLayout_t> bindGroupLayoutHandle;
     VulkanResourceManager *vulkanResourceManager;
     Handle<Device_t> deviceHandle;
     bool implicitFree{ false };
+
+private:
+    void updateDescriptorBuffer(std::span<const BindGroupEntry> entries);
 };
 
 } // namespace KDGpu
@@ -10,15 +10,21 @@
 
 #include "vulkan_bind_group_layout.h"
 
+#include <KDGpu/vulkan/vulkan_enums.h>
+#include <KDGpu/vulkan/vulkan_formatters.h>
+#include <KDGpu/utils/logging.h>
+
 #include <algorithm>
 namespace KDGpu {
 
 VulkanBindGroupLayout::VulkanBindGroupLayout(VkDescriptorSetLayout _descriptorSetLayout,
                                              const Handle<Device_t> &_deviceHandle,
-                                             const std::vector<ResourceBindingLayout> &_bindings)
+                                             const std::vector<ResourceBindingLayout> &_bindings,
+                                             BindGroupLayoutFlags _flags)
     : descriptorSetLayout(_descriptorSetLayout)
     , deviceHandle(_deviceHandle)
     , bindings(_bindings)
+    , flags(_flags)
 {
     // Sort Bindings by their index to ease comparison
     std::sort(bindings.begin(), bindings.end(), [](const auto &b1, const auto &b2) {
@@ -31,4 +37,64 @@ bool VulkanBindGroupLayout::isCompatibleWith(const VulkanBindGroupLayout &other)
     return bindings == other.bindings;
 }
 
+uint32_t VulkanBindGroupLayout::descriptorCount() const
+{
+    uint32_t count = 0;
+    for (const ResourceBindingLayout &binding : bindings)
+        count += binding.count;
+    return count;
+}
+
+std::vector<VkDescriptorUpdateTemplateEntry> VulkanBindGroupLayout::descriptorUpdateTemplateEntries() const
+{
+    std::vector<VkDescriptorUpdateTemplateEntry> entries;
+    entries.reserve(bindings.size());
+
+    // Bindings are sorted, so the packed data holds the descriptors in binding order
+    size_t slot = 0;
+    for (const ResourceBindingLayout &binding : bindings) {
+        entries.push_back(VkDescriptorUpdateTemplateEntry{
+                .dstBinding = binding.binding,
+                .dstArrayElement = 0,
+                .descriptorCount = binding.count,
+                .descriptorType = resourceBindingTypeToVkDescriptorType(binding.resourceType),
+                .offset = slot * sizeof(VulkanDescriptorUpdateTemplateData),
+                .stride = sizeof(VulkanDescriptorUpdateTemplateData),
+        });
+        slot += binding.count;
+    }
+
+    return entries;
+}
+
+VkDescriptorUpdateTemplate VulkanBindGroupLayout::descriptorUpdateTemplate(VkDevice device)
+{
+    std::lock_guard lock(*updateTemplateMutex);
+    if (updateTemplate != VK_NULL_HANDLE)
+        return updateTemplate;
+
+    const std::vector<VkDescriptorUpdateTemplateEntry> entries = descriptorUpdateTemplateEntries();
+
+    VkDescriptorUpdateTemplateCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+    createInfo.pDescriptorUpdateEntries = entries.data();
+    createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    createInfo.descriptorSetLayout = descriptorSetLayout;
+
+    if (auto result = vkCreateDescriptorUpdateTemplate(device, &createInfo, nullptr, &updateTemplate); result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating descriptor update template: {}", result);
+        updateTemplate = VK_NULL_HANDLE;
+    }
+
+    return updateTemplate;
+}
+
+void VulkanBindGroupLayout::destroyDescriptorUpdateTemplate(VkDevice device)
+{
+    if (updateTemplate != VK_NULL_HANDLE)
+        vkDestroyDescriptorUpdateTemplate(device, updateTemplate, nullptr);
+    updateTemplate = VK_NULL_HANDLE;
+}
+
 } // namespace KDGpu
@@ -15,11 +15,26 @@
 #include <KDGpu/kdgpu_export.h>
 #include <vulkan/vulkan.h>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace KDGpu {
 
 class VulkanResourceManager;
 struct Device_t;
 
+// One slot of the packed data consumed by a descriptor update template. Each descriptor of
+// the layout gets one slot, ordered by binding and then by array element.
+union VulkanDescriptorUpdateTemplateData {
+    VkDescriptorImageInfo imageInfo;
+    VkDescriptorBufferInfo bufferInfo;
+    VkBufferView texelBufferView;
+#if defined(VK_KHR_acceleration_structure)
+    VkAccelerationStructureKHR accelerationStructure;
+#endif
+};
+
 /**
  * @brief VulkanBindGroupLayout
  * \ingroup vulkan
@@ -28,13 +43,23 @@ struct Device_t;
 struct KDGPU_EXPORT VulkanBindGroupLayout {
     explicit VulkanBindGroupLayout(VkDescriptorSetLayout _descriptorSetLayout,
                                    const Handle<Device_t> &_deviceHandle,
-                                   const std::vector<ResourceBindingLayout> &bindings);
+                                   const std::vector<ResourceBindingLayout> &bindings,
+                                   BindGroupLayoutFlags flags = BindGroupLayoutFlagBits::None);
 
     bool isCompatibleWith(const VulkanBindGroupLayout &other) const;
 
+    uint32_t descriptorCount() const;
+    std::vector<VkDescriptorUpdateTemplateEntry> descriptorUpdateTemplateEntries() const;
+    VkDescriptorUpdateTemplate descriptorUpdateTemplate(VkDevice device);
+    void destroyDescriptorUpdateTemplate(VkDevice device);
+
     VkDescriptorSetLayout descriptorSetLayout{ VK_NULL_HANDLE };
     Handle<Device_t> deviceHandle;
     std::vector<ResourceBindingLayout> bindings;
+    BindGroupLayoutFlags flags{ BindGroupLayoutFlagBits::None };
+    uint32_t refCount{ 1 }; // Only grows beyond 1 for layouts shared through VulkanDevice::bindGroupLayouts
+    VkDescriptorUpdateTemplate updateTemplate{ VK_NULL_HANDLE }; // Lazily created by descriptorUpdateTemplate()
+    std::unique_ptr<std::mutex> updateTemplateMutex{ std::make_unique<std::mutex>() }; // Guards updateTemplate
 };
 
 } // namespace KDGpu
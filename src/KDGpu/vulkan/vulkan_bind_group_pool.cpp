@@ -27,14 +27,22 @@ VulkanBindGroupPool::VulkanBindGroupPool(VkDescriptorPool _descriptorPool,
 
 void VulkanBindGroupPool::reset()
 {
-    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
-    vkResetDescriptorPool(vulkanDevice->device, descriptorPool, VkDescriptorPoolResetFlags{});
+    if (usesDescriptorBuffer()) {
+        // Rewinding the cursor is all it takes to recycle the whole descriptor buffer
+        descriptorBuffer.offset = 0;
+    } else {
+        VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+        vkResetDescriptorPool(vulkanDevice->device, descriptorPool, VkDescriptorPoolResetFlags{});
+    }
 
     // Reset vulkan descriptor set handle on the referenced bind groups since they have been reset by the pool
     for (const auto &bindGroupHandle : m_bindGroups) {
+        // BindGroups without implicit free remain tracked after being destroyed, until the pool is reset
         VulkanBindGroup *bindGroup = vulkanResourceManager->getBindGroup(bindGroupHandle);
-        assert(bindGroup); // Should not ever happen but in case it ever does
+        if (bindGroup == nullptr)
+            continue;
         bindGroup->descriptorSet = VK_NULL_HANDLE;
+        bindGroup->descriptorBufferOffset = VulkanBindGroup::InvalidDescriptorBufferOffset;
     }
 
     // Clear the tracked bind groups as they are now invalidated
@@ -61,4 +69,22 @@ uint16_t VulkanBindGroupPool::bindGroupCount() const
     return static_cast<uint16_t>(m_bindGroups.size());
 }
 
+bool VulkanBindGroupPool::usesDescriptorBuffer() const
+{
+    return flags.testFlag(BindGroupPoolFlagBits::DescriptorBuffer);
+}
+
+bool VulkanBindGroupPool::allocateDescriptorBufferRange(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &offset)
+{
+    const VkDeviceSize alignedOffset = alignment > 0
+            ? (descriptorBuffer.offset + alignment - 1) / alignment * alignment
+            : descriptorBuffer.offset;
+    if (alignedOffset + size > descriptorBuffer.size)
+        return false;
+
+    offset = alignedOffset;
+    descriptorBuffer.offset = alignedOffset + size;
+    return true;
+}
+
 } // namespace KDGpu
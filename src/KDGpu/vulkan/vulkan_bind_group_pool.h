@@ -13,6 +13,7 @@
 #include <KDGpu/handle.h>
 #include <KDGpu/kdgpu_export.h>
 #include <KDGpu/bind_group_pool_options.h>
+#include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
 #include <vector>
 
@@ -28,6 +29,17 @@ struct BindGroup_t;
  *
  */
 struct KDGPU_EXPORT VulkanBindGroupPool {
+    // Backing storage of pools created with BindGroupPoolFlagBits::DescriptorBuffer
+    struct DescriptorBuffer {
+        VkBuffer buffer{ VK_NULL_HANDLE };
+        VmaAllocation allocation{ VK_NULL_HANDLE };
+        void *mapped{ nullptr };
+        VkDeviceAddress deviceAddress{ 0 };
+        VkBufferUsageFlags usage{ 0 };
+        VkDeviceSize size{ 0 };
+        VkDeviceSize offset{ 0 }; // Linear allocation cursor, rewound by reset()
+    };
+
     explicit VulkanBindGroupPool(VkDescriptorPool _descriptorPool,
                                  VulkanResourceManager *_vulkanResourceManager,
                                  const Handle<Device_t> &_deviceHandle,
@@ -42,11 +54,15 @@ struct KDGPU_EXPORT VulkanBindGroupPool {
     const std::vector<Handle<BindGroup_t>> &bindGroups() const;
     uint16_t bindGroupCount() const;
 
+    bool usesDescriptorBuffer() const;
+    bool allocateDescriptorBufferRange(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize &offset);
+
     VkDescriptorPool descriptorPool{ VK_NULL_HANDLE };
     VulkanResourceManager *vulkanResourceManager;
     Handle<Device_t> deviceHandle;
     uint16_t maxBindGroupCount;
     BindGroupPoolFlags flags{ BindGroupPoolFlagBits::None };
+    DescriptorBuffer descriptorBuffer;
 
 private:
     std::vector<Handle<BindGroup_t>> m_bindGroups;
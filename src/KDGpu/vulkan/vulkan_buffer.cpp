@@ -13,18 +13,44 @@
 #include <KDGpu/vulkan/vulkan_device.h>
 #include <KDGpu/vulkan/vulkan_resource_manager.h>
 
+#include <vector>
+
 namespace KDGpu {
 
+namespace {
+
+// Layout expected by vmaFlushAllocations/vmaInvalidateAllocations, which align each range to nonCoherentAtomSize
+struct VmaAllocationRanges {
+    VmaAllocationRanges(VmaAllocation allocation, std::span<const MappedBufferRange> ranges)
+        : allocations(ranges.size(), allocation)
+    {
+        offsets.reserve(ranges.size());
+        sizes.reserve(ranges.size());
+        for (const MappedBufferRange &range : ranges) {
+            offsets.push_back(range.offset);
+            sizes.push_back(range.size);
+        }
+    }
+
+    std::vector<VmaAllocation> allocations;
+    std::vector<VkDeviceSize> offsets;
+    std::vector<VkDeviceSize> sizes;
+};
+
+} // namespace
+
 VulkanBuffer::VulkanBuffer(VkBuffer _buffer,
                            VmaAllocation _allocation,
                            VmaAllocator _allocator,
                            VulkanResourceManager *_vulkanResourceManager,
                            const Handle<Device_t> &_deviceHandle,
                            const MemoryHandle &_externalMemoryHandle,
-                           const BufferDeviceAddress &_deviceAddress)
+                           const BufferDeviceAddress &_deviceAddress,
+                           VkDeviceSize _size)
     : buffer(_buffer)
     , allocation(_allocation)
     , allocator(_allocator)
+    , size(_size)
     , vulkanResourceManager(_vulkanResourceManager)
     , deviceHandle(_deviceHandle)
     , m_externalMemoryHandle(_externalMemoryHandle)
@@ -34,32 +60,59 @@ VulkanBuffer::VulkanBuffer(VkBuffer _buffer,
 
 void *VulkanBuffer::map()
 {
-    auto vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
-    vmaMapMemory(vulkanDevice->allocator, allocation, &mapped);
+    if (persistentMapping) {
+        mapped = persistentMapping;
+        return mapped;
+    }
+
+    vmaMapMemory(allocator, allocation, &mapped);
     return mapped;
 }
 
 void VulkanBuffer::unmap()
 {
-    auto vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
-    vmaUnmapMemory(vulkanDevice->allocator, allocation);
+    // Persistently mapped buffers are unmapped by VMA when they are destroyed
+    if (persistentMapping)
+        return;
+
+    vmaUnmapMemory(allocator, allocation);
     mapped = nullptr;
 }
 
 // Note: invalidating before mapping is only needed on non host coherent memory
 // (AMD, Intel, NVIDIA) driver currently provide HOST_COHERENT flag on all memory types that are HOST_VISIBLE
-void VulkanBuffer::invalidate()
+void VulkanBuffer::invalidate(VkDeviceSize offset, VkDeviceSize size)
 {
-    auto vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
-    vmaInvalidateAllocation(vulkanDevice->allocator, allocation, 0, VK_WHOLE_SIZE);
+    if (hostCoherent)
+        return;
+    vmaInvalidateAllocation(allocator, allocation, offset, size);
+}
+
+void VulkanBuffer::invalidate(std::span<const MappedBufferRange> ranges)
+{
+    if (hostCoherent || ranges.empty())
+        return;
+
+    const VmaAllocationRanges vmaRanges(allocation, ranges);
+    vmaInvalidateAllocations(allocator, static_cast<uint32_t>(ranges.size()), vmaRanges.allocations.data(), vmaRanges.offsets.data(), vmaRanges.sizes.data());
 }
 
 // Note: flushing after mapping is only needed on non host coherent memory
 // (AMD, Intel, NVIDIA) driver currently provide HOST_COHERENT flag on all memory types that are HOST_VISIBLE
-void VulkanBuffer::flush()
+void VulkanBuffer::flush(VkDeviceSize offset, VkDeviceSize size)
 {
-    auto vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
-    vmaFlushAllocation(vulkanDevice->allocator, allocation, 0, VK_WHOLE_SIZE);
+    if (hostCoherent)
+        return;
+    vmaFlushAllocation(allocator, allocation, offset, size);
+}
+
+void VulkanBuffer::flush(std::span<const MappedBufferRange> ranges)
+{
+    if (hostCoherent || ranges.empty())
+        return;
+
+    const VmaAllocationRanges vmaRanges(allocation, ranges);
+    vmaFlushAllocations(allocator, static_cast<uint32_t>(ranges.size()), vmaRanges.allocations.data(), vmaRanges.offsets.data(), vmaRanges.sizes.data());
 }
 
 MemoryHandle VulkanBuffer::externalMemoryHandle() const
@@ -17,6 +17,8 @@
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
 
+#include <span>
+
 namespace KDGpu {
 
 class VulkanResourceManager;
@@ -35,12 +37,15 @@ struct KDGPU_EXPORT VulkanBuffer {
                           VulkanResourceManager *_vulkanResourceManager,
                           const Handle<Device_t> &_deviceHandle,
                           const MemoryHandle &_externalMemoryHandle,
-                          const BufferDeviceAddress &_deviceAddress);
+                          const BufferDeviceAddress &_deviceAddress,
+                          VkDeviceSize _size);
 
     void *map();
     void unmap();
-    void invalidate();
-    void flush();
+    void invalidate(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+    void invalidate(std::span<const MappedBufferRange> ranges);
+    void flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+    void flush(std::span<const MappedBufferRange> ranges);
     MemoryHandle externalMemoryHandle() const;
     BufferDeviceAddress bufferDeviceAddress() const;
 
@@ -48,6 +53,9 @@ struct KDGPU_EXPORT VulkanBuffer {
     VmaAllocation allocation{ VK_NULL_HANDLE };
     VmaAllocator allocator{ VK_NULL_HANDLE };
     void *mapped{ nullptr };
+    void *persistentMapping{ nullptr }; // Only set for buffers created with BufferOptions::persistentlyMapped
+    VkDeviceSize size{ 0 };
+    bool hostCoherent{ false }; // Flushes and invalidations are no-ops for HOST_COHERENT memory
 
     VulkanResourceManager *vulkanResourceManager;
     Handle<Device_t> deviceHandle;
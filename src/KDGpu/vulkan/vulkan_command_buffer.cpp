@@ -13,10 +13,91 @@
 #include <KDGpu/utils/logging.h>
 #include <KDGpu/vulkan/vulkan_formatters.h>
 
+#include <cassert>
+
 namespace KDGpu {
 
+VulkanCommandPool::VulkanCommandPool(VkCommandPool _commandPool,
+                                     uint32_t _queueTypeIndex,
+                                     const Handle<Device_t> &_deviceHandle,
+                                     std::thread::id _ownerThreadId)
+    : commandPool(_commandPool)
+    , queueTypeIndex(_queueTypeIndex)
+    , deviceHandle(_deviceHandle)
+    , ownerThreadId(_ownerThreadId)
+{
+}
+
+void VulkanCommandPool::registerCommandBuffer()
+{
+    std::lock_guard lock(*pendingCommandBuffersMutex);
+    ++liveCommandBufferCount;
+}
+
+void VulkanCommandPool::freeCommandBuffer(VkDevice device, VkCommandBuffer commandBuffer)
+{
+    {
+        std::lock_guard lock(*pendingCommandBuffersMutex);
+        assert(liveCommandBufferCount > 0);
+        --liveCommandBufferCount;
+
+        // A retired pool releases all its command buffers when it gets destroyed
+        if (retired)
+            return;
+
+        // The owning thread may be recording into another command buffer of this pool,
+        // defer the release until it next allocates from it
+        if (std::this_thread::get_id() != ownerThreadId) {
+            pendingCommandBuffers.push_back(commandBuffer);
+            return;
+        }
+    }
+
+    releasePendingCommandBuffers(device);
+    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+}
+
+void VulkanCommandPool::releasePendingCommandBuffers(VkDevice device)
+{
+    std::vector<VkCommandBuffer> commandBuffers;
+    {
+        std::lock_guard lock(*pendingCommandBuffersMutex);
+        commandBuffers.swap(pendingCommandBuffers);
+    }
+    if (!commandBuffers.empty())
+        vkFreeCommandBuffers(device, commandPool, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+}
+
+void VulkanCommandPool::retire()
+{
+    std::lock_guard lock(*pendingCommandBuffersMutex);
+    retired = true;
+}
+
+bool VulkanCommandPool::hasLiveCommandBuffers() const
+{
+    std::lock_guard lock(*pendingCommandBuffersMutex);
+    return liveCommandBufferCount > 0;
+}
+
+VulkanCommandPool::RecycledCommandBuffers &VulkanCommandPool::recycledCommandBuffers(VkCommandBufferLevel level)
+{
+    return level == VK_COMMAND_BUFFER_LEVEL_SECONDARY ? secondaryCommandBuffers : primaryCommandBuffers;
+}
+
+void VulkanCommandPool::reset(VkDevice device)
+{
+    // Returns all command buffers to the initial state without releasing their memory
+    if (auto result = vkResetCommandPool(device, commandPool, 0); result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when resetting command pool: {}", result);
+        return;
+    }
+    primaryCommandBuffers.usedCount = 0;
+    secondaryCommandBuffers.usedCount = 0;
+}
+
 VulkanCommandBuffer::VulkanCommandBuffer(VkCommandBuffer _commandBuffer,
-                                         VkCommandPool _commandPool,
+                                         VulkanCommandPool *_commandPool,
                                          VkCommandBufferLevel _commandLevel,
                                          VulkanResourceManager *_vulkanResourceManager,
                                          const Handle<Device_t> &_deviceHandle)
@@ -15,12 +15,67 @@
 
 #include <vulkan/vulkan.h>
 
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace KDGpu {
 
 struct Buffer_t;
 struct Device_t;
 class VulkanResourceManager;
 
+/**
+ * @brief VulkanCommandPool
+ * \ingroup vulkan
+ *
+ * A VkCommandPool for a given queue family.
+ *
+ * The implicit pools used when recording are owned by a single recording
+ * thread. Command buffers released from another thread are queued and only
+ * returned to the VkCommandPool by the owning thread, which is the only one
+ * allowed to touch it while recording. Once retired by
+ * Device::releaseThreadCommandPools(), a pool no longer frees command buffers
+ * individually and is destroyed as a whole once none of them is alive.
+ *
+ * Pools created explicitly through Device::createCommandPool() never free
+ * their command buffers individually, they are recycled once the whole pool
+ * is reset.
+ */
+struct KDGPU_EXPORT VulkanCommandPool {
+    explicit VulkanCommandPool(VkCommandPool _commandPool,
+                               uint32_t _queueTypeIndex,
+                               const Handle<Device_t> &_deviceHandle,
+                               std::thread::id _ownerThreadId = {});
+
+    void registerCommandBuffer();
+    void freeCommandBuffer(VkDevice device, VkCommandBuffer commandBuffer);
+    void releasePendingCommandBuffers(VkDevice device);
+    void retire();
+    bool hasLiveCommandBuffers() const;
+
+    struct RecycledCommandBuffers {
+        std::vector<VkCommandBuffer> commandBuffers;
+        size_t usedCount{ 0 };
+    };
+    RecycledCommandBuffers &recycledCommandBuffers(VkCommandBufferLevel level);
+    void reset(VkDevice device);
+
+    VkCommandPool commandPool{ VK_NULL_HANDLE };
+    uint32_t queueTypeIndex{ 0 };
+    Handle<Device_t> deviceHandle;
+    std::thread::id ownerThreadId;
+
+    std::unique_ptr<std::mutex> pendingCommandBuffersMutex{ std::make_unique<std::mutex>() };
+    std::vector<VkCommandBuffer> pendingCommandBuffers; // Freed from other threads
+    size_t liveCommandBufferCount{ 0 }; // Guarded by pendingCommandBuffersMutex
+    bool retired{ false }; // Guarded by pendingCommandBuffersMutex
+
+    RecycledCommandBuffers primaryCommandBuffers;
+    RecycledCommandBuffers secondaryCommandBuffers;
+};
+
 /**
  * @brief VulkanCommandBuffer
  * \ingroup vulkan
@@ -28,7 +83,7 @@ class VulkanResourceManager;
  */
 struct KDGPU_EXPORT VulkanCommandBuffer {
     explicit VulkanCommandBuffer(VkCommandBuffer _commandBuffer,
-                                 VkCommandPool _commandPool,
+                                 VulkanCommandPool *_commandPool,
                                  VkCommandBufferLevel _commandLevel,
                                  VulkanResourceManager *_vulkanResourceManager,
                                  const Handle<Device_t> &_deviceHandle);
@@ -37,7 +92,7 @@ struct KDGPU_EXPORT VulkanCommandBuffer {
     void finish();
 
     VkCommandBuffer commandBuffer{ VK_NULL_HANDLE };
-    VkCommandPool commandPool{ VK_NULL_HANDLE };
+    VulkanCommandPool *commandPool{ nullptr }; // Not set if recycled by an explicit command pool
     VkCommandBufferLevel commandLevel{ VK_COMMAND_BUFFER_LEVEL_PRIMARY };
     VulkanResourceManager *vulkanResourceManager{ nullptr };
     Handle<Device_t> deviceHandle;
@@ -39,6 +39,9 @@ struct KDGPU_EXPORT VulkanComputePassCommandRecorder {
     void setBindGroup(uint32_t group, const Handle<BindGroup_t> &bindGroup,
                       const Handle<PipelineLayout_t> &pipelineLayout,
                       std::span<const uint32_t> dynamicBufferOffsets) const;
+    void setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                       const Handle<PipelineLayout_t> &pipelineLayout,
+                       std::span<const uint32_t> dynamicBufferOffsets) const;
     void dispatchCompute(const ComputeCommand &command) const;
     void dispatchCompute(std::span<const ComputeCommand> commands) const;
     void dispatchComputeIndirect(const ComputeCommandIndirect &command) const;
@@ -47,6 +50,9 @@ struct KDGPU_EXPORT VulkanComputePassCommandRecorder {
     void pushBindGroup(uint32_t group,
                        std::span<const BindGroupEntry> bindGroupEntries,
                        const Handle<PipelineLayout_t> &pipelineLayout) const;
+    void pushBindGroupWithTemplate(uint32_t group,
+                                   std::span<const BindingResource> resources,
+                                   const Handle<PipelineLayout_t> &pipelineLayout) const;
     void end() const;
 
     // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
@@ -54,7 +60,11 @@ struct KDGPU_EXPORT VulkanComputePassCommandRecorder {
     VulkanResourceManager *vulkanResourceManager{ nullptr };
     Handle<Device_t> deviceHandle;
     Handle<ComputePipeline_t> pipeline;
+    mutable VkDeviceAddress boundDescriptorBufferAddress{ 0 }; // Descriptor buffer bound by the last setBindGroup
     // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+private:
+    VkPipelineLayout resolvePipelineLayout(const Handle<PipelineLayout_t> &pipelineLayout) const;
 };
 
 } // namespace KDGpu
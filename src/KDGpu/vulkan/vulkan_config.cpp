@@ -137,7 +137,13 @@ std::vector<const char *> getDefaultRequestedDeviceExtensions()
         VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
 #endif
 #if defined(VK_KHR_dynamic_rendering_local_read)
-        VK_KHR_DYNAMIC_RENDERING_LOCAL_READ_EXTENSION_NAME
+        VK_KHR_DYNAMIC_RENDERING_LOCAL_READ_EXTENSION_NAME,
+#endif
+#if defined(VK_KHR_draw_indirect_count)
+        VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,
+#endif
+#if defined(VK_EXT_descriptor_buffer)
+        VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME
 #endif
     };
 
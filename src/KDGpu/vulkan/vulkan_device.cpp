@@ -11,10 +11,15 @@
 #include "vulkan_device.h"
 
 #include <KDGpu/resource_manager.h>
+#include <KDGpu/utils/logging.h>
 #include <KDGpu/vulkan/vulkan_enums.h>
+#include <KDGpu/vulkan/vulkan_formatters.h>
 #include <KDGpu/vulkan/vulkan_queue.h>
 #include <KDGpu/vulkan/vulkan_resource_manager.h>
 
+#include <algorithm>
+#include <thread>
+
 // NOLINTBEGIN(readability-function-cognitive-complexity)
 
 #if defined(KDGPU_PLATFORM_WIN32)
@@ -46,12 +51,7 @@ VulkanDevice::VulkanDevice(VkDevice _device,
     // Create an allocator for the device
     allocator = createMemoryAllocator();
 
-    // Resize the vector of command pools to have one for each queue family
-    const auto queueTypes = vulkanAdapter->queryQueueTypes();
-    const auto queueTypeCount = queueTypes.size();
-    commandPools.resize(queueTypeCount);
-    for (uint32_t i = 0; i < queueTypeCount; ++i)
-        commandPools[i] = VK_NULL_HANDLE;
+    maxDrawIndirectCount = vulkanAdapter->queryAdapterProperties().limits.maxDrawIndirectCount;
 
 #if defined(VK_EXT_debug_utils)
     const auto instanceExtensions = vulkanInstance->extensions();
@@ -203,6 +203,7 @@ VulkanDevice::VulkanDevice(VkDevice _device,
 
 #if defined(VK_KHR_push_descriptor)
     this->vkCmdPushDescriptorSetKHR = (PFN_vkCmdPushDescriptorSetKHR)vkGetDeviceProcAddr(device, "vkCmdPushDescriptorSetKHR");
+    this->vkCmdPushDescriptorSetWithTemplateKHR = (PFN_vkCmdPushDescriptorSetWithTemplateKHR)vkGetDeviceProcAddr(device, "vkCmdPushDescriptorSetWithTemplateKHR");
 #endif
 
 #if defined(VK_KHR_dynamic_rendering)
@@ -218,6 +219,42 @@ VulkanDevice::VulkanDevice(VkDevice _device,
         this->vkCmdSetRenderingInputAttachmentIndicesKHR = (PFN_vkCmdSetRenderingInputAttachmentIndicesKHR)vkGetDeviceProcAddr(device, "vkCmdSetRenderingInputAttachmentIndicesKHR");
     }
 #endif
+
+#if defined(VK_KHR_draw_indirect_count)
+    if (requestedFeatures.drawIndirectCount) {
+        const auto adapterExtensions = vulkanAdapter->extensions();
+        for (const auto &extension : adapterExtensions) {
+            if (extension.name == VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) {
+                this->vkCmdDrawIndirectCountKHR = (PFN_vkCmdDrawIndirectCountKHR)vkGetDeviceProcAddr(device, "vkCmdDrawIndirectCountKHR");
+                this->vkCmdDrawIndexedIndirectCountKHR = (PFN_vkCmdDrawIndexedIndirectCountKHR)vkGetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCountKHR");
+                break;
+            }
+        }
+    }
+#endif
+
+#if defined(VK_EXT_descriptor_buffer)
+    if (requestedFeatures.descriptorBuffer) {
+        const auto adapterExtensions = vulkanAdapter->extensions();
+        for (const auto &extension : adapterExtensions) {
+            if (extension.name == VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) {
+                this->vkGetDescriptorSetLayoutSizeEXT = (PFN_vkGetDescriptorSetLayoutSizeEXT)vkGetDeviceProcAddr(device, "vkGetDescriptorSetLayoutSizeEXT");
+                this->vkGetDescriptorSetLayoutBindingOffsetEXT = (PFN_vkGetDescriptorSetLayoutBindingOffsetEXT)vkGetDeviceProcAddr(device, "vkGetDescriptorSetLayoutBindingOffsetEXT");
+                this->vkGetDescriptorEXT = (PFN_vkGetDescriptorEXT)vkGetDeviceProcAddr(device, "vkGetDescriptorEXT");
+                this->vkCmdBindDescriptorBuffersEXT = (PFN_vkCmdBindDescriptorBuffersEXT)vkGetDeviceProcAddr(device, "vkCmdBindDescriptorBuffersEXT");
+                this->vkCmdSetDescriptorBufferOffsetsEXT = (PFN_vkCmdSetDescriptorBufferOffsetsEXT)vkGetDeviceProcAddr(device, "vkCmdSetDescriptorBufferOffsetsEXT");
+
+                // Descriptor sizes and alignment requirements are needed to lay out descriptor buffers
+                descriptorBufferProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+                VkPhysicalDeviceProperties2 deviceProperties2{};
+                deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                deviceProperties2.pNext = &descriptorBufferProperties;
+                vkGetPhysicalDeviceProperties2(vulkanAdapter->physicalDevice, &deviceProperties2);
+                break;
+            }
+        }
+    }
+#endif
 }
 
 std::vector<QueueDescription> VulkanDevice::getQueues(ResourceManager *resourceManager,
@@ -263,8 +300,96 @@ void VulkanDevice::waitUntilIdle() const
     vkDeviceWaitIdle(device);
 }
 
+std::vector<uint8_t> VulkanDevice::pipelineCacheData() const
+{
+    if (pipelineCache == VK_NULL_HANDLE)
+        return {};
+
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr) != VK_SUCCESS)
+        return {};
+
+    std::vector<uint8_t> data(dataSize);
+    if (vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data()) != VK_SUCCESS)
+        return {};
+    data.resize(dataSize);
+
+    return data;
+}
+
+ThreadPool *VulkanDevice::pipelineCompilationThreadPool()
+{
+    std::lock_guard lock(*pipelineThreadPoolMutex);
+    if (!pipelineThreadPool) {
+        // Leave one core for the thread that is submitting the work
+        const uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+        pipelineThreadPool = std::make_unique<ThreadPool>(hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 1);
+    }
+    return pipelineThreadPool.get();
+}
+
+VulkanCommandPool *VulkanDevice::commandPoolForCurrentThread(uint32_t queueTypeIndex)
+{
+    const auto key = std::make_pair(std::this_thread::get_id(), queueTypeIndex);
+
+    std::lock_guard lock(*commandPoolsMutex);
+    auto it = commandPools.find(key);
+    if (it != commandPools.end())
+        return it->second.get();
+
+    // No command pool exists yet for this combination of thread and queue family,
+    // take the opportunity to get rid of the pools of threads that are gone
+    destroyUnusedRetiredCommandPools();
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.queueFamilyIndex = queueTypeIndex;
+
+    VkCommandPool vkCommandPool = VK_NULL_HANDLE;
+    if (auto result = vkCreateCommandPool(device, &poolInfo, nullptr, &vkCommandPool); result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating command pool for queue family {}: {}", queueTypeIndex, result);
+        return nullptr;
+    }
+
+    auto commandPool = std::make_unique<VulkanCommandPool>(vkCommandPool, queueTypeIndex, Handle<Device_t>{}, key.first);
+    return commandPools.emplace(key, std::move(commandPool)).first->second.get();
+}
+
+void VulkanDevice::releaseThreadCommandPools()
+{
+    const std::thread::id threadId = std::this_thread::get_id();
+
+    std::lock_guard lock(*commandPoolsMutex);
+    for (auto it = commandPools.begin(); it != commandPools.end();) {
+        if (it->first.first != threadId) {
+            ++it;
+            continue;
+        }
+
+        // Command buffers still alive keep the pool around until they are destroyed
+        it->second->retire();
+        retiredCommandPools.push_back(std::move(it->second));
+        it = commandPools.erase(it);
+    }
+
+    destroyUnusedRetiredCommandPools();
+}
+
+void VulkanDevice::destroyUnusedRetiredCommandPools()
+{
+    // Expects commandPoolsMutex to be locked
+    auto it = std::remove_if(retiredCommandPools.begin(), retiredCommandPools.end(), [this](const std::unique_ptr<VulkanCommandPool> &commandPool) {
+        if (commandPool->hasLiveCommandBuffers())
+            return false;
+        vkDestroyCommandPool(device, commandPool->commandPool, nullptr);
+        return true;
+    });
+    retiredCommandPools.erase(it, retiredCommandPools.end());
+}
+
 VmaAllocator VulkanDevice::getOrCreateExternalMemoryAllocator(ExternalMemoryHandleTypeFlags externalMemoryHandleType)
 {
+    std::lock_guard lock(*externalAllocatorsMutex);
     VmaAllocator allocator = VK_NULL_HANDLE;
     auto it = std::find_if(externalAllocators.begin(), externalAllocators.end(), [externalMemoryHandleType](const auto &typeAndAllocator) {
         return (typeAndAllocator.externalMemoryHandleType & externalMemoryHandleType) == externalMemoryHandleType;
@@ -444,6 +569,123 @@ void VulkanDevice::fillWriteBindGroupDataForBindGroupEntry(WriteBindGroupData &w
     }
 }
 
+bool VulkanDevice::packDescriptorUpdateTemplateData(std::vector<VulkanDescriptorUpdateTemplateData> &templateData,
+                                                    const VulkanBindGroupLayout &bindGroupLayout,
+                                                    std::span<const BindingResource> resources) const
+{
+    const uint32_t descriptorCount = bindGroupLayout.descriptorCount();
+    if (resources.size() != descriptorCount) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Descriptor update template expects {} resources, got {}", descriptorCount, resources.size());
+        return false;
+    }
+
+    // Resources are packed in binding order, each one has to match the type of the binding it lands in
+    size_t slot = 0;
+    for (const ResourceBindingLayout &binding : bindGroupLayout.bindings) {
+        if (binding.flags.testFlag(ResourceBindingFlagBits::VariableBindGroupEntriesCountBit)) {
+            SPDLOG_LOGGER_ERROR(Logger::logger(), "Descriptor update templates can't be used with variable sized bindings");
+            return false;
+        }
+        for (uint32_t i = 0; i < binding.count; ++i, ++slot) {
+            if (resources[slot].type() != binding.resourceType) {
+                SPDLOG_LOGGER_ERROR(Logger::logger(), "Descriptor update template resource {} doesn't match the type of binding {}", slot, binding.binding);
+                return false;
+            }
+        }
+    }
+
+    templateData.resize(descriptorCount);
+    for (size_t i = 0; i < descriptorCount; ++i) {
+        VulkanDescriptorUpdateTemplateData &data = templateData[i];
+        data = {};
+        const BindingResource &resource = resources[i];
+
+        switch (resource.type()) {
+        case ResourceBindingType::CombinedImageSampler: {
+            const TextureViewSamplerBinding &textureViewBinding = resource.textureViewSamplerBinding();
+            VulkanTextureView *textView = vulkanResourceManager->getTextureView(textureViewBinding.textureView);
+            VulkanSampler *sampler = vulkanResourceManager->getSampler(textureViewBinding.sampler);
+            assert(textView != nullptr);
+            data.imageInfo.imageView = textView->imageView;
+            data.imageInfo.imageLayout = textureLayoutToVkImageLayout(textureViewBinding.layout);
+            // Sampler can be null if the pipelineLayout was allocated with an immutableSampler for that binding
+            if (sampler != nullptr)
+                data.imageInfo.sampler = sampler->sampler;
+            break;
+        }
+        case ResourceBindingType::SampledImage: {
+            const TextureViewBinding &textureViewBinding = resource.textureViewBinding();
+            VulkanTextureView *textView = vulkanResourceManager->getTextureView(textureViewBinding.textureView);
+            assert(textView != nullptr);
+            data.imageInfo.imageView = textView->imageView;
+            data.imageInfo.imageLayout = textureLayoutToVkImageLayout(textureViewBinding.layout);
+            break;
+        }
+        case ResourceBindingType::Sampler: {
+            VulkanSampler *sampler = vulkanResourceManager->getSampler(resource.samplerBinding().sampler);
+            assert(sampler != nullptr);
+            data.imageInfo.sampler = sampler->sampler;
+            break;
+        }
+        case ResourceBindingType::StorageImage: {
+            const ImageBinding &imageBinding = resource.imageBinding();
+            VulkanTextureView *textView = vulkanResourceManager->getTextureView(imageBinding.textureView);
+            assert(textView != nullptr);
+            data.imageInfo.imageView = textView->imageView;
+            data.imageInfo.imageLayout = textureLayoutToVkImageLayout(imageBinding.layout);
+            break;
+        }
+        case ResourceBindingType::InputAttachment: {
+            const InputAttachmentBinding &inputAttachmentBinding = resource.inputAttachmentBinding();
+            VulkanTextureView *textView = vulkanResourceManager->getTextureView(inputAttachmentBinding.textureView);
+            assert(textView != nullptr);
+            data.imageInfo.imageView = textView->imageView;
+            data.imageInfo.imageLayout = textureLayoutToVkImageLayout(inputAttachmentBinding.layout);
+            break;
+        }
+        case ResourceBindingType::UniformBuffer: {
+            const UniformBufferBinding &bufferBinding = resource.uniformBufferBinding();
+            VulkanBuffer *buffer = vulkanResourceManager->getBuffer(bufferBinding.buffer);
+            assert(buffer != nullptr);
+            data.bufferInfo.buffer = buffer->buffer;
+            data.bufferInfo.offset = bufferBinding.offset;
+            data.bufferInfo.range = (bufferBinding.size == UniformBufferBinding::WholeSize) ? VK_WHOLE_SIZE : bufferBinding.size;
+            break;
+        }
+        case ResourceBindingType::StorageBuffer: {
+            const StorageBufferBinding &bufferBinding = resource.storageBufferBinding();
+            VulkanBuffer *buffer = vulkanResourceManager->getBuffer(bufferBinding.buffer);
+            assert(buffer != nullptr);
+            data.bufferInfo.buffer = buffer->buffer;
+            data.bufferInfo.offset = bufferBinding.offset;
+            data.bufferInfo.range = (bufferBinding.size == StorageBufferBinding::WholeSize) ? VK_WHOLE_SIZE : bufferBinding.size;
+            break;
+        }
+        case ResourceBindingType::DynamicUniformBuffer: {
+            const DynamicUniformBufferBinding &bufferBinding = resource.dynamicUniformBufferBinding();
+            VulkanBuffer *buffer = vulkanResourceManager->getBuffer(bufferBinding.buffer);
+            assert(buffer != nullptr);
+            data.bufferInfo.buffer = buffer->buffer;
+            data.bufferInfo.offset = bufferBinding.offset;
+            data.bufferInfo.range = (bufferBinding.size == DynamicUniformBufferBinding::WholeSize) ? VK_WHOLE_SIZE : bufferBinding.size;
+            break;
+        }
+#if defined(VK_KHR_acceleration_structure)
+        case ResourceBindingType::AccelerationStructure: {
+            VulkanAccelerationStructure *accelerationStructure = vulkanResourceManager->getAccelerationStructure(resource.accelerationStructure().accelerationStructure);
+            assert(accelerationStructure != nullptr);
+            data.accelerationStructure = accelerationStructure->accelerationStructure;
+            break;
+        }
+#endif
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
+
 } // namespace KDGpu
 
 // NOLINTEND(readability-function-cognitive-complexity)
@@ -11,20 +11,30 @@
 #pragma once
 
 #include <span>
+#include <KDGpu/vulkan/vulkan_bind_group_layout.h>
+#include <KDGpu/vulkan/vulkan_command_buffer.h>
 #include <KDGpu/vulkan/vulkan_framebuffer.h>
+#include <KDGpu/vulkan/vulkan_graphics_pipeline.h>
+#include <KDGpu/vulkan/vulkan_pipeline_layout.h>
 #include <KDGpu/vulkan/vulkan_render_pass.h>
+#include <KDGpu/vulkan/vulkan_sampler.h>
 
 #include <KDGpu/handle.h>
 #include <KDGpu/kdgpu_export.h>
 #include <KDGpu/config.h>
+#include <KDGpu/utils/thread_pool.h>
 
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <KDGpu/adapter_features.h>
 #include <KDGpu/adapter_queue_type.h>
+#include <KDGpu/bind_group_pool_statistics.h>
 #include <KDGpu/device_options.h>
 #include <KDGpu/queue_description.h>
 
@@ -40,6 +50,7 @@ class VulkanResourceManager;
 struct Adapter_t;
 struct BindGroupPool_t;
 struct BindGroupEntry;
+class BindingResource;
 
 struct WriteBindGroupData {
     VkDescriptorBufferInfo bufferInfo{};
@@ -75,14 +86,24 @@ struct KDGPU_EXPORT VulkanDevice {
 
     void waitUntilIdle() const;
 
+    std::vector<uint8_t> pipelineCacheData() const;
+
+    ThreadPool *pipelineCompilationThreadPool();
+
+    VulkanCommandPool *commandPoolForCurrentThread(uint32_t queueTypeIndex);
+    void releaseThreadCommandPools();
+    void destroyUnusedRetiredCommandPools();
+
     VmaAllocator getOrCreateExternalMemoryAllocator(ExternalMemoryHandleTypeFlags externalMemoryHandleType);
     VmaAllocator createMemoryAllocator(ExternalMemoryHandleTypeFlags externalMemoryHandleType = ExternalMemoryHandleTypeFlagBits::None) const;
     void fillWriteBindGroupDataForBindGroupEntry(WriteBindGroupData &writeBindGroupData, const BindGroupEntry &entry, const VkDescriptorSet &descriptorSet = VK_NULL_HANDLE) const;
+    bool packDescriptorUpdateTemplateData(std::vector<VulkanDescriptorUpdateTemplateData> &templateData, const VulkanBindGroupLayout &bindGroupLayout, std::span<const BindingResource> resources) const;
 
     // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
     VkDevice device{ VK_NULL_HANDLE };
     uint32_t apiVersion{};
     AdapterFeatures requestedFeatures{};
+    uint32_t maxDrawIndirectCount{ 1 };
 
     VulkanResourceManager *vulkanResourceManager{ nullptr };
     Handle<Adapter_t> adapterHandle;
@@ -92,12 +113,33 @@ struct KDGPU_EXPORT VulkanDevice {
         VmaAllocator allocator;
     };
     std::vector<MemoryHandleTypeAndAllocator> externalAllocators;
+    std::unique_ptr<std::mutex> externalAllocatorsMutex{ std::make_unique<std::mutex>() }; // Guards externalAllocators
     std::vector<QueueDescription> queueDescriptions;
-    std::vector<VkCommandPool> commandPools; // Indexed by queue type (family)
+    std::map<std::pair<std::thread::id, uint32_t>, std::unique_ptr<VulkanCommandPool>> commandPools; // Keyed by recording thread and queue type (family)
+    std::vector<std::unique_ptr<VulkanCommandPool>> retiredCommandPools; // Released by their thread, destroyed once their command buffers are gone
+    std::unique_ptr<std::mutex> commandPoolsMutex{ std::make_unique<std::mutex>() }; // Guards commandPools and retiredCommandPools
     std::vector<Handle<BindGroupPool_t>> descriptorSetPools;
+    BindGroupPoolStatistics descriptorSetPoolsStatistics;
+    std::unique_ptr<std::mutex> descriptorSetPoolsMutex{ std::make_unique<std::mutex>() }; // Guards descriptorSetPools and descriptorSetPoolsStatistics
     std::unordered_map<VulkanRenderPassKey, Handle<RenderPass_t>> renderPasses;
     std::unordered_map<VulkanFramebufferKey, Handle<Framebuffer_t>> framebuffers;
+    std::unique_ptr<std::mutex> renderPassesAndFramebuffersMutex{ std::make_unique<std::mutex>() }; // Guards renderPasses and framebuffers
     VkQueryPool timestampQueryPool{ VK_NULL_HANDLE };
+    VkPipelineCache pipelineCache{ VK_NULL_HANDLE };
+    std::string pipelineCacheFilePath;
+    std::unique_ptr<ThreadPool> pipelineThreadPool; // Lazily created by pipelineCompilationThreadPool()
+    std::unique_ptr<std::mutex> pipelineThreadPoolMutex{ std::make_unique<std::mutex>() }; // Guards the creation of pipelineThreadPool
+    std::unique_ptr<VulkanGraphicsPipelineRegistry> graphicsPipelineRegistry; // Only set if deduplication was requested
+    bool deduplicateLayouts{ false };
+    // Only filled if deduplicateLayouts is set. Keys are stored without label and with sorted bindings.
+    std::unordered_map<BindGroupLayoutOptions, Handle<BindGroupLayout_t>> bindGroupLayouts;
+    std::unordered_map<PipelineLayoutOptions, Handle<PipelineLayout_t>> pipelineLayouts;
+    std::unique_ptr<std::mutex> layoutsMutex{ std::make_unique<std::mutex>() }; // Guards bindGroupLayouts, pipelineLayouts and the refCount of the layouts they hold
+    bool deduplicateSamplers{ false };
+    std::unordered_map<SamplerOptions, Handle<Sampler_t>> samplers; // Only filled if deduplicateSamplers is set
+    uint64_t samplerCacheHits{ 0 };
+    uint64_t samplerCacheMisses{ 0 };
+    std::unique_ptr<std::mutex> samplersMutex{ std::make_unique<std::mutex>() }; // Guards samplers, their refCount and the cache counters
 
 #if defined(VK_EXT_debug_utils)
     PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT{ nullptr };
@@ -161,6 +203,7 @@ struct KDGPU_EXPORT VulkanDevice {
 
 #if defined(VK_KHR_push_descriptor)
     PFN_vkCmdPushDescriptorSetKHR vkCmdPushDescriptorSetKHR{ nullptr };
+    PFN_vkCmdPushDescriptorSetWithTemplateKHR vkCmdPushDescriptorSetWithTemplateKHR{ nullptr };
 #endif
 
 #if defined(VK_KHR_dynamic_rendering)
@@ -173,6 +216,20 @@ struct KDGPU_EXPORT VulkanDevice {
     PFN_vkCmdSetRenderingInputAttachmentIndicesKHR vkCmdSetRenderingInputAttachmentIndicesKHR{ nullptr };
 #endif
 
+#if defined(VK_KHR_draw_indirect_count)
+    PFN_vkCmdDrawIndirectCountKHR vkCmdDrawIndirectCountKHR{ nullptr };
+    PFN_vkCmdDrawIndexedIndirectCountKHR vkCmdDrawIndexedIndirectCountKHR{ nullptr };
+#endif
+
+#if defined(VK_EXT_descriptor_buffer)
+    VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorBufferProperties{};
+    PFN_vkGetDescriptorSetLayoutSizeEXT vkGetDescriptorSetLayoutSizeEXT{ nullptr };
+    PFN_vkGetDescriptorSetLayoutBindingOffsetEXT vkGetDescriptorSetLayoutBindingOffsetEXT{ nullptr };
+    PFN_vkGetDescriptorEXT vkGetDescriptorEXT{ nullptr };
+    PFN_vkCmdBindDescriptorBuffersEXT vkCmdBindDescriptorBuffersEXT{ nullptr };
+    PFN_vkCmdSetDescriptorBufferOffsetsEXT vkCmdSetDescriptorBufferOffsetsEXT{ nullptr };
+#endif
+
     bool isOwned{ true };
     // NOLINTEND(misc-non-private-member-variables-in-classes)
 };
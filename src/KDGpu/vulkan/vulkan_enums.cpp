@@ -474,6 +474,8 @@ VkImageCreateFlags textureCreateFlagsToVkImageCreateFlags(TextureCreateFlags fla
 
 VkDescriptorPoolCreateFlags bindGroupPoolFlagsToVkDescriptorPoolCreateFlags(BindGroupPoolFlags flags)
 {
+    // DescriptorBuffer has no VkDescriptorPool equivalent
+    flags &= ~BindGroupPoolFlags(BindGroupPoolFlagBits::DescriptorBuffer);
     return static_cast<VkDescriptorPoolCreateFlags>(flags.toInt());
 }
 
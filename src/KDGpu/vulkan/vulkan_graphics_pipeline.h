@@ -12,9 +12,12 @@
 
 #include <KDGpu/kdgpu_export.h>
 #include <KDGpu/handle.h>
+#include <KDGpu/graphics_pipeline_options.h>
 
 #include <vulkan/vulkan.h>
 
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace KDGpu {
@@ -22,6 +25,7 @@ namespace KDGpu {
 class VulkanResourceManager;
 
 struct Device_t;
+struct GraphicsPipeline_t;
 struct PipelineLayout_t;
 struct RenderPass_t;
 
@@ -50,4 +54,25 @@ struct KDGPU_EXPORT VulkanGraphicsPipeline {
     bool dynamicRendering{ false };
 };
 
+/**
+ * @brief VulkanGraphicsPipelineRegistry
+ * \ingroup vulkan
+ *
+ * Maps GraphicsPipelineOptions to the pipeline created for them so that identical
+ * requests share a single VkPipeline. Keys are stored with an empty label as the
+ * label is not owned by the options.
+ */
+struct KDGPU_EXPORT VulkanGraphicsPipelineRegistry {
+    struct Entry {
+        GraphicsPipelineOptions options;
+        uint32_t refCount{ 0 };
+    };
+
+    std::mutex mutex;
+    std::unordered_map<GraphicsPipelineOptions, Handle<GraphicsPipeline_t>> pipelines;
+    std::unordered_map<Handle<GraphicsPipeline_t>, Entry> entries;
+    uint64_t hits{ 0 };
+    uint64_t misses{ 0 };
+};
+
 } // namespace KDGpu
@@ -10,17 +10,103 @@
 
 #include "vulkan_pipeline_layout.h"
 
+#include <KDGpu/vulkan/vulkan_bind_group_layout.h>
+#include <KDGpu/vulkan/vulkan_device.h>
+#include <KDGpu/vulkan/vulkan_formatters.h>
+#include <KDGpu/vulkan/vulkan_resource_manager.h>
+#include <KDGpu/utils/logging.h>
+
+#include <algorithm>
+
 namespace KDGpu {
 
 VulkanPipelineLayout::VulkanPipelineLayout(VkPipelineLayout _pipelineLayout,
                                            std::vector<VkDescriptorSetLayout> &&_descriptorSetLayouts,
+                                           std::vector<Handle<BindGroupLayout_t>> &&_bindGroupLayouts,
                                            VulkanResourceManager *_vulkanResourceManager,
                                            const Handle<Device_t> &_deviceHandle)
     : pipelineLayout(_pipelineLayout)
     , descriptorSetLayouts(_descriptorSetLayouts)
+    , bindGroupLayouts(_bindGroupLayouts)
     , vulkanResourceManager(_vulkanResourceManager)
     , deviceHandle(_deviceHandle)
 {
 }
 
+VkDescriptorUpdateTemplate VulkanPipelineLayout::pushDescriptorUpdateTemplate(VkPipelineBindPoint bindPoint, uint32_t set)
+{
+    std::lock_guard lock(*pushDescriptorUpdateTemplatesMutex);
+
+    auto it = std::find_if(pushDescriptorUpdateTemplates.begin(), pushDescriptorUpdateTemplates.end(),
+                           [bindPoint, set](const PushDescriptorUpdateTemplate &t) {
+                               return t.bindPoint == bindPoint && t.set == set;
+                           });
+    if (it != pushDescriptorUpdateTemplates.end())
+        return it->updateTemplate;
+
+    if (set >= bindGroupLayouts.size())
+        return VK_NULL_HANDLE;
+
+    VulkanBindGroupLayout *bindGroupLayout = vulkanResourceManager->getBindGroupLayout(bindGroupLayouts[set]);
+    if (bindGroupLayout == nullptr)
+        return VK_NULL_HANDLE;
+
+    const std::vector<VkDescriptorUpdateTemplateEntry> entries = bindGroupLayout->descriptorUpdateTemplateEntries();
+
+    VkDescriptorUpdateTemplateCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+    createInfo.pDescriptorUpdateEntries = entries.data();
+    createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+    createInfo.pipelineBindPoint = bindPoint;
+    createInfo.pipelineLayout = pipelineLayout;
+    createInfo.set = set;
+
+    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+    VkDescriptorUpdateTemplate updateTemplate{ VK_NULL_HANDLE };
+    if (auto result = vkCreateDescriptorUpdateTemplate(vulkanDevice->device, &createInfo, nullptr, &updateTemplate); result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating push descriptor update template: {}", result);
+        return VK_NULL_HANDLE;
+    }
+
+    pushDescriptorUpdateTemplates.push_back({ bindPoint, set, updateTemplate });
+    return updateTemplate;
+}
+
+void VulkanPipelineLayout::pushBindGroupWithTemplate(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, uint32_t set,
+                                                     std::span<const BindingResource> resources)
+{
+#if defined(VK_KHR_push_descriptor)
+    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+    if (vulkanDevice->vkCmdPushDescriptorSetWithTemplateKHR == nullptr)
+        return;
+
+    const VkDescriptorUpdateTemplate updateTemplate = pushDescriptorUpdateTemplate(bindPoint, set);
+    if (updateTemplate == VK_NULL_HANDLE)
+        return;
+
+    std::vector<VulkanDescriptorUpdateTemplateData> templateData;
+    VulkanBindGroupLayout *bindGroupLayout = vulkanResourceManager->getBindGroupLayout(bindGroupLayouts[set]);
+    if (bindGroupLayout == nullptr)
+        return;
+    if (!vulkanDevice->packDescriptorUpdateTemplateData(templateData, *bindGroupLayout, resources))
+        return;
+
+    vulkanDevice->vkCmdPushDescriptorSetWithTemplateKHR(commandBuffer, updateTemplate, pipelineLayout, set, templateData.data());
+#else
+    assert(false);
+#endif
+}
+
+void VulkanPipelineLayout::destroyPushDescriptorUpdateTemplates()
+{
+    if (pushDescriptorUpdateTemplates.empty())
+        return;
+
+    VulkanDevice *vulkanDevice = vulkanResourceManager->getDevice(deviceHandle);
+    for (const PushDescriptorUpdateTemplate &t : pushDescriptorUpdateTemplates)
+        vkDestroyDescriptorUpdateTemplate(vulkanDevice->device, t.updateTemplate, nullptr);
+    pushDescriptorUpdateTemplates.clear();
+}
+
 } // namespace KDGpu
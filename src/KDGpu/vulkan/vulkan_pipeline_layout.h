@@ -12,15 +12,21 @@
 
 #include <KDGpu/kdgpu_export.h>
 #include <KDGpu/handle.h>
+#include <KDGpu/pipeline_layout_options.h>
 
 #include <vulkan/vulkan.h>
 
+#include <memory>
+#include <mutex>
+#include <span>
 #include <vector>
 
 namespace KDGpu {
 
 class VulkanResourceManager;
 
+class BindingResource;
+struct BindGroupLayout_t;
 struct Device_t;
 
 /**
@@ -31,13 +37,31 @@ struct Device_t;
 struct KDGPU_EXPORT VulkanPipelineLayout {
     explicit VulkanPipelineLayout(VkPipelineLayout _pipelineLayout,
                                   std::vector<VkDescriptorSetLayout> &&_descriptorSetLayouts,
+                                  std::vector<Handle<BindGroupLayout_t>> &&_bindGroupLayouts,
                                   VulkanResourceManager *_vulkanResourceManager,
                                   const Handle<Device_t> &_deviceHandle);
 
+    VkDescriptorUpdateTemplate pushDescriptorUpdateTemplate(VkPipelineBindPoint bindPoint, uint32_t set);
+    void pushBindGroupWithTemplate(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, uint32_t set,
+                                   std::span<const BindingResource> resources);
+    void destroyPushDescriptorUpdateTemplates();
+
+    struct PushDescriptorUpdateTemplate {
+        VkPipelineBindPoint bindPoint;
+        uint32_t set;
+        VkDescriptorUpdateTemplate updateTemplate;
+    };
+
     VkPipelineLayout pipelineLayout;
     std::vector<VkDescriptorSetLayout> descriptorSetLayouts;
+    std::vector<Handle<BindGroupLayout_t>> bindGroupLayouts;
+    std::vector<PushConstantRange> pushConstantRanges;
     VulkanResourceManager *vulkanResourceManager{ nullptr };
     Handle<Device_t> deviceHandle;
+    uint32_t refCount{ 1 }; // Only grows beyond 1 for layouts shared through VulkanDevice::pipelineLayouts
+    bool usesDescriptorBuffers{ false }; // Pipelines using this layout must be created with VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
+    std::vector<PushDescriptorUpdateTemplate> pushDescriptorUpdateTemplates; // Lazily created by pushDescriptorUpdateTemplate()
+    std::unique_ptr<std::mutex> pushDescriptorUpdateTemplatesMutex{ std::make_unique<std::mutex>() }; // Guards pushDescriptorUpdateTemplates
 };
 
 } // namespace KDGpu
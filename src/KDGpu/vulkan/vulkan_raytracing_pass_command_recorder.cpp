@@ -35,13 +35,8 @@ void VulkanRayTracingPassCommandRecorder::setPipeline(const Handle<RayTracingPip
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, vulkanPipeline->pipeline);
 }
 
-void VulkanRayTracingPassCommandRecorder::setBindGroup(uint32_t group, const Handle<BindGroup_t> &_bindGroup,
-                                                       const Handle<PipelineLayout_t> &pipelineLayout,
-                                                       std::span<const uint32_t> dynamicBufferOffsets) const
+VkPipelineLayout VulkanRayTracingPassCommandRecorder::resolvePipelineLayout(const Handle<PipelineLayout_t> &pipelineLayout) const
 {
-    VulkanBindGroup *bindGroup = vulkanResourceManager->getBindGroup(_bindGroup);
-    VkDescriptorSet set = bindGroup->descriptorSet;
-
     // Use the pipeline layout provided, otherwise fallback to the one from the currently
     // bound pipeline (if any).
     VkPipelineLayout vkPipelineLayout{ VK_NULL_HANDLE };
@@ -59,15 +54,61 @@ void VulkanRayTracingPassCommandRecorder::setBindGroup(uint32_t group, const Han
     }
 
     assert(vkPipelineLayout != VK_NULL_HANDLE); // The PipelineLayout should outlive the pipelines
+    return vkPipelineLayout;
+}
+
+void VulkanRayTracingPassCommandRecorder::setBindGroup(uint32_t group, const Handle<BindGroup_t> &_bindGroup,
+                                                       const Handle<PipelineLayout_t> &pipelineLayout,
+                                                       std::span<const uint32_t> dynamicBufferOffsets) const
+{
+    VulkanBindGroup *bindGroup = vulkanResourceManager->getBindGroup(_bindGroup);
+    VkDescriptorSet set = bindGroup->descriptorSet;
+
+    if (bindGroup->usesDescriptorBuffer()) {
+        if (!dynamicBufferOffsets.empty())
+            SPDLOG_LOGGER_ERROR(Logger::logger(), "Dynamic buffer offsets are not supported by descriptor buffer BindGroups");
+        bindGroup->bindDescriptorBuffer(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, resolvePipelineLayout(pipelineLayout), group, boundDescriptorBufferAddress);
+        return;
+    }
 
     // Bind Descriptor Set
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR,
-                            vkPipelineLayout,
+                            resolvePipelineLayout(pipelineLayout),
                             group,
                             1, &set,
                             dynamicBufferOffsets.size(), dynamicBufferOffsets.data());
 }
 
+void VulkanRayTracingPassCommandRecorder::setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                                                        const Handle<PipelineLayout_t> &pipelineLayout,
+                                                        std::span<const uint32_t> dynamicBufferOffsets) const
+{
+    // vkCmdBindDescriptorSets requires at least one set
+    if (bindGroups.empty())
+        return;
+
+    // Descriptor buffer BindGroups are bound by offset, one set at a time
+    if (vulkanResourceManager->getBindGroup(bindGroups.front())->usesDescriptorBuffer()) {
+        for (size_t i = 0, m = bindGroups.size(); i < m; ++i)
+            setBindGroup(firstGroup + static_cast<uint32_t>(i), bindGroups[i], pipelineLayout, dynamicBufferOffsets);
+        return;
+    }
+
+    std::vector<VkDescriptorSet> sets;
+    sets.reserve(bindGroups.size());
+    for (const Handle<BindGroup_t> &bindGroupHandle : bindGroups) {
+        VulkanBindGroup *bindGroup = vulkanResourceManager->getBindGroup(bindGroupHandle);
+        sets.push_back(bindGroup->descriptorSet);
+    }
+
+    // Bind all Descriptor Sets at once
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR,
+                            resolvePipelineLayout(pipelineLayout),
+                            firstGroup,
+                            sets.size(), sets.data(),
+                            dynamicBufferOffsets.size(), dynamicBufferOffsets.data());
+}
+
 namespace {
 
 VkStridedDeviceAddressRegionKHR buildVkStridedDeviceAddressRegion(
@@ -172,6 +213,24 @@ void VulkanRayTracingPassCommandRecorder::pushBindGroup(uint32_t group,
 #endif
 }
 
+void VulkanRayTracingPassCommandRecorder::pushBindGroupWithTemplate(uint32_t group,
+                                                                    std::span<const BindingResource> resources,
+                                                                    const Handle<PipelineLayout_t> &pipelineLayout) const
+{
+    Handle<PipelineLayout_t> layout = pipelineLayout;
+    if (!layout.isValid() && pipeline.isValid()) {
+        VulkanRayTracingPipeline *vulkanPipeline = vulkanResourceManager->getRayTracingPipeline(pipeline);
+        if (vulkanPipeline != nullptr)
+            layout = vulkanPipeline->pipelineLayoutHandle;
+    }
+
+    VulkanPipelineLayout *vulkanPipelineLayout = vulkanResourceManager->getPipelineLayout(layout);
+    if (vulkanPipelineLayout == nullptr)
+        return;
+
+    vulkanPipelineLayout->pushBindGroupWithTemplate(commandBuffer, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, group, resources);
+}
+
 void VulkanRayTracingPassCommandRecorder::end() const
 {
     // No op
@@ -39,11 +39,17 @@ struct KDGPU_EXPORT VulkanRayTracingPassCommandRecorder {
     void setBindGroup(uint32_t group, const Handle<BindGroup_t> &bindGroup,
                       const Handle<PipelineLayout_t> &pipelineLayout,
                       std::span<const uint32_t> dynamicBufferOffsets) const;
+    void setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                       const Handle<PipelineLayout_t> &pipelineLayout,
+                       std::span<const uint32_t> dynamicBufferOffsets) const;
     void traceRays(const RayTracingCommand &rayTracingCommand) const;
     void pushConstant(const PushConstantRange &constantRange, const void *data) const;
     void pushBindGroup(uint32_t group,
                        std::span<const BindGroupEntry> bindGroupEntries,
                        const Handle<PipelineLayout_t> &pipelineLayout) const;
+    void pushBindGroupWithTemplate(uint32_t group,
+                                   std::span<const BindingResource> resources,
+                                   const Handle<PipelineLayout_t> &pipelineLayout) const;
     void end() const;
 
     // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
@@ -51,7 +57,11 @@ struct KDGPU_EXPORT VulkanRayTracingPassCommandRecorder {
     VulkanResourceManager *vulkanResourceManager{ nullptr };
     Handle<Device_t> deviceHandle;
     Handle<RayTracingPipeline_t> pipeline;
+    mutable VkDeviceAddress boundDescriptorBufferAddress{ 0 }; // Descriptor buffer bound by the last setBindGroup
     // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+private:
+    VkPipelineLayout resolvePipelineLayout(const Handle<PipelineLayout_t> &pipelineLayout) const;
 };
 
 } // namespace KDGpu
@@ -14,10 +14,50 @@
 #include <KDGpu/vulkan/vulkan_graphics_pipeline.h>
 #include <KDGpu/vulkan/vulkan_resource_manager.h>
 
+#include <algorithm>
 #include <array>
 
 namespace KDGpu {
 
+namespace {
+
+// Merges consecutive indirect commands that read back to back records from the same buffer
+// with the same stride into a single multi draw of at most maxDrawCount draws and hands each
+// resulting command to record. Returns how many commands were merged into a previous one.
+template<typename IndirectCommand, typename RecordFunction>
+uint32_t coalesceIndirectCommands(std::span<const IndirectCommand> drawCommands, uint32_t tightStride, uint32_t maxDrawCount, RecordFunction &&record)
+{
+    const auto effectiveStride = [tightStride](const IndirectCommand &drawCommand) {
+        return drawCommand.stride != 0 ? drawCommand.stride : tightStride;
+    };
+
+    uint32_t mergedCount = 0;
+    size_t i = 0;
+    while (i < drawCommands.size()) {
+        IndirectCommand merged = drawCommands[i++];
+        const uint32_t stride = effectiveStride(merged);
+
+        while (i < drawCommands.size()) {
+            const IndirectCommand &next = drawCommands[i];
+            if (next.buffer != merged.buffer ||
+                effectiveStride(next) != stride ||
+                next.offset != merged.offset + static_cast<size_t>(merged.drawCount) * stride ||
+                static_cast<uint64_t>(merged.drawCount) + next.drawCount > maxDrawCount)
+                break;
+            merged.drawCount += next.drawCount;
+            ++mergedCount;
+            ++i;
+        }
+
+        if (merged.drawCount > 1)
+            merged.stride = stride;
+        record(merged);
+    }
+    return mergedCount;
+}
+
+} // namespace
+
 VulkanRenderPassCommandRecorder::VulkanRenderPassCommandRecorder(VkCommandBuffer _commandBuffer,
                                                                  VkRect2D _renderArea,
                                                                  VulkanResourceManager *_vulkanResourceManager,
@@ -33,9 +73,15 @@ VulkanRenderPassCommandRecorder::VulkanRenderPassCommandRecorder(VkCommandBuffer
 
 void VulkanRenderPassCommandRecorder::setPipeline(const Handle<GraphicsPipeline_t> &_pipeline)
 {
+    if (firstPipelineWasSet && pipeline == _pipeline) {
+        ++redundantStateStatistics.skippedPipelineBinds;
+        return;
+    }
+
     pipeline = _pipeline;
     VulkanGraphicsPipeline *vulkanGraphicsPipeline = vulkanResourceManager->getGraphicsPipeline(pipeline);
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkanGraphicsPipeline->pipeline);
+    pipelineLayout = vulkanGraphicsPipeline->pipelineLayoutHandle;
 
     if (!firstPipelineWasSet) {
         // Set the initial viewport and scissor rect to the full extent of the render area
@@ -50,12 +96,34 @@ void VulkanRenderPassCommandRecorder::setPipeline(const Handle<GraphicsPipeline_
         vkCmdSetViewport(commandBuffer, 0, 1, &vkViewport);
         vkCmdSetScissor(commandBuffer, 0, 1, &renderArea);
 
+        boundViewport = Viewport{
+            .x = vkViewport.x,
+            .y = vkViewport.y,
+            .width = vkViewport.width,
+            .height = vkViewport.height,
+            .minDepth = vkViewport.minDepth,
+            .maxDepth = vkViewport.maxDepth
+        };
+        boundScissor = Rect2D{
+            .offset = { .x = renderArea.offset.x, .y = renderArea.offset.y },
+            .extent = { .width = renderArea.extent.width, .height = renderArea.extent.height }
+        };
+
         firstPipelineWasSet = true;
     }
 }
 
-void VulkanRenderPassCommandRecorder::setVertexBuffer(uint32_t index, const Handle<Buffer_t> &buffer, DeviceSize offset) const
+void VulkanRenderPassCommandRecorder::setVertexBuffer(uint32_t index, const Handle<Buffer_t> &buffer, DeviceSize offset)
 {
+    if (index >= boundVertexBuffers.size())
+        boundVertexBuffers.resize(index + 1);
+    BoundVertexBuffer &bound = boundVertexBuffers[index];
+    if (bound.buffer == buffer && bound.offset == offset) {
+        ++redundantStateStatistics.skippedVertexBufferBinds;
+        return;
+    }
+    bound = { buffer, offset };
+
     VulkanBuffer *vulkanBuffer = vulkanResourceManager->getBuffer(buffer);
     const std::array<VkBuffer, 1> buffers = { vulkanBuffer->buffer };
     const std::array<VkDeviceSize, 1> offsets = { offset };
@@ -63,37 +131,113 @@ void VulkanRenderPassCommandRecorder::setVertexBuffer(uint32_t index, const Hand
     vkCmdBindVertexBuffers(commandBuffer, index, 1, buffers.data(), offsets.data());
 }
 
-void VulkanRenderPassCommandRecorder::setIndexBuffer(const Handle<Buffer_t> &buffer, DeviceSize offset, IndexType indexType) const
+void VulkanRenderPassCommandRecorder::setVertexBuffers(uint32_t firstBinding,
+                                                       std::span<const Handle<Buffer_t>> buffers,
+                                                       std::span<const DeviceSize> offsets)
+{
+    assert(offsets.empty() || offsets.size() == buffers.size());
+    const size_t count = buffers.size();
+    if (firstBinding + count > boundVertexBuffers.size())
+        boundVertexBuffers.resize(firstBinding + count);
+
+    // Only record the range of bindings that actually changes
+    size_t first = count;
+    size_t last = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const DeviceSize offset = offsets.empty() ? 0 : offsets[i];
+        BoundVertexBuffer &bound = boundVertexBuffers[firstBinding + i];
+        if (bound.buffer == buffers[i] && bound.offset == offset)
+            continue;
+        bound = { buffers[i], offset };
+        first = std::min(first, i);
+        last = i + 1;
+    }
+
+    if (first == count) {
+        redundantStateStatistics.skippedVertexBufferBinds += count;
+        return;
+    }
+    redundantStateStatistics.skippedVertexBufferBinds += count - (last - first);
+
+    std::vector<VkBuffer> vkBuffers;
+    std::vector<VkDeviceSize> vkOffsets;
+    vkBuffers.reserve(last - first);
+    vkOffsets.reserve(last - first);
+    for (size_t i = first; i < last; ++i) {
+        VulkanBuffer *vulkanBuffer = vulkanResourceManager->getBuffer(buffers[i]);
+        vkBuffers.push_back(vulkanBuffer->buffer);
+        vkOffsets.push_back(offsets.empty() ? 0 : offsets[i]);
+    }
+
+    vkCmdBindVertexBuffers(commandBuffer, firstBinding + first, vkBuffers.size(), vkBuffers.data(), vkOffsets.data());
+}
+
+void VulkanRenderPassCommandRecorder::setIndexBuffer(const Handle<Buffer_t> &buffer, DeviceSize offset, IndexType indexType)
 {
+    if (boundIndexBuffer.buffer == buffer && boundIndexBuffer.offset == offset && boundIndexBuffer.indexType == indexType) {
+        ++redundantStateStatistics.skippedIndexBufferBinds;
+        return;
+    }
+    boundIndexBuffer = { buffer, offset, indexType };
+
     VulkanBuffer *vulkanBuffer = vulkanResourceManager->getBuffer(buffer);
     vkCmdBindIndexBuffer(commandBuffer, vulkanBuffer->buffer, offset, indexTypeToVkIndexType(indexType));
 }
 
-void VulkanRenderPassCommandRecorder::setBindGroup(uint32_t group, const Handle<BindGroup_t> &bindGroupH,
-                                                   const Handle<PipelineLayout_t> &pipelineLayout,
-                                                   std::span<const uint32_t> dynamicBufferOffsets) const
+VkPipelineLayout VulkanRenderPassCommandRecorder::resolvePipelineLayout(const Handle<PipelineLayout_t> &layout) const
 {
-    VulkanBindGroup *bindGroup = vulkanResourceManager->getBindGroup(bindGroupH);
-    VkDescriptorSet set = bindGroup->descriptorSet;
+    VulkanPipelineLayout *vulkanPipelineLayout = vulkanResourceManager->getPipelineLayout(layout);
+    return vulkanPipelineLayout ? vulkanPipelineLayout->pipelineLayout : VK_NULL_HANDLE;
+}
 
+void VulkanRenderPassCommandRecorder::invalidateBindGroupsIncompatibleWith(const Handle<PipelineLayout_t> &layout)
+{
+    // Binding sets with a different layout may disturb the sets bound with the previous one
+    for (BoundBindGroup &bound : boundBindGroups) {
+        if (bound.pipelineLayout != layout)
+            bound = {};
+    }
+}
+
+void VulkanRenderPassCommandRecorder::setBindGroup(uint32_t group, const Handle<BindGroup_t> &bindGroupH,
+                                                   const Handle<PipelineLayout_t> &_pipelineLayout,
+                                                   std::span<const uint32_t> dynamicBufferOffsets)
+{
     // Use the pipeline layout provided, otherwise fallback to the one from the currently
     // bound pipeline (if any).
-    VkPipelineLayout vkPipelineLayout{ VK_NULL_HANDLE };
-    if (pipelineLayout.isValid()) {
-        VulkanPipelineLayout *vulkanPipelineLayout = vulkanResourceManager->getPipelineLayout(pipelineLayout);
-        if (vulkanPipelineLayout)
-            vkPipelineLayout = vulkanPipelineLayout->pipelineLayout;
-    } else if (pipeline.isValid()) {
-        VulkanGraphicsPipeline *vulkanPipeline = vulkanResourceManager->getGraphicsPipeline(pipeline);
-        if (vulkanPipeline) {
-            VulkanPipelineLayout *vulkanPipelineLayout = vulkanResourceManager->getPipelineLayout(vulkanPipeline->pipelineLayoutHandle);
-            if (vulkanPipelineLayout)
-                vkPipelineLayout = vulkanPipelineLayout->pipelineLayout;
-        }
+    const Handle<PipelineLayout_t> &layout = _pipelineLayout.isValid() ? _pipelineLayout : pipelineLayout;
+
+    if (group >= boundBindGroups.size())
+        boundBindGroups.resize(group + 1);
+    BoundBindGroup &bound = boundBindGroups[group];
+    if (bound.bindGroup == bindGroupH && bound.pipelineLayout == layout &&
+        std::ranges::equal(bound.dynamicBufferOffsets, dynamicBufferOffsets)) {
+        ++redundantStateStatistics.skippedBindGroupBinds;
+        return;
     }
 
+    invalidateBindGroupsIncompatibleWith(layout);
+    boundBindGroups[group] = { bindGroupH, layout, { dynamicBufferOffsets.begin(), dynamicBufferOffsets.end() } };
+
+    VulkanBindGroup *bindGroup = vulkanResourceManager->getBindGroup(bindGroupH);
+    VkDescriptorSet set = bindGroup->descriptorSet;
+
+    const VkPipelineLayout vkPipelineLayout = resolvePipelineLayout(layout);
     assert(vkPipelineLayout != VK_NULL_HANDLE); // The PipelineLayout should outlive the pipelines
 
+    if (bindGroup->usesDescriptorBuffer()) {
+        if (!dynamicBufferOffsets.empty())
+            SPDLOG_LOGGER_ERROR(Logger::logger(), "Dynamic buffer offsets are not supported by descriptor buffer BindGroups");
+        if (bindGroup->bindDescriptorBuffer(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vkPipelineLayout, group, boundDescriptorBufferAddress)) {
+            // The sets bound from the previous descriptor buffer now point into this one and have to be bound again
+            for (size_t i = 0; i < boundBindGroups.size(); ++i) {
+                if (i != group)
+                    boundBindGroups[i] = {};
+            }
+        }
+        return;
+    }
+
     // Bind Descriptor Set
     vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
                             vkPipelineLayout,
@@ -102,8 +246,76 @@ void VulkanRenderPassCommandRecorder::setBindGroup(uint32_t group, const Handle<
                             dynamicBufferOffsets.size(), dynamicBufferOffsets.data());
 }
 
-void VulkanRenderPassCommandRecorder::setViewport(const Viewport &viewport) const
+void VulkanRenderPassCommandRecorder::setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                                                    const Handle<PipelineLayout_t> &_pipelineLayout,
+                                                    std::span<const uint32_t> dynamicBufferOffsets)
+{
+    const Handle<PipelineLayout_t> &layout = _pipelineLayout.isValid() ? _pipelineLayout : pipelineLayout;
+    const size_t count = bindGroups.size();
+
+    // vkCmdBindDescriptorSets requires at least one set
+    if (count == 0)
+        return;
+
+    // Descriptor buffer BindGroups are bound by offset, one set at a time. A PipelineLayout
+    // can't mix them with regular BindGroups so checking the first one is enough
+    if (vulkanResourceManager->getBindGroup(bindGroups.front())->usesDescriptorBuffer()) {
+        for (size_t i = 0; i < count; ++i)
+            setBindGroup(firstGroup + static_cast<uint32_t>(i), bindGroups[i], layout, dynamicBufferOffsets);
+        return;
+    }
+
+    if (firstGroup + count > boundBindGroups.size())
+        boundBindGroups.resize(firstGroup + count);
+
+    // Dynamic offsets can't be attributed to individual sets without their layouts,
+    // so only bindings without any can be filtered
+    size_t first = 0;
+    size_t last = count;
+    if (dynamicBufferOffsets.empty()) {
+        auto isBound = [&](size_t i) {
+            const BoundBindGroup &bound = boundBindGroups[firstGroup + i];
+            return bound.bindGroup == bindGroups[i] && bound.pipelineLayout == layout && bound.dynamicBufferOffsets.empty();
+        };
+        while (first < count && isBound(first))
+            ++first;
+        while (last > first && isBound(last - 1))
+            --last;
+
+        redundantStateStatistics.skippedBindGroupBinds += count - (last - first);
+        if (first == last)
+            return;
+    }
+
+    invalidateBindGroupsIncompatibleWith(layout);
+
+    std::vector<VkDescriptorSet> sets;
+    sets.reserve(last - first);
+    for (size_t i = first; i < last; ++i) {
+        // Sets bound with dynamic offsets are left untracked
+        boundBindGroups[firstGroup + i] = dynamicBufferOffsets.empty() ? BoundBindGroup{ bindGroups[i], layout, {} } : BoundBindGroup{};
+        VulkanBindGroup *bindGroup = vulkanResourceManager->getBindGroup(bindGroups[i]);
+        sets.push_back(bindGroup->descriptorSet);
+    }
+
+    const VkPipelineLayout vkPipelineLayout = resolvePipelineLayout(layout);
+    assert(vkPipelineLayout != VK_NULL_HANDLE); // The PipelineLayout should outlive the pipelines
+
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                            vkPipelineLayout,
+                            firstGroup + first,
+                            sets.size(), sets.data(),
+                            dynamicBufferOffsets.size(), dynamicBufferOffsets.data());
+}
+
+void VulkanRenderPassCommandRecorder::setViewport(const Viewport &viewport)
 {
+    if (boundViewport == viewport) {
+        ++redundantStateStatistics.skippedViewports;
+        return;
+    }
+    boundViewport = viewport;
+
     VkViewport vkViewport = {
         .x = viewport.x,
         .y = viewport.y,
@@ -115,8 +327,14 @@ void VulkanRenderPassCommandRecorder::setViewport(const Viewport &viewport) cons
     vkCmdSetViewport(commandBuffer, 0, 1, &vkViewport);
 }
 
-void VulkanRenderPassCommandRecorder::setScissor(const Rect2D &scissor) const
+void VulkanRenderPassCommandRecorder::setScissor(const Rect2D &scissor)
 {
+    if (boundScissor == scissor) {
+        ++redundantStateStatistics.skippedScissors;
+        return;
+    }
+    boundScissor = scissor;
+
     VkRect2D vkScissor = {
         .offset = { .x = scissor.offset.x, .y = scissor.offset.y },
         .extent = { .width = scissor.extent.width, .height = scissor.extent.height }
@@ -170,10 +388,19 @@ void VulkanRenderPassCommandRecorder::drawIndirect(const DrawIndirectCommand &dr
                       drawCommand.stride);
 }
 
-void VulkanRenderPassCommandRecorder::drawIndirect(std::span<const DrawIndirectCommand> drawCommands) const
+void VulkanRenderPassCommandRecorder::drawIndirect(std::span<const DrawIndirectCommand> drawCommands)
 {
-    for (const auto &drawCommand : drawCommands)
+    // A drawCount greater than 1 is only valid if multiDrawIndirect was enabled
+    VulkanDevice *device = vulkanResourceManager->getDevice(deviceHandle);
+    if (!device->requestedFeatures.multiDrawIndirect) {
+        for (const auto &drawCommand : drawCommands)
+            drawIndirect(drawCommand);
+        return;
+    }
+
+    redundantStateStatistics.mergedIndirectDraws += coalesceIndirectCommands(drawCommands, sizeof(VkDrawIndirectCommand), device->maxDrawIndirectCount, [this](const DrawIndirectCommand &drawCommand) {
         drawIndirect(drawCommand);
+    });
 }
 
 void VulkanRenderPassCommandRecorder::drawIndexedIndirect(const DrawIndexedIndirectCommand &drawCommand) const
@@ -186,10 +413,71 @@ void VulkanRenderPassCommandRecorder::drawIndexedIndirect(const DrawIndexedIndir
                              drawCommand.stride);
 }
 
-void VulkanRenderPassCommandRecorder::drawIndexedIndirect(std::span<const DrawIndexedIndirectCommand> drawCommands) const
+void VulkanRenderPassCommandRecorder::drawIndexedIndirect(std::span<const DrawIndexedIndirectCommand> drawCommands)
 {
-    for (const auto &drawCommand : drawCommands)
+    // A drawCount greater than 1 is only valid if multiDrawIndirect was enabled
+    VulkanDevice *device = vulkanResourceManager->getDevice(deviceHandle);
+    if (!device->requestedFeatures.multiDrawIndirect) {
+        for (const auto &drawCommand : drawCommands)
+            drawIndexedIndirect(drawCommand);
+        return;
+    }
+
+    redundantStateStatistics.mergedIndirectDraws += coalesceIndirectCommands(drawCommands, sizeof(VkDrawIndexedIndirectCommand), device->maxDrawIndirectCount, [this](const DrawIndexedIndirectCommand &drawCommand) {
         drawIndexedIndirect(drawCommand);
+    });
+}
+
+void VulkanRenderPassCommandRecorder::drawIndirectCount(const DrawIndirectCountCommand &drawCommand) const
+{
+#if defined(VK_KHR_draw_indirect_count)
+    VulkanDevice *device = vulkanResourceManager->getDevice(deviceHandle);
+    if (device->vkCmdDrawIndirectCountKHR) {
+        VulkanBuffer *vulkanBuffer = vulkanResourceManager->getBuffer(drawCommand.buffer);
+        VulkanBuffer *vulkanCountBuffer = vulkanResourceManager->getBuffer(drawCommand.countBuffer);
+        device->vkCmdDrawIndirectCountKHR(commandBuffer,
+                                          vulkanBuffer->buffer,
+                                          drawCommand.offset,
+                                          vulkanCountBuffer->buffer,
+                                          drawCommand.countBufferOffset,
+                                          drawCommand.maxDrawCount,
+                                          drawCommand.stride);
+    }
+#else
+    assert(false);
+#endif
+}
+
+void VulkanRenderPassCommandRecorder::drawIndirectCount(std::span<const DrawIndirectCountCommand> drawCommands) const
+{
+    for (const auto &drawCommand : drawCommands)
+        drawIndirectCount(drawCommand);
+}
+
+void VulkanRenderPassCommandRecorder::drawIndexedIndirectCount(const DrawIndexedIndirectCountCommand &drawCommand) const
+{
+#if defined(VK_KHR_draw_indirect_count)
+    VulkanDevice *device = vulkanResourceManager->getDevice(deviceHandle);
+    if (device->vkCmdDrawIndexedIndirectCountKHR) {
+        VulkanBuffer *vulkanBuffer = vulkanResourceManager->getBuffer(drawCommand.buffer);
+        VulkanBuffer *vulkanCountBuffer = vulkanResourceManager->getBuffer(drawCommand.countBuffer);
+        device->vkCmdDrawIndexedIndirectCountKHR(commandBuffer,
+                                                 vulkanBuffer->buffer,
+                                                 drawCommand.offset,
+                                                 vulkanCountBuffer->buffer,
+                                                 drawCommand.countBufferOffset,
+                                                 drawCommand.maxDrawCount,
+                                                 drawCommand.stride);
+    }
+#else
+    assert(false);
+#endif
+}
+
+void VulkanRenderPassCommandRecorder::drawIndexedIndirectCount(std::span<const DrawIndexedIndirectCountCommand> drawCommands) const
+{
+    for (const auto &drawCommand : drawCommands)
+        drawIndexedIndirectCount(drawCommand);
 }
 
 void VulkanRenderPassCommandRecorder::drawMeshTasks(const DrawMeshCommand &drawCommand) const
@@ -263,11 +551,15 @@ void VulkanRenderPassCommandRecorder::pushConstant(const PushConstantRange &cons
 
 void VulkanRenderPassCommandRecorder::pushBindGroup(uint32_t group,
                                                     std::span<const BindGroupEntry> bindGroupEntries,
-                                                    const Handle<PipelineLayout_t> &pipelineLayout) const
+                                                    const Handle<PipelineLayout_t> &pipelineLayout)
 {
 #if defined(VK_KHR_push_descriptor)
     VulkanDevice *device = vulkanResourceManager->getDevice(deviceHandle);
     if (device->vkCmdPushDescriptorSetKHR) {
+        // Pushing replaces whatever was bound for that set
+        invalidateBindGroupsIncompatibleWith(pipelineLayout.isValid() ? pipelineLayout : this->pipelineLayout);
+        if (group < boundBindGroups.size())
+            boundBindGroups[group] = {};
 
         VkPipelineLayout vkPipelineLayout{ VK_NULL_HANDLE };
 
@@ -305,6 +597,23 @@ void VulkanRenderPassCommandRecorder::pushBindGroup(uint32_t group,
 #endif
 }
 
+void VulkanRenderPassCommandRecorder::pushBindGroupWithTemplate(uint32_t group,
+                                                                std::span<const BindingResource> resources,
+                                                                const Handle<PipelineLayout_t> &_pipelineLayout)
+{
+    const Handle<PipelineLayout_t> &layout = _pipelineLayout.isValid() ? _pipelineLayout : pipelineLayout;
+    VulkanPipelineLayout *vulkanPipelineLayout = vulkanResourceManager->getPipelineLayout(layout);
+    if (vulkanPipelineLayout == nullptr)
+        return;
+
+    // Pushing replaces whatever was bound for that set
+    invalidateBindGroupsIncompatibleWith(layout);
+    if (group < boundBindGroups.size())
+        boundBindGroups[group] = {};
+
+    vulkanPipelineLayout->pushBindGroupWithTemplate(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, group, resources);
+}
+
 void VulkanRenderPassCommandRecorder::nextSubpass() const
 {
     if (!dynamicRendering) {
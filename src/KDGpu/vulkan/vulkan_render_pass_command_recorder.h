@@ -12,6 +12,7 @@
 
 #include <KDGpu/bind_group.h>
 #include <KDGpu/buffer.h>
+#include <KDGpu/gpu_core.h>
 #include <KDGpu/graphics_pipeline.h>
 #include <KDGpu/kdgpu_export.h>
 #include <KDGpu/handle.h>
@@ -20,6 +21,9 @@
 
 #include <vulkan/vulkan.h>
 
+#include <optional>
+#include <vector>
+
 namespace KDGpu {
 
 class VulkanResourceManager;
@@ -39,27 +43,35 @@ struct KDGPU_EXPORT VulkanRenderPassCommandRecorder {
                                              bool _dynamicRendering);
 
     void setPipeline(const Handle<GraphicsPipeline_t> &pipeline);
-    void setVertexBuffer(uint32_t index, const Handle<Buffer_t> &buffer, DeviceSize offset) const;
-    void setIndexBuffer(const Handle<Buffer_t> &buffer, DeviceSize offset, IndexType indexType) const;
+    void setVertexBuffer(uint32_t index, const Handle<Buffer_t> &buffer, DeviceSize offset);
+    void setVertexBuffers(uint32_t firstBinding, std::span<const Handle<Buffer_t>> buffers, std::span<const DeviceSize> offsets);
+    void setIndexBuffer(const Handle<Buffer_t> &buffer, DeviceSize offset, IndexType indexType);
     void setBindGroup(uint32_t group, const Handle<BindGroup_t> &bindGroup,
-                      const Handle<PipelineLayout_t> &pipelineLayout, std::span<const uint32_t> dynamicBufferOffsets) const;
-    void setViewport(const Viewport &viewport) const;
-    void setScissor(const Rect2D &scissor) const;
+                      const Handle<PipelineLayout_t> &pipelineLayout, std::span<const uint32_t> dynamicBufferOffsets);
+    void setBindGroups(uint32_t firstGroup, std::span<const Handle<BindGroup_t>> bindGroups,
+                       const Handle<PipelineLayout_t> &pipelineLayout, std::span<const uint32_t> dynamicBufferOffsets);
+    void setViewport(const Viewport &viewport);
+    void setScissor(const Rect2D &scissor);
     void setStencilReference(StencilFaceFlags faceMask, int reference) const;
     void draw(const DrawCommand &drawCommand) const;
     void draw(std::span<const DrawCommand> drawCommands) const;
     void drawIndexed(const DrawIndexedCommand &drawCommand) const;
     void drawIndexed(std::span<const DrawIndexedCommand> drawCommands) const;
     void drawIndirect(const DrawIndirectCommand &drawCommand) const;
-    void drawIndirect(std::span<const DrawIndirectCommand> drawCommands) const;
+    void drawIndirect(std::span<const DrawIndirectCommand> drawCommands);
     void drawIndexedIndirect(const DrawIndexedIndirectCommand &drawCommand) const;
-    void drawIndexedIndirect(std::span<const DrawIndexedIndirectCommand> drawCommands) const;
+    void drawIndexedIndirect(std::span<const DrawIndexedIndirectCommand> drawCommands);
+    void drawIndirectCount(const DrawIndirectCountCommand &drawCommand) const;
+    void drawIndirectCount(std::span<const DrawIndirectCountCommand> drawCommands) const;
+    void drawIndexedIndirectCount(const DrawIndexedIndirectCountCommand &drawCommand) const;
+    void drawIndexedIndirectCount(std::span<const DrawIndexedIndirectCountCommand> drawCommands) const;
     void drawMeshTasks(const DrawMeshCommand &drawCommand) const;
     void drawMeshTasks(std::span<const DrawMeshCommand> drawCommands) const;
     void drawMeshTasksIndirect(const DrawMeshIndirectCommand &drawCommand) const;
     void drawMeshTasksIndirect(std::span<const DrawMeshIndirectCommand> drawCommands) const;
     void pushConstant(const PushConstantRange &constantRange, const void *data, const Handle<PipelineLayout_t> &pipelineLayout = {}) const;
-    void pushBindGroup(uint32_t group, std::span<const BindGroupEntry> bindGroupEntries, const Handle<PipelineLayout_t> &pipelineLayout = {}) const;
+    void pushBindGroup(uint32_t group, std::span<const BindGroupEntry> bindGroupEntries, const Handle<PipelineLayout_t> &pipelineLayout = {});
+    void pushBindGroupWithTemplate(uint32_t group, std::span<const BindingResource> resources, const Handle<PipelineLayout_t> &pipelineLayout = {});
     void nextSubpass() const;
     void setInputAttachmentMapping(std::span<const uint32_t> colorAttachmentIndices,
                                    std::optional<uint32_t> depthAttachmentIndex,
@@ -75,7 +87,35 @@ struct KDGPU_EXPORT VulkanRenderPassCommandRecorder {
     Handle<GraphicsPipeline_t> pipeline;
     bool firstPipelineWasSet{ false };
     bool dynamicRendering{ false };
+
+    // Currently bound state, used to skip redundant commands
+    struct BoundVertexBuffer {
+        Handle<Buffer_t> buffer;
+        DeviceSize offset{ 0 };
+    };
+    struct BoundIndexBuffer {
+        Handle<Buffer_t> buffer;
+        DeviceSize offset{ 0 };
+        IndexType indexType{ IndexType::Uint32 };
+    };
+    struct BoundBindGroup {
+        Handle<BindGroup_t> bindGroup;
+        Handle<PipelineLayout_t> pipelineLayout;
+        std::vector<uint32_t> dynamicBufferOffsets;
+    };
+    Handle<PipelineLayout_t> pipelineLayout; // Layout of the bound pipeline
+    std::vector<BoundVertexBuffer> boundVertexBuffers; // Indexed by binding
+    BoundIndexBuffer boundIndexBuffer;
+    std::vector<BoundBindGroup> boundBindGroups; // Indexed by set
+    std::optional<Viewport> boundViewport;
+    std::optional<Rect2D> boundScissor;
+    VkDeviceAddress boundDescriptorBufferAddress{ 0 };
+    RedundantStateStatistics redundantStateStatistics;
     // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+private:
+    VkPipelineLayout resolvePipelineLayout(const Handle<PipelineLayout_t> &layout) const;
+    void invalidateBindGroupsIncompatibleWith(const Handle<PipelineLayout_t> &layout);
 };
 
 } // namespace KDGpu
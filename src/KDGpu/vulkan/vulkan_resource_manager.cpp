@@ -38,6 +38,8 @@
 #include <KDGpu/vulkan/vulkan_graphics_api.h>
 
 #include <cassert>
+#include <cstring>
+#include <fstream>
 #include <stdexcept>
 #include <variant>
 #include <algorithm>
@@ -151,6 +153,50 @@ bool testIfContainsAnyFlags(const KDGpu::Flags<F> &flags, std::span<const F> fla
     return std::ranges::any_of(flagsToTest, [&](F f) { return flags.testFlag(f); });
 }
 
+std::vector<uint8_t> readPipelineCacheFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return {};
+
+    const std::streamsize size = file.tellg();
+    if (size <= 0)
+        return {};
+
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    if (!file.read(reinterpret_cast<char *>(data.data()), size))
+        return {};
+    return data;
+}
+
+bool writePipelineCacheFile(const std::string &path, const std::vector<uint8_t> &data)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+    file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+    return file.good();
+}
+
+// Checks the VkPipelineCacheHeaderVersionOne header of the cache data against the adapter properties.
+// Drivers are supposed to reject incompatible data themselves but some of them don't.
+bool isPipelineCacheDataCompatible(const std::vector<uint8_t> &data, const KDGpu::AdapterProperties &properties)
+{
+    constexpr size_t headerSize = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+    if (data.size() < headerSize)
+        return false;
+
+    uint32_t header[4] = {}; // headerSize, headerVersion, vendorID, deviceID
+    std::memcpy(header, data.data(), sizeof(header));
+
+    return header[0] >= headerSize &&
+            header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            header[2] == properties.vendorID &&
+            header[3] == properties.deviceID &&
+            std::memcmp(data.data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
 } // namespace
 namespace KDGpu {
 
@@ -374,6 +420,12 @@ Handle<Device_t> VulkanResourceManager::createDevice(const Handle<Adapter_t> &ad
         }
     }
 
+#if defined(VK_KHR_draw_indirect_count)
+    // drawIndirectCount is enabled through VK_KHR_draw_indirect_count, part of the default extensions
+    if (options.requestedFeatures.drawIndirectCount && !hasExtension(requestedDeviceExtensions, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME))
+        SPDLOG_LOGGER_WARN(Logger::logger(), "drawIndirectCount was requested but {} is unavailable", VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+#endif
+
     // This makes it easier to chain pNext pointers in the device createInfo struct especially when we
     // have a lot of them and some of them are optional.
     VkBaseOutStructure *chainCurrent{ nullptr };
@@ -639,6 +691,16 @@ Handle<Device_t> VulkanResourceManager::createDevice(const Handle<Adapter_t> &ad
     }
 #endif
 
+#if defined(VK_EXT_descriptor_buffer)
+    // Declared outside of the if block so that it outlives the call to vkCreateDevice
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures{};
+    if (options.requestedFeatures.descriptorBuffer) {
+        descriptorBufferFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+        descriptorBufferFeatures.descriptorBuffer = static_cast<bool>(options.requestedFeatures.descriptorBuffer);
+        addToChain(&descriptorBufferFeatures);
+    }
+#endif
+
     VkDeviceCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
     createInfo.pNext = &physicalDeviceFeatures2;
@@ -734,6 +796,18 @@ Handle<Device_t> VulkanResourceManager::createDevice(const Handle<Adapter_t> &ad
 
     const auto deviceHandle = m_devices.emplace(vkDevice, apiVersion, this, adapterHandle, options.requestedFeatures);
 
+    // Create the pipeline cache, seeded from the user provided data or cache file if any
+    VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+    vulkanDevice->pipelineCacheFilePath = options.pipelineCacheFilePath;
+    const std::vector<uint8_t> initialPipelineCacheData = (options.pipelineCacheData.empty() && !options.pipelineCacheFilePath.empty())
+            ? readPipelineCacheFile(options.pipelineCacheFilePath)
+            : options.pipelineCacheData;
+    vulkanDevice->pipelineCache = createPipelineCache(vulkanDevice, initialPipelineCacheData);
+    if (options.deduplicateGraphicsPipelines)
+        vulkanDevice->graphicsPipelineRegistry = std::make_unique<VulkanGraphicsPipelineRegistry>();
+    vulkanDevice->deduplicateLayouts = options.deduplicateLayouts;
+    vulkanDevice->deduplicateSamplers = options.deduplicateSamplers;
+
     return deviceHandle;
 }
 
@@ -743,6 +817,9 @@ Handle<Device_t> VulkanResourceManager::createDeviceFromExistingVkDevice(const H
     assert(adapter != nullptr);
     const auto deviceHandle = m_devices.emplace(vkDevice, VK_API_VERSION_1_2, this, adapterHandle, adapter->queryAdapterFeatures(), false);
 
+    VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+    vulkanDevice->pipelineCache = createPipelineCache(vulkanDevice, {});
+
     return deviceHandle;
 }
 
@@ -750,6 +827,9 @@ void VulkanResourceManager::deleteDevice(const Handle<Device_t> &handle)
 {
     VulkanDevice *vulkanDevice = m_devices.get(handle);
 
+    // Wait for pending asynchronous pipeline compilations
+    vulkanDevice->pipelineThreadPool.reset();
+
     // Destroy Render Passes
     for (const auto &[passKey, passHandle] : vulkanDevice->renderPasses) {
         VulkanRenderPass *pass = m_renderPasses.get(passHandle);
@@ -773,14 +853,26 @@ void VulkanResourceManager::deleteDevice(const Handle<Device_t> &handle)
     }
     vulkanDevice->descriptorSetPools.clear();
 
-    // Destroy Command Pool
-    for (VkCommandPool commandPool : vulkanDevice->commandPools)
-        vkDestroyCommandPool(vulkanDevice->device, commandPool, nullptr);
+    // Destroy Command Pools, this also frees any command buffer still pending release
+    for (const auto &[key, commandPool] : vulkanDevice->commandPools)
+        vkDestroyCommandPool(vulkanDevice->device, commandPool->commandPool, nullptr);
+    vulkanDevice->commandPools.clear();
+    for (const auto &commandPool : vulkanDevice->retiredCommandPools)
+        vkDestroyCommandPool(vulkanDevice->device, commandPool->commandPool, nullptr);
+    vulkanDevice->retiredCommandPools.clear();
 
     // Destroy Timestamp Query Pool
     if (vulkanDevice->timestampQueryPool != VK_NULL_HANDLE)
         vkDestroyQueryPool(vulkanDevice->device, vulkanDevice->timestampQueryPool, nullptr);
 
+    // Save and destroy Pipeline Cache
+    if (vulkanDevice->pipelineCache != VK_NULL_HANDLE) {
+        if (!vulkanDevice->pipelineCacheFilePath.empty() &&
+            !writePipelineCacheFile(vulkanDevice->pipelineCacheFilePath, vulkanDevice->pipelineCacheData()))
+            SPDLOG_LOGGER_WARN(Logger::logger(), "Failed to write pipeline cache to {}", vulkanDevice->pipelineCacheFilePath);
+        vkDestroyPipelineCache(vulkanDevice->device, vulkanDevice->pipelineCache, nullptr);
+    }
+
     // Destroy Memory Allocators
     vmaDestroyAllocator(vulkanDevice->allocator);
     for (auto [memoryHandleType, externalAllocator] : vulkanDevice->externalAllocators)
@@ -1099,6 +1191,7 @@ void VulkanResourceManager::deleteTextureView(const Handle<TextureView_t> &handl
     VulkanDevice *vulkanDevice = m_devices.get(vulkanTextureView->deviceHandle);
 
     // Iterate over Framebuffers to destroy Framebuffers where texture view was being used as an attachment
+    std::unique_lock framebuffersLock(*vulkanDevice->renderPassesAndFramebuffersMutex);
     auto it = vulkanDevice->framebuffers.begin();
     while (it != vulkanDevice->framebuffers.end()) {
         const VulkanFramebufferKey &fbKey = it->first;
@@ -1113,6 +1206,7 @@ void VulkanResourceManager::deleteTextureView(const Handle<TextureView_t> &handl
             ++it;
         }
     }
+    framebuffersLock.unlock();
 
     vkDestroyImageView(vulkanDevice->device, vulkanTextureView->imageView, nullptr);
 
@@ -1155,6 +1249,10 @@ Handle<Buffer_t> VulkanResourceManager::createBuffer(const Handle<Device_t> &dev
         allocInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
     }
 
+    // Ignored by VMA if the memory type chosen for memoryUsage isn't host visible
+    if (options.persistentlyMapped)
+        allocInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
     VkBuffer vkBuffer;
     VmaAllocation vmaAllocation;
 
@@ -1185,12 +1283,20 @@ Handle<Buffer_t> VulkanResourceManager::createBuffer(const Handle<Device_t> &dev
 
     setObjectName(vulkanDevice, VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(vkBuffer), options.label);
 
-    const auto vulkanBufferHandle = m_buffers.emplace(VulkanBuffer(vkBuffer, vmaAllocation, allocator, this, deviceHandle, memoryHandle, bufferDeviceAddress));
+    const auto vulkanBufferHandle = m_buffers.emplace(VulkanBuffer(vkBuffer, vmaAllocation, allocator, this, deviceHandle, memoryHandle, bufferDeviceAddress, options.size));
+    VulkanBuffer *vulkanBuffer = m_buffers.get(vulkanBufferHandle);
+    VkMemoryPropertyFlags memoryProperties{ 0 };
+    vmaGetAllocationMemoryProperties(allocator, vmaAllocation, &memoryProperties);
+    vulkanBuffer->hostCoherent = (memoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+    if (options.persistentlyMapped) {
+        vulkanBuffer->persistentMapping = allocationInfo.pMappedData;
+        vulkanBuffer->mapped = allocationInfo.pMappedData;
+    }
 
     if (initialData) {
-        VulkanBuffer *vulkanBuffer = m_buffers.get(vulkanBufferHandle);
         auto *bufferData = vulkanBuffer->map();
         std::memcpy(bufferData, initialData, createInfo.size);
+        vulkanBuffer->flush();
         vulkanBuffer->unmap();
     }
 
@@ -1534,15 +1640,30 @@ Handle<PipelineLayout_t> VulkanResourceManager::createPipelineLayout(const Handl
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
 
+    // With interned BindGroupLayouts, identical pipeline layouts reference identical handles
+    std::unique_lock<std::mutex> layoutsLock;
+    PipelineLayoutOptions key;
+    if (vulkanDevice->deduplicateLayouts) {
+        layoutsLock = std::unique_lock(*vulkanDevice->layoutsMutex);
+        key = PipelineLayoutOptions{ .bindGroupLayouts = options.bindGroupLayouts, .pushConstantRanges = options.pushConstantRanges };
+        if (auto it = vulkanDevice->pipelineLayouts.find(key); it != vulkanDevice->pipelineLayouts.end()) {
+            ++m_pipelineLayouts.get(it->second)->refCount;
+            return it->second;
+        }
+    }
+
     // Retrieve VkDescriptorSetLayout from the referenced options.bindGroupLayouts array
     assert(options.bindGroupLayouts.size() <= std::numeric_limits<uint32_t>::max());
     const uint32_t bindGroupLayoutCount = static_cast<uint32_t>(options.bindGroupLayouts.size());
     std::vector<VkDescriptorSetLayout> vkDescriptorSetLayouts;
     vkDescriptorSetLayouts.reserve(bindGroupLayoutCount);
+    std::vector<Handle<BindGroupLayout_t>> bindGroupLayouts = options.bindGroupLayouts;
 
+    bool usesDescriptorBuffers = false;
     for (uint32_t i = 0; i < bindGroupLayoutCount; ++i) {
         VulkanBindGroupLayout *bindGroupLayout = getBindGroupLayout(options.bindGroupLayouts[i]);
         vkDescriptorSetLayouts.push_back(bindGroupLayout->descriptorSetLayout);
+        usesDescriptorBuffers |= bindGroupLayout->flags.testFlag(BindGroupLayoutFlagBits::DescriptorBuffer);
     }
 
     // Create the pipeline layout
@@ -1582,8 +1703,14 @@ Handle<PipelineLayout_t> VulkanResourceManager::createPipelineLayout(const Handl
     const auto vulkanPipelineLayoutHandle = m_pipelineLayouts.emplace(VulkanPipelineLayout(
             vkPipelineLayout,
             std::move(vkDescriptorSetLayouts),
+            std::move(bindGroupLayouts),
             this,
             deviceHandle));
+    VulkanPipelineLayout *vulkanPipelineLayout = m_pipelineLayouts.get(vulkanPipelineLayoutHandle);
+    vulkanPipelineLayout->pushConstantRanges = options.pushConstantRanges;
+    vulkanPipelineLayout->usesDescriptorBuffers = usesDescriptorBuffers;
+    if (vulkanDevice->deduplicateLayouts)
+        vulkanDevice->pipelineLayouts.emplace(std::move(key), vulkanPipelineLayoutHandle);
 
     return vulkanPipelineLayoutHandle;
 }
@@ -1593,6 +1720,16 @@ void VulkanResourceManager::deletePipelineLayout(const Handle<PipelineLayout_t>
     VulkanPipelineLayout *vulkanPipelineLayout = m_pipelineLayouts.get(handle);
     VulkanDevice *vulkanDevice = m_devices.get(vulkanPipelineLayout->deviceHandle);
 
+    if (vulkanDevice->deduplicateLayouts) {
+        std::lock_guard lock(*vulkanDevice->layoutsMutex);
+        // Only destroy the layout once the last PipelineLayout sharing it is released
+        if (--vulkanPipelineLayout->refCount > 0)
+            return;
+        vulkanDevice->pipelineLayouts.erase(PipelineLayoutOptions{ .bindGroupLayouts = vulkanPipelineLayout->bindGroupLayouts,
+                                                                   .pushConstantRanges = vulkanPipelineLayout->pushConstantRanges });
+    }
+
+    vulkanPipelineLayout->destroyPushDescriptorUpdateTemplates();
     vkDestroyPipelineLayout(vulkanDevice->device, vulkanPipelineLayout->pipelineLayout, nullptr);
 
     m_pipelineLayouts.remove(handle);
@@ -1604,13 +1741,150 @@ VulkanPipelineLayout *VulkanResourceManager::getPipelineLayout(const Handle<Pipe
 }
 
 Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const Handle<Device_t> &deviceHandle, const GraphicsPipelineOptions &options)
+{
+    return createGraphicsPipelines(deviceHandle, std::span(&options, 1)).front();
+}
+
+std::vector<Handle<GraphicsPipeline_t>> VulkanResourceManager::createGraphicsPipelines(const Handle<Device_t> &deviceHandle, std::span<const GraphicsPipelineOptions> options)
+{
+    VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+    VulkanGraphicsPipelineRegistry *registry = vulkanDevice->graphicsPipelineRegistry.get();
+    if (!registry)
+        return compileGraphicsPipelines(deviceHandle, options);
+
+    // The label only names the pipeline, it doesn't take part in the lookup
+    std::vector<GraphicsPipelineOptions> keys(options.begin(), options.end());
+    for (GraphicsPipelineOptions &key : keys)
+        key.label = {};
+
+    const auto acquireExisting = [registry](const GraphicsPipelineOptions &key) -> Handle<GraphicsPipeline_t> {
+        const auto it = registry->pipelines.find(key);
+        if (it == registry->pipelines.end())
+            return {};
+        ++registry->entries[it->second].refCount;
+        ++registry->hits;
+        return it->second;
+    };
+
+    // Identical options within the batch are only compiled once
+    std::vector<Handle<GraphicsPipeline_t>> pipelineHandles(options.size());
+    std::vector<GraphicsPipelineOptions> optionsToCompile;
+    std::unordered_map<GraphicsPipelineOptions, size_t> compileIndices;
+    {
+        std::lock_guard lock(registry->mutex);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            pipelineHandles[i] = acquireExisting(keys[i]);
+            if (!pipelineHandles[i].isValid() && compileIndices.emplace(keys[i], optionsToCompile.size()).second)
+                optionsToCompile.push_back(options[i]);
+        }
+    }
+
+    if (optionsToCompile.empty())
+        return pipelineHandles;
+
+    // Compile without holding the lock so that other pipelines can be created concurrently
+    const std::vector<Handle<GraphicsPipeline_t>> compiledHandles = compileGraphicsPipelines(deviceHandle, optionsToCompile);
+    std::vector<bool> compiledHandleUsed(compiledHandles.size(), false);
+
+    {
+        std::lock_guard lock(registry->mutex);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (pipelineHandles[i].isValid())
+                continue;
+
+            const size_t compileIndex = compileIndices.at(keys[i]);
+            const Handle<GraphicsPipeline_t> &compiledHandle = compiledHandles[compileIndex];
+            if (!compiledHandle.isValid())
+                continue;
+
+            // Another thread may have created the same pipeline in the meantime
+            pipelineHandles[i] = acquireExisting(keys[i]);
+            if (!pipelineHandles[i].isValid()) {
+                ++registry->misses;
+                registry->pipelines.emplace(keys[i], compiledHandle);
+                registry->entries.emplace(compiledHandle, VulkanGraphicsPipelineRegistry::Entry{ .options = keys[i], .refCount = 1 });
+                pipelineHandles[i] = compiledHandle;
+            }
+            if (pipelineHandles[i] == compiledHandle)
+                compiledHandleUsed[compileIndex] = true;
+        }
+    }
+
+    for (size_t i = 0; i < compiledHandles.size(); ++i) {
+        if (compiledHandles[i].isValid() && !compiledHandleUsed[i])
+            destroyGraphicsPipeline(compiledHandles[i]);
+    }
+
+    return pipelineHandles;
+}
+
+std::vector<Handle<GraphicsPipeline_t>> VulkanResourceManager::compileGraphicsPipelines(const Handle<Device_t> &deviceHandle, std::span<const GraphicsPipelineOptions> options)
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+    std::vector<Handle<GraphicsPipeline_t>> pipelineHandles(options.size());
+
+    // Build all create infos up front so that the driver gets to compile them in a single call
+    std::vector<GraphicsPipelineInfo> pipelineInfos(options.size());
+    std::vector<VkGraphicsPipelineCreateInfo> createInfos;
+    std::vector<size_t> createInfoIndices;
+    createInfos.reserve(options.size());
+    createInfoIndices.reserve(options.size());
+    for (size_t i = 0; i < options.size(); ++i) {
+        if (!fillGraphicsPipelineInfo(deviceHandle, options[i], pipelineInfos[i]))
+            continue;
+        createInfos.push_back(pipelineInfos[i].pipelineInfo);
+        createInfoIndices.push_back(i);
+    }
+
+    if (createInfos.empty())
+        return pipelineHandles;
+
+    // The driver tries to create every pipeline and only leaves the failed ones as VK_NULL_HANDLE
+    std::vector<VkPipeline> vkPipelines(createInfos.size(), VK_NULL_HANDLE);
+    if (auto result = vkCreateGraphicsPipelines(vulkanDevice->device, vulkanDevice->pipelineCache,
+                                                static_cast<uint32_t>(createInfos.size()), createInfos.data(),
+                                                nullptr, vkPipelines.data());
+        result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating graphics pipeline: {}", result);
+    }
+
+    for (size_t i = 0; i < vkPipelines.size(); ++i) {
+        const size_t optionsIndex = createInfoIndices[i];
+        const GraphicsPipelineOptions &pipelineOptions = options[optionsIndex];
+        const GraphicsPipelineInfo &pipelineInfo = pipelineInfos[optionsIndex];
+
+        if (vkPipelines[i] == VK_NULL_HANDLE) {
+            if (pipelineInfo.implicitRenderPassHandle.isValid())
+                deleteRenderPass(pipelineInfo.implicitRenderPassHandle);
+            continue;
+        }
+
+        setObjectName(vulkanDevice, VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(vkPipelines[i]), pipelineOptions.label);
+
+        // Create VulkanPipeline object and return handle
+        pipelineHandles[optionsIndex] = m_graphicsPipelines.emplace(VulkanGraphicsPipeline(
+                vkPipelines[i],
+                this,
+                pipelineInfo.implicitRenderPassHandle, // pipeline do not own the renderpass if it's passed in
+                pipelineInfo.dynamicStates,
+                deviceHandle,
+                pipelineOptions.layout,
+                pipelineOptions.dynamicRendering.enabled));
+    }
+
+    return pipelineHandles;
+}
+
+bool VulkanResourceManager::fillGraphicsPipelineInfo(const Handle<Device_t> &deviceHandle,
+                                                     const GraphicsPipelineOptions &options,
+                                                     GraphicsPipelineInfo &info)
+{
+    [[maybe_unused]] VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
 
     if (options.dynamicRendering.enabled) {
 #if !defined(VK_KHR_dynamic_rendering)
         SPDLOG_LOGGER_ERROR(Logger::logger(), "Dynamic Rendering not supported by this Vulkan SDK");
-        return {};
+        return false;
 #endif
     }
 
@@ -1618,32 +1892,29 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
     VulkanPipelineLayout *vulkanPipelineLayout = getPipelineLayout(options.layout);
     if (!vulkanPipelineLayout) {
         SPDLOG_LOGGER_ERROR(Logger::logger(), "Invalid pipeline layout requested");
-        return {};
+        return false;
     }
 
     // Shader stages
-    ShaderStagesInfo shaderStagesInfo;
-    if (!fillShaderStageInfos(options.shaderStages, shaderStagesInfo)) {
+    if (!fillShaderStageInfos(options.shaderStages, info.shaderStagesInfo)) {
         SPDLOG_LOGGER_ERROR(Logger::logger(), "Failed to build shader stages info for Pipeline");
-        return {};
+        return false;
     }
 
     // Vertex input
     const uint32_t vertexBindingCount = static_cast<uint32_t>(options.vertex.buffers.size());
-    std::vector<VkVertexInputBindingDescription> vertexBindings;
-    vertexBindings.reserve(vertexBindingCount);
+    info.vertexBindings.reserve(vertexBindingCount);
     for (uint32_t i = 0; i < vertexBindingCount; ++i) {
         const auto &binding = options.vertex.buffers.at(i);
         VkVertexInputBindingDescription vkBinding = {};
         vkBinding.binding = binding.binding;
         vkBinding.stride = binding.stride;
         vkBinding.inputRate = vertexRateToVkVertexInputRate(binding.inputRate);
-        vertexBindings.emplace_back(vkBinding);
+        info.vertexBindings.emplace_back(vkBinding);
     }
 
     const uint32_t attributeCount = static_cast<uint32_t>(options.vertex.attributes.size());
-    std::vector<VkVertexInputAttributeDescription> attributes;
-    attributes.reserve(attributeCount);
+    info.attributes.reserve(attributeCount);
     for (uint32_t i = 0; i < attributeCount; ++i) {
         const auto &attribute = options.vertex.attributes.at(i);
         VkVertexInputAttributeDescription vkAttribute = {};
@@ -1651,30 +1922,30 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
         vkAttribute.binding = attribute.binding;
         vkAttribute.format = formatToVkFormat(attribute.format);
         vkAttribute.offset = attribute.offset;
-        attributes.emplace_back(vkAttribute);
+        info.attributes.emplace_back(vkAttribute);
     }
 
-    VkPipelineVertexInputStateCreateInfo vertexInputState = {};
+    VkPipelineVertexInputStateCreateInfo &vertexInputState = info.vertexInputState;
     vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexBindings.size());
-    vertexInputState.pVertexBindingDescriptions = vertexBindings.data();
-    vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
-    vertexInputState.pVertexAttributeDescriptions = attributes.data();
+    vertexInputState.vertexBindingDescriptionCount = static_cast<uint32_t>(info.vertexBindings.size());
+    vertexInputState.pVertexBindingDescriptions = info.vertexBindings.data();
+    vertexInputState.vertexAttributeDescriptionCount = static_cast<uint32_t>(info.attributes.size());
+    vertexInputState.pVertexAttributeDescriptions = info.attributes.data();
 
     // Input assembly
-    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+    VkPipelineInputAssemblyStateCreateInfo &inputAssembly = info.inputAssembly;
     inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
     inputAssembly.topology = primitiveTopologyToVkPrimitiveTopology(options.primitive.topology);
     inputAssembly.primitiveRestartEnable = options.primitive.primitiveRestart;
 
     // Tessellation
-    VkPipelineTessellationStateCreateInfo tessellationStateInfo = {};
+    VkPipelineTessellationStateCreateInfo &tessellationStateInfo = info.tessellationStateInfo;
     tessellationStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO;
     tessellationStateInfo.flags = 0;
     tessellationStateInfo.patchControlPoints = options.primitive.patchControlPoints;
 
     // Rasterizer
-    VkPipelineRasterizationStateCreateInfo rasterizer = {};
+    VkPipelineRasterizationStateCreateInfo &rasterizer = info.rasterizer;
     rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
     rasterizer.depthClampEnable = options.depthStencil.depthClampEnabled;
     rasterizer.rasterizerDiscardEnable = options.primitive.rasterizerDiscardEnabled;
@@ -1688,7 +1959,7 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
     rasterizer.depthBiasSlopeFactor = options.primitive.depthBias.biasSlopeFactor;
 
     // Multisampling
-    VkPipelineMultisampleStateCreateInfo multisampling = {};
+    VkPipelineMultisampleStateCreateInfo &multisampling = info.multisampling;
     multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
     multisampling.sampleShadingEnable = options.multisample.samples > SampleCountFlagBits::Samples1Bit;
     multisampling.rasterizationSamples = sampleCountFlagBitsToVkSampleFlagBits(options.multisample.samples);
@@ -1710,7 +1981,7 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
         return stencilOp;
     };
 
-    VkPipelineDepthStencilStateCreateInfo depthStencil = {};
+    VkPipelineDepthStencilStateCreateInfo &depthStencil = info.depthStencil;
     depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
     depthStencil.depthTestEnable = options.depthStencil.depthTestEnabled;
     depthStencil.depthWriteEnable = options.depthStencil.depthWritesEnabled;
@@ -1724,11 +1995,8 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
 
     // Blending
     const uint32_t attachmentCount = options.renderTargets.size();
-    std::vector<VkPipelineColorBlendAttachmentState> attachmentBlends;
-    attachmentBlends.reserve(attachmentCount);
-
-    std::vector<VkFormat> vkColorFormats;
-    vkColorFormats.reserve(attachmentCount);
+    info.attachmentBlends.reserve(attachmentCount);
+    info.vkColorFormats.reserve(attachmentCount);
 
     for (uint32_t i = 0; i < attachmentCount; ++i) {
         const auto &renderTarget = options.renderTargets.at(i);
@@ -1743,16 +2011,16 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
         vkAttachmentBlend.dstAlphaBlendFactor = blendFactorToVkBlendFactor(renderTarget.blending.alpha.dstFactor);
         vkAttachmentBlend.alphaBlendOp = blendOperationToVkBlendOp(renderTarget.blending.alpha.operation);
 
-        attachmentBlends.emplace_back(vkAttachmentBlend);
-        vkColorFormats.emplace_back(formatToVkFormat(renderTarget.format));
+        info.attachmentBlends.emplace_back(vkAttachmentBlend);
+        info.vkColorFormats.emplace_back(formatToVkFormat(renderTarget.format));
     }
 
-    VkPipelineColorBlendStateCreateInfo colorBlending = {};
+    VkPipelineColorBlendStateCreateInfo &colorBlending = info.colorBlending;
     colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
     colorBlending.logicOpEnable = VK_FALSE;
     colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
-    colorBlending.attachmentCount = static_cast<uint32_t>(attachmentBlends.size());
-    colorBlending.pAttachments = attachmentBlends.data();
+    colorBlending.attachmentCount = static_cast<uint32_t>(info.attachmentBlends.size());
+    colorBlending.pAttachments = info.attachmentBlends.data();
     colorBlending.blendConstants[0] = 0.0f;
     colorBlending.blendConstants[1] = 0.0f;
     colorBlending.blendConstants[2] = 0.0f;
@@ -1762,23 +2030,23 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
     // command buffers with commands such as vkCmdSetViewport or vkCmdSetScissor. We
     // always make the viewport and scissor states dynamic and require clients to
     // set these when recording.
-    std::vector<VkDynamicState> dynamicStates = {
+    info.dynamicStates = {
         VK_DYNAMIC_STATE_VIEWPORT,
         VK_DYNAMIC_STATE_SCISSOR
     };
 
     for (auto dynamicState : options.dynamicState.enabledDynamicStates) {
-        dynamicStates.push_back(dynamicStateToVkDynamicState(dynamicState));
+        info.dynamicStates.push_back(dynamicStateToVkDynamicState(dynamicState));
     }
 
-    VkPipelineDynamicStateCreateInfo dynamicStateInfo{};
+    VkPipelineDynamicStateCreateInfo &dynamicStateInfo = info.dynamicStateInfo;
     dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamicStateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-    dynamicStateInfo.pDynamicStates = dynamicStates.data();
+    dynamicStateInfo.dynamicStateCount = static_cast<uint32_t>(info.dynamicStates.size());
+    dynamicStateInfo.pDynamicStates = info.dynamicStates.data();
     dynamicStateInfo.flags = 0;
 
     // We do still need to specify the number of viewports (and scissor rects) though
-    VkPipelineViewportStateCreateInfo viewportState = {};
+    VkPipelineViewportStateCreateInfo &viewportState = info.viewportState;
     viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     viewportState.viewportCount = 1;
     viewportState.pViewports = nullptr; // Provided by dynamic state
@@ -1787,7 +2055,6 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
 
     // We will use VK_KHR_dynamic_rendering (core in Vulkan 1.3) if options.dynamicRendering is enabled
     // Otherwise we will resolve options.renderPass if provided or create an implicit render pass otherwise
-    VkRenderPass vkRenderPass = VK_NULL_HANDLE;
     Handle<RenderPass_t> vulkanRenderPassHandle = options.renderPass;
 
     if (!vulkanRenderPassHandle.isValid() && !options.dynamicRendering.enabled) {
@@ -1810,15 +2077,16 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
                                                           options.depthStencil,
                                                           options.multisample.samples,
                                                           options.viewCount);
+        info.implicitRenderPassHandle = vulkanRenderPassHandle;
     }
 
     // Bring it all together in the all-knowing pipeline create info
-    VkGraphicsPipelineCreateInfo pipelineInfo = {};
+    VkGraphicsPipelineCreateInfo &pipelineInfo = info.pipelineInfo;
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineInfo.basePipelineIndex = -1;
-    pipelineInfo.stageCount = static_cast<uint32_t>(shaderStagesInfo.shaderInfos.size());
-    pipelineInfo.pStages = shaderStagesInfo.shaderInfos.data();
+    pipelineInfo.stageCount = static_cast<uint32_t>(info.shaderStagesInfo.shaderInfos.size());
+    pipelineInfo.pStages = info.shaderStagesInfo.shaderInfos.data();
     pipelineInfo.pVertexInputState = &vertexInputState;
     pipelineInfo.pInputAssemblyState = &inputAssembly;
     pipelineInfo.pTessellationState = &tessellationStateInfo;
@@ -1829,6 +2097,10 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
     pipelineInfo.pColorBlendState = &colorBlending;
     pipelineInfo.pDynamicState = &dynamicStateInfo;
     pipelineInfo.layout = vulkanPipelineLayout->pipelineLayout;
+#if defined(VK_EXT_descriptor_buffer)
+    if (vulkanPipelineLayout->usesDescriptorBuffers)
+        pipelineInfo.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+#endif
 
     VkBaseOutStructure *chainCurrent = reinterpret_cast<VkBaseOutStructure *>(&pipelineInfo);
     auto addToChain = [&chainCurrent](auto *next) {
@@ -1838,18 +2110,10 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
     };
 
 #if defined(VK_KHR_dynamic_rendering)
-    VkPipelineRenderingCreateInfoKHR pipelineDynamicRenderingCreateInfo{};
-    VkRenderingInputAttachmentIndexInfoKHR inputAttachmentLocations{};
-    VkRenderingAttachmentLocationInfoKHR outputAttachmentLocations{};
-
-    std::vector<uint32_t> outputLocations;
-    std::vector<uint32_t> inputColorLocations;
-    uint32_t inputDepthLocation{ VK_ATTACHMENT_UNUSED };
-    uint32_t inputStencilLocation{ VK_ATTACHMENT_UNUSED };
-
     if (options.dynamicRendering.enabled) {
         assert(!vulkanRenderPassHandle.isValid()); // Dynamic Rendering is not compatible with explicit RenderPasses
         assert(vulkanDevice->requestedFeatures.dynamicRendering); // Dynamic Rendering feature should be enabled
+        VkPipelineRenderingCreateInfoKHR &pipelineDynamicRenderingCreateInfo = info.pipelineDynamicRenderingCreateInfo;
         pipelineDynamicRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
         pipelineDynamicRenderingCreateInfo.pNext = VK_NULL_HANDLE;
 
@@ -1857,39 +2121,41 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
         pipelineDynamicRenderingCreateInfo.viewMask = (options.viewCount > 1) ? multiViewMaskMask : 0;
 
         pipelineDynamicRenderingCreateInfo.colorAttachmentCount = attachmentCount;
-        pipelineDynamicRenderingCreateInfo.pColorAttachmentFormats = vkColorFormats.data();
+        pipelineDynamicRenderingCreateInfo.pColorAttachmentFormats = info.vkColorFormats.data();
         pipelineDynamicRenderingCreateInfo.depthAttachmentFormat = formatToVkFormat(options.depthStencil.format);
         pipelineDynamicRenderingCreateInfo.stencilAttachmentFormat = hasStencilFormat(options.depthStencil.format) ? formatToVkFormat(options.depthStencil.format) : VK_FORMAT_UNDEFINED;
         addToChain(&pipelineDynamicRenderingCreateInfo);
 
+        VkRenderingInputAttachmentIndexInfoKHR &inputAttachmentLocations = info.inputAttachmentLocations;
+        VkRenderingAttachmentLocationInfoKHR &outputAttachmentLocations = info.outputAttachmentLocations;
         inputAttachmentLocations.sType = VK_STRUCTURE_TYPE_RENDERING_INPUT_ATTACHMENT_INDEX_INFO_KHR;
         outputAttachmentLocations.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_LOCATION_INFO_KHR;
 
         // Input Attachments Locations
         if (options.dynamicRendering.dynamicInputLocations) {
-            inputDepthLocation = (options.dynamicRendering.dynamicInputLocations->inputDepthAttachment.enabled) ? options.dynamicRendering.dynamicInputLocations->inputDepthAttachment.remappedIndex : VK_ATTACHMENT_UNUSED;
-            inputStencilLocation = (options.dynamicRendering.dynamicInputLocations->inputStencilAttachment.enabled) ? options.dynamicRendering.dynamicInputLocations->inputStencilAttachment.remappedIndex : VK_ATTACHMENT_UNUSED;
+            info.inputDepthLocation = (options.dynamicRendering.dynamicInputLocations->inputDepthAttachment.enabled) ? options.dynamicRendering.dynamicInputLocations->inputDepthAttachment.remappedIndex : VK_ATTACHMENT_UNUSED;
+            info.inputStencilLocation = (options.dynamicRendering.dynamicInputLocations->inputStencilAttachment.enabled) ? options.dynamicRendering.dynamicInputLocations->inputStencilAttachment.remappedIndex : VK_ATTACHMENT_UNUSED;
 
-            inputAttachmentLocations.pDepthInputAttachmentIndex = (options.dynamicRendering.dynamicInputLocations->inputDepthAttachment.enabled) ? &inputDepthLocation : nullptr;
-            inputAttachmentLocations.pStencilInputAttachmentIndex = (options.dynamicRendering.dynamicInputLocations->inputStencilAttachment.enabled) ? &inputStencilLocation : nullptr;
+            inputAttachmentLocations.pDepthInputAttachmentIndex = (options.dynamicRendering.dynamicInputLocations->inputDepthAttachment.enabled) ? &info.inputDepthLocation : nullptr;
+            inputAttachmentLocations.pStencilInputAttachmentIndex = (options.dynamicRendering.dynamicInputLocations->inputStencilAttachment.enabled) ? &info.inputStencilLocation : nullptr;
 
-            inputColorLocations.reserve(options.dynamicRendering.dynamicInputLocations->inputColorAttachments.size());
+            info.inputColorLocations.reserve(options.dynamicRendering.dynamicInputLocations->inputColorAttachments.size());
             for (const DynamicAttachmentMapping &mapping : options.dynamicRendering.dynamicInputLocations->inputColorAttachments) {
-                inputColorLocations.push_back(mapping.enabled ? mapping.remappedIndex : VK_ATTACHMENT_UNUSED);
+                info.inputColorLocations.push_back(mapping.enabled ? mapping.remappedIndex : VK_ATTACHMENT_UNUSED);
             }
-            inputAttachmentLocations.colorAttachmentCount = inputColorLocations.size();
-            inputAttachmentLocations.pColorAttachmentInputIndices = inputColorLocations.data();
+            inputAttachmentLocations.colorAttachmentCount = info.inputColorLocations.size();
+            inputAttachmentLocations.pColorAttachmentInputIndices = info.inputColorLocations.data();
             addToChain(&inputAttachmentLocations);
         }
 
         // Output Attachments Locations
         if (options.dynamicRendering.dynamicOutputLocations) {
-            outputLocations.reserve(options.dynamicRendering.dynamicOutputLocations->outputAttachments.size());
+            info.outputLocations.reserve(options.dynamicRendering.dynamicOutputLocations->outputAttachments.size());
             for (const DynamicAttachmentMapping &mapping : options.dynamicRendering.dynamicOutputLocations->outputAttachments) {
-                outputLocations.push_back(mapping.enabled ? mapping.remappedIndex : VK_ATTACHMENT_UNUSED);
+                info.outputLocations.push_back(mapping.enabled ? mapping.remappedIndex : VK_ATTACHMENT_UNUSED);
             }
-            outputAttachmentLocations.colorAttachmentCount = outputLocations.size();
-            outputAttachmentLocations.pColorAttachmentLocations = outputLocations.data();
+            outputAttachmentLocations.colorAttachmentCount = info.outputLocations.size();
+            outputAttachmentLocations.pColorAttachmentLocations = info.outputLocations.data();
             addToChain(&outputAttachmentLocations);
         }
     } else
@@ -1898,33 +2164,33 @@ Handle<GraphicsPipeline_t> VulkanResourceManager::createGraphicsPipeline(const H
         // Note: at the moment this render pass isn't shared. It might make sense to do so at some point,
         // in which case, the renderPass handle will have to be added to vulkanDevice->renderPasses
         VulkanRenderPass *vulkanRenderPass = m_renderPasses.get(vulkanRenderPassHandle);
-        vkRenderPass = vulkanRenderPass->renderPass;
-        pipelineInfo.renderPass = vkRenderPass;
+        pipelineInfo.renderPass = vulkanRenderPass->renderPass;
         pipelineInfo.subpass = options.subpassIndex;
     }
 
-    VkPipeline vkPipeline{ VK_NULL_HANDLE };
-    if (auto result = vkCreateGraphicsPipelines(vulkanDevice->device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &vkPipeline); result != VK_SUCCESS) {
-        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating graphics pipeline: {}", result);
-        return {};
-    }
+    return true;
+}
 
-    setObjectName(vulkanDevice, VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(vkPipeline), options.label);
+void VulkanResourceManager::deleteGraphicsPipeline(const Handle<GraphicsPipeline_t> &handle)
+{
+    VulkanGraphicsPipeline *vulkanPipeline = m_graphicsPipelines.get(handle);
+    VulkanDevice *vulkanDevice = m_devices.get(vulkanPipeline->deviceHandle);
 
-    // Create VulkanPipeline object and return handle
-    const auto vulkanGraphicsPipelineHandle = m_graphicsPipelines.emplace(VulkanGraphicsPipeline(
-            vkPipeline,
-            this,
-            (options.renderPass.isValid() ? (Handle<KDGpu::RenderPass_t>()) : (vulkanRenderPassHandle)), // pipeline do not own the renderpass if it's passed in
-            dynamicStates,
-            deviceHandle,
-            options.layout,
-            options.dynamicRendering.enabled));
+    if (VulkanGraphicsPipelineRegistry *registry = vulkanDevice->graphicsPipelineRegistry.get()) {
+        std::lock_guard lock(registry->mutex);
+        if (auto it = registry->entries.find(handle); it != registry->entries.end()) {
+            // Only destroy the pipeline once the last GraphicsPipeline sharing it is released
+            if (--it->second.refCount > 0)
+                return;
+            registry->pipelines.erase(it->second.options);
+            registry->entries.erase(it);
+        }
+    }
 
-    return vulkanGraphicsPipelineHandle;
+    destroyGraphicsPipeline(handle);
 }
 
-void VulkanResourceManager::deleteGraphicsPipeline(const Handle<GraphicsPipeline_t> &handle)
+void VulkanResourceManager::destroyGraphicsPipeline(const Handle<GraphicsPipeline_t> &handle)
 {
     VulkanGraphicsPipeline *vulkanPipeline = m_graphicsPipelines.get(handle);
     VulkanDevice *vulkanDevice = m_devices.get(vulkanPipeline->deviceHandle);
@@ -1947,15 +2213,81 @@ VulkanGraphicsPipeline *VulkanResourceManager::getGraphicsPipeline(const Handle<
     return m_graphicsPipelines.get(handle);
 }
 
+CacheStatistics VulkanResourceManager::graphicsPipelineRegistryStatistics(const Handle<Device_t> &deviceHandle) const
+{
+    VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+    VulkanGraphicsPipelineRegistry *registry = vulkanDevice->graphicsPipelineRegistry.get();
+    if (!registry)
+        return {};
+
+    std::lock_guard lock(registry->mutex);
+    return CacheStatistics{
+        .hits = registry->hits,
+        .misses = registry->misses,
+        .entryCount = static_cast<uint32_t>(registry->entries.size()),
+    };
+}
+
 Handle<ComputePipeline_t> VulkanResourceManager::createComputePipeline(const Handle<Device_t> &deviceHandle, const ComputePipelineOptions &options)
+{
+    return createComputePipelines(deviceHandle, std::span(&options, 1)).front();
+}
+
+std::vector<Handle<ComputePipeline_t>> VulkanResourceManager::createComputePipelines(const Handle<Device_t> &deviceHandle, std::span<const ComputePipelineOptions> options)
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+    std::vector<Handle<ComputePipeline_t>> pipelineHandles(options.size());
+
+    // Build all create infos up front so that the driver gets to compile them in a single call
+    std::vector<ComputePipelineInfo> pipelineInfos(options.size());
+    std::vector<VkComputePipelineCreateInfo> createInfos;
+    std::vector<size_t> createInfoIndices;
+    createInfos.reserve(options.size());
+    createInfoIndices.reserve(options.size());
+    for (size_t i = 0; i < options.size(); ++i) {
+        if (!fillComputePipelineInfo(options[i], pipelineInfos[i]))
+            continue;
+        createInfos.push_back(pipelineInfos[i].pipelineInfo);
+        createInfoIndices.push_back(i);
+    }
+
+    if (createInfos.empty())
+        return pipelineHandles;
+
+    std::vector<VkPipeline> vkPipelines(createInfos.size(), VK_NULL_HANDLE);
+    if (auto result = vkCreateComputePipelines(vulkanDevice->device, vulkanDevice->pipelineCache,
+                                               static_cast<uint32_t>(createInfos.size()), createInfos.data(),
+                                               nullptr, vkPipelines.data());
+        result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating compute pipeline: {}", result);
+    }
 
+    for (size_t i = 0; i < vkPipelines.size(); ++i) {
+        if (vkPipelines[i] == VK_NULL_HANDLE)
+            continue;
+
+        const size_t optionsIndex = createInfoIndices[i];
+        setObjectName(vulkanDevice, VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(vkPipelines[i]), options[optionsIndex].label);
+
+        // Create VulkanPipeline object and return handle
+        pipelineHandles[optionsIndex] = m_computePipelines.emplace(VulkanComputePipeline(
+                vkPipelines[i],
+                this,
+                deviceHandle,
+                options[optionsIndex].layout));
+    }
+
+    return pipelineHandles;
+}
+
+bool VulkanResourceManager::fillComputePipelineInfo(const ComputePipelineOptions &options,
+                                                    ComputePipelineInfo &info) const
+{
     // Fetch the specified pipeline layout
     VulkanPipelineLayout *vulkanPipelineLayout = getPipelineLayout(options.layout);
     if (!vulkanPipelineLayout) {
         SPDLOG_LOGGER_ERROR(Logger::logger(), "Invalid pipeline layout requested");
-        return {};
+        return false;
     }
 
     // Shader stages
@@ -1963,27 +2295,23 @@ Handle<ComputePipeline_t> VulkanResourceManager::createComputePipeline(const Han
     computeShaderInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     computeShaderInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
 
-    VkSpecializationInfo shaderSpecializationInfo;
-    std::vector<VkSpecializationMapEntry> shaderSpecializationMapEntries;
-    std::vector<uint8_t> shaderSpecializationRawData;
-
     // Lookup the shader module
     const auto *vulkanShaderModule = getShaderModule(options.shaderStage.shaderModule);
     if (!vulkanShaderModule)
-        return {};
+        return false;
     computeShaderInfo.module = vulkanShaderModule->shaderModule;
     computeShaderInfo.pName = options.shaderStage.entryPoint.data();
 
     if (!options.shaderStage.specializationConstants.empty()) {
         uint32_t byteOffset = 0;
         const size_t specializationConstantsCount = options.shaderStage.specializationConstants.size();
-        shaderSpecializationMapEntries.reserve(specializationConstantsCount);
+        info.shaderSpecializationMapEntries.reserve(specializationConstantsCount);
 
         for (size_t sCI = 0; sCI < specializationConstantsCount; ++sCI) {
             const SpecializationConstant &specializationConstant = options.shaderStage.specializationConstants[sCI];
             const SpecializationConstantData &specializationConstantData = getByteOffsetSizeAndRawValueForSpecializationConstant(specializationConstant);
 
-            shaderSpecializationMapEntries.emplace_back(VkSpecializationMapEntry{
+            info.shaderSpecializationMapEntries.emplace_back(VkSpecializationMapEntry{
                     .constantID = specializationConstant.constantId,
                     .offset = byteOffset,
                     .size = specializationConstantData.byteSize,
@@ -1991,42 +2319,31 @@ Handle<ComputePipeline_t> VulkanResourceManager::createComputePipeline(const Han
 
             // Append Raw Byte Values
             const std::vector<uint8_t> &rawData = specializationConstantData.byteValues;
-            shaderSpecializationRawData.insert(shaderSpecializationRawData.end(), rawData.begin(), rawData.end());
+            info.shaderSpecializationRawData.insert(info.shaderSpecializationRawData.end(), rawData.begin(), rawData.end());
 
             // Increase offset
             byteOffset += specializationConstantData.byteSize;
         }
 
-        shaderSpecializationInfo.mapEntryCount = specializationConstantsCount;
-        shaderSpecializationInfo.pMapEntries = shaderSpecializationMapEntries.data();
-        shaderSpecializationInfo.dataSize = shaderSpecializationRawData.size();
-        shaderSpecializationInfo.pData = shaderSpecializationRawData.data();
-        computeShaderInfo.pSpecializationInfo = &shaderSpecializationInfo;
+        info.shaderSpecializationInfo.mapEntryCount = specializationConstantsCount;
+        info.shaderSpecializationInfo.pMapEntries = info.shaderSpecializationMapEntries.data();
+        info.shaderSpecializationInfo.dataSize = info.shaderSpecializationRawData.size();
+        info.shaderSpecializationInfo.pData = info.shaderSpecializationRawData.data();
+        computeShaderInfo.pSpecializationInfo = &info.shaderSpecializationInfo;
     }
 
-    VkComputePipelineCreateInfo pipelineInfo = {};
+    VkComputePipelineCreateInfo &pipelineInfo = info.pipelineInfo;
     pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
     pipelineInfo.stage = computeShaderInfo;
     pipelineInfo.layout = vulkanPipelineLayout->pipelineLayout;
+#if defined(VK_EXT_descriptor_buffer)
+    if (vulkanPipelineLayout->usesDescriptorBuffers)
+        pipelineInfo.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+#endif
 
-    VkPipeline vkPipeline{ VK_NULL_HANDLE };
-
-    if (auto result = vkCreateComputePipelines(vulkanDevice->device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &vkPipeline); result != VK_SUCCESS) {
-        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating compute pipeline: {}", result);
-        return {};
-    }
-
-    setObjectName(vulkanDevice, VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(vkPipeline), options.label);
-
-    // Create VulkanPipeline object and return handle
-    const auto vulkanComputePipelineHandle = m_computePipelines.emplace(VulkanComputePipeline(
-            vkPipeline,
-            this,
-            deviceHandle,
-            options.layout));
-
-    return vulkanComputePipelineHandle;
+    return true;
 }
+
 void VulkanResourceManager::deleteComputePipeline(const Handle<ComputePipeline_t> &handle)
 {
     VulkanComputePipeline *vulkanPipeline = m_computePipelines.get(handle);
@@ -2045,26 +2362,83 @@ VulkanComputePipeline *VulkanResourceManager::getComputePipeline(const Handle<Co
 Handle<RayTracingPipeline_t> VulkanResourceManager::createRayTracingPipeline(const Handle<Device_t> &deviceHandle,
                                                                              const RayTracingPipelineOptions &options)
 {
+    return createRayTracingPipelines(deviceHandle, std::span(&options, 1)).front();
+}
+
+std::vector<Handle<RayTracingPipeline_t>> VulkanResourceManager::createRayTracingPipelines(const Handle<Device_t> &deviceHandle,
+                                                                                           std::span<const RayTracingPipelineOptions> options)
+{
+    std::vector<Handle<RayTracingPipeline_t>> pipelineHandles(options.size());
+#if defined(VK_KHR_ray_tracing_pipeline)
+    VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+
+    // Build all create infos up front so that the driver gets to compile them in a single call
+    std::vector<RayTracingPipelineInfo> pipelineInfos(options.size());
+    std::vector<VkRayTracingPipelineCreateInfoKHR> createInfos;
+    std::vector<size_t> createInfoIndices;
+    createInfos.reserve(options.size());
+    createInfoIndices.reserve(options.size());
+    for (size_t i = 0; i < options.size(); ++i) {
+        if (!fillRayTracingPipelineInfo(deviceHandle, options[i], pipelineInfos[i]))
+            continue;
+        createInfos.push_back(pipelineInfos[i].pipelineInfo);
+        createInfoIndices.push_back(i);
+    }
+
+    if (createInfos.empty())
+        return pipelineHandles;
+
+    std::vector<VkPipeline> vkPipelines(createInfos.size(), VK_NULL_HANDLE);
+    assert(vulkanDevice->vkCreateRayTracingPipelinesKHR != nullptr);
+    if (auto result = vulkanDevice->vkCreateRayTracingPipelinesKHR(vulkanDevice->device, VK_NULL_HANDLE, vulkanDevice->pipelineCache,
+                                                                   static_cast<uint32_t>(createInfos.size()), createInfos.data(),
+                                                                   nullptr, vkPipelines.data());
+        result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating raytracing pipeline: {}", result);
+    }
+
+    for (size_t i = 0; i < vkPipelines.size(); ++i) {
+        if (vkPipelines[i] == VK_NULL_HANDLE)
+            continue;
+
+        const size_t optionsIndex = createInfoIndices[i];
+        setObjectName(vulkanDevice, VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(vkPipelines[i]), options[optionsIndex].label);
+
+        // Create VulkanPipeline object and return handle
+        pipelineHandles[optionsIndex] = m_rayTracingPipelines.emplace(VulkanRayTracingPipeline(
+                vkPipelines[i],
+                this,
+                deviceHandle,
+                options[optionsIndex].layout));
+    }
+#else
+    assert(false);
+#endif
+    return pipelineHandles;
+}
+
 #if defined(VK_KHR_ray_tracing_pipeline)
+bool VulkanResourceManager::fillRayTracingPipelineInfo(const Handle<Device_t> &deviceHandle,
+                                                       const RayTracingPipelineOptions &options,
+                                                       RayTracingPipelineInfo &info) const
+{
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
 
     // Fetch the specified pipeline layout
     VulkanPipelineLayout *vulkanPipelineLayout = getPipelineLayout(options.layout);
     if (!vulkanPipelineLayout) {
         SPDLOG_LOGGER_ERROR(Logger::logger(), "Invalid pipeline layout requested");
-        return {};
+        return false;
     }
 
     // Shader stages
-    ShaderStagesInfo shaderStagesInfo;
-    if (!fillShaderStageInfos(options.shaderStages, shaderStagesInfo)) {
+    if (!fillShaderStageInfos(options.shaderStages, info.shaderStagesInfo)) {
         SPDLOG_LOGGER_ERROR(Logger::logger(), "Failed to build shader stages info for Pipeline");
-        return {};
+        return false;
     }
 
     // Shader groups
-    std::vector<VkRayTracingShaderGroupCreateInfoKHR> shaderGroupsInfo;
-    shaderGroupsInfo.reserve(options.shaderGroups.size());
+    info.shaderGroupsInfo.reserve(options.shaderGroups.size());
 
     for (const RayTracingShaderGroupOptions &group : options.shaderGroups) {
         VkRayTracingShaderGroupCreateInfoKHR groupInfo{};
@@ -2093,18 +2467,18 @@ Handle<RayTracingPipeline_t> VulkanResourceManager::createRayTracingPipeline(con
         };
         }
 
-        shaderGroupsInfo.emplace_back(groupInfo);
+        info.shaderGroupsInfo.emplace_back(groupInfo);
     };
 
     // Dynamic pipeline state.
-    std::vector<VkDynamicState> dynamicStates = {
+    info.dynamicStates = {
         // VK_DYNAMIC_STATE_RAY_TRACING_PIPELINE_STACK_SIZE_KHR
     };
 
-    VkPipelineDynamicStateCreateInfo dynamicStateInfo{};
+    VkPipelineDynamicStateCreateInfo &dynamicStateInfo = info.dynamicStateInfo;
     dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    dynamicStateInfo.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-    dynamicStateInfo.pDynamicStates = dynamicStates.data();
+    dynamicStateInfo.dynamicStateCount = static_cast<uint32_t>(info.dynamicStates.size());
+    dynamicStateInfo.pDynamicStates = info.dynamicStates.data();
     dynamicStateInfo.flags = 0;
 
     // MaxRecursionDepth
@@ -2114,39 +2488,23 @@ Handle<RayTracingPipeline_t> VulkanResourceManager::createRayTracingPipeline(con
         maxRecursionDepth = vulkanAdapter->queryAdapterProperties().rayTracingProperties.maxRayRecursionDepth;
     }
 
-    VkRayTracingPipelineCreateInfoKHR pipelineInfo = {};
+    VkRayTracingPipelineCreateInfoKHR &pipelineInfo = info.pipelineInfo;
     pipelineInfo.sType = VK_STRUCTURE_TYPE_RAY_TRACING_PIPELINE_CREATE_INFO_KHR;
-    pipelineInfo.stageCount = static_cast<uint32_t>(shaderStagesInfo.shaderInfos.size());
-    pipelineInfo.pStages = shaderStagesInfo.shaderInfos.data();
-    pipelineInfo.groupCount = static_cast<uint32_t>(shaderGroupsInfo.size());
-    pipelineInfo.pGroups = shaderGroupsInfo.data();
+    pipelineInfo.stageCount = static_cast<uint32_t>(info.shaderStagesInfo.shaderInfos.size());
+    pipelineInfo.pStages = info.shaderStagesInfo.shaderInfos.data();
+    pipelineInfo.groupCount = static_cast<uint32_t>(info.shaderGroupsInfo.size());
+    pipelineInfo.pGroups = info.shaderGroupsInfo.data();
     pipelineInfo.maxPipelineRayRecursionDepth = maxRecursionDepth;
     pipelineInfo.pDynamicState = &dynamicStateInfo;
     pipelineInfo.layout = vulkanPipelineLayout->pipelineLayout;
-
-    VkPipeline vkPipeline{ VK_NULL_HANDLE };
-
-    assert(vulkanDevice->vkCreateRayTracingPipelinesKHR != nullptr);
-    if (auto result = vulkanDevice->vkCreateRayTracingPipelinesKHR(vulkanDevice->device, VK_NULL_HANDLE, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &vkPipeline); result != VK_SUCCESS) {
-        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating raytracing pipeline: {}", result);
-        return {};
-    }
-
-    setObjectName(vulkanDevice, VK_OBJECT_TYPE_PIPELINE, reinterpret_cast<uint64_t>(vkPipeline), options.label);
-
-    // Create VulkanPipeline object and return handle
-    const auto vulkanRayTracingPipelineHandle = m_rayTracingPipelines.emplace(VulkanRayTracingPipeline(
-            vkPipeline,
-            this,
-            deviceHandle,
-            options.layout));
-
-    return vulkanRayTracingPipelineHandle;
-#else
-    assert(false);
-    return {};
+#if defined(VK_EXT_descriptor_buffer)
+    if (vulkanPipelineLayout->usesDescriptorBuffers)
+        pipelineInfo.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
 #endif
+
+    return true;
 }
+#endif
 
 void VulkanResourceManager::deleteRayTracingPipeline(const Handle<RayTracingPipeline_t> &handle)
 {
@@ -2244,62 +2602,70 @@ VulkanGpuSemaphore *VulkanResourceManager::getGpuSemaphore(const Handle<GpuSemap
     return m_gpuSemaphores.get(handle);
 }
 
+const QueueDescription *VulkanResourceManager::findQueueDescription(const VulkanDevice *vulkanDevice, const Handle<Queue_t> &queue) const
+{
+    if (!queue.isValid()) {
+        if (vulkanDevice->queueDescriptions.empty()) {
+            SPDLOG_LOGGER_ERROR(Logger::logger(), "No more queue descriptors available for device");
+            return nullptr;
+        }
+        return vulkanDevice->queueDescriptions.data();
+    }
+
+    // Look for this queue on the device
+    const auto it = std::find_if(
+            vulkanDevice->queueDescriptions.begin(),
+            vulkanDevice->queueDescriptions.end(),
+            [queue](const QueueDescription &queueDescription) { return queueDescription.queue == queue; });
+    if (it == vulkanDevice->queueDescriptions.end()) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Cannot find requested queue for device");
+        return nullptr;
+    }
+    return &(*it);
+}
+
 Handle<CommandRecorder_t> VulkanResourceManager::createCommandRecorder(const Handle<Device_t> &deviceHandle, const CommandRecorderOptions &options)
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
 
-    // Which queue is the command recorder requested for?
+    VulkanCommandPool *commandPool = nullptr;
+    Handle<CommandBuffer_t> commandBufferHandle;
 
-    QueueDescription *queueDescription = nullptr;
-
-    if (!options.queue.isValid()) {
-        if (vulkanDevice->queueDescriptions.empty()) {
-            SPDLOG_LOGGER_ERROR(Logger::logger(), "No more queue descriptors available for device");
+    if (options.commandPool.isValid()) {
+        // Recycle a command buffer from the explicitly requested pool
+        commandPool = m_commandPools.get(options.commandPool);
+        if (!commandPool) {
+            SPDLOG_LOGGER_ERROR(Logger::logger(), "Cannot find requested command pool for device");
             return {};
         }
-        queueDescription = vulkanDevice->queueDescriptions.data();
+        commandBufferHandle = recycleCommandBuffer(commandPool, options.level);
     } else {
-        // Look for this queue on the device
-        const auto it = std::find_if(
-                vulkanDevice->queueDescriptions.begin(),
-                vulkanDevice->queueDescriptions.end(),
-                [options](const QueueDescription &queueDescription) { return queueDescription.queue == options.queue; });
-        if (it == vulkanDevice->queueDescriptions.end()) {
-            SPDLOG_LOGGER_ERROR(Logger::logger(), "Cannot find requested queue for device");
+        // Which queue is the command recorder requested for?
+        const QueueDescription *queueDescription = findQueueDescription(vulkanDevice, options.queue);
+        if (!queueDescription)
             return {};
-        }
-        queueDescription = &(*it);
-    }
 
-    Handle<Queue_t> queueHandle = queueDescription->queue;
-    const uint32_t queueTypeIndex = queueDescription->queueTypeIndex;
-    assert(queueHandle.isValid());
-    assert(queueTypeIndex != std::numeric_limits<uint32_t>::max());
+        Handle<Queue_t> queueHandle = queueDescription->queue;
+        const uint32_t queueTypeIndex = queueDescription->queueTypeIndex;
+        assert(queueHandle.isValid());
+        assert(queueTypeIndex != std::numeric_limits<uint32_t>::max());
 
-    // Find or create a command pool for this combination of thread and queue family
-    if (vulkanDevice->commandPools[queueTypeIndex] == VK_NULL_HANDLE) {
-        // No command pool exists yet for this queue family, let's create one why not!
-        VkCommandPoolCreateInfo poolInfo = {};
-        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-        poolInfo.queueFamilyIndex = queueTypeIndex;
-
-        VkCommandPool vkCommandPool = VK_NULL_HANDLE;
-        if (auto result = vkCreateCommandPool(vulkanDevice->device, &poolInfo, nullptr, &vkCommandPool); result != VK_SUCCESS) {
-            SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating command pool for queue family {}: {}", queueTypeIndex, result);
+        // Find or create a command pool for this combination of thread and queue family
+        commandPool = vulkanDevice->commandPoolForCurrentThread(queueTypeIndex);
+        if (!commandPool)
             return {};
-        }
-        vulkanDevice->commandPools[queueTypeIndex] = vkCommandPool;
-    }
 
-    // Create the Command Buffer
-    VkCommandPool vkCommandPool = vulkanDevice->commandPools[queueTypeIndex];
-    const Handle<CommandBuffer_t> commandBufferHandle = createCommandBuffer(deviceHandle,
-                                                                            *queueDescription,
-                                                                            options.level);
+        // Create the Command Buffer
+        commandBufferHandle = createCommandBuffer(deviceHandle,
+                                                  *queueDescription,
+                                                  options.level);
+    }
+    if (!commandBufferHandle.isValid())
+        return {};
 
     // Finally, we can create the command recorder object
     const auto vulkanCommandRecorderHandle = m_commandRecorders.emplace(VulkanCommandRecorder(
-            vkCommandPool,
+            commandPool->commandPool,
             commandBufferHandle,
             this,
             deviceHandle));
@@ -2324,12 +2690,17 @@ Handle<CommandBuffer_t> VulkanResourceManager::createCommandBuffer(const Handle<
                                                                    CommandBufferLevel commandLevel)
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
-    VkCommandPool vkCommandPool = vulkanDevice->commandPools[queueDescription.queueTypeIndex];
+    VulkanCommandPool *commandPool = vulkanDevice->commandPoolForCurrentThread(queueDescription.queueTypeIndex);
+    if (!commandPool)
+        return {};
+
+    // Return command buffers other threads have released before growing the pool
+    commandPool->releasePendingCommandBuffers(vulkanDevice->device);
 
     // Allocate a command buffer object from the pool
     VkCommandBufferAllocateInfo allocInfo = {};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = vkCommandPool;
+    allocInfo.commandPool = commandPool->commandPool;
     allocInfo.level = commandBufferLevelToVkCommandBufferLevel(commandLevel);
     allocInfo.commandBufferCount = 1U;
 
@@ -2339,8 +2710,9 @@ Handle<CommandBuffer_t> VulkanResourceManager::createCommandBuffer(const Handle<
         return {};
     }
 
+    commandPool->registerCommandBuffer();
     const auto vulkanCommandBufferHandle = m_commandBuffers.emplace(VulkanCommandBuffer(vkCommandBuffer,
-                                                                                        vkCommandPool,
+                                                                                        commandPool,
                                                                                         allocInfo.level,
                                                                                         this,
                                                                                         deviceHandle));
@@ -2348,6 +2720,37 @@ Handle<CommandBuffer_t> VulkanResourceManager::createCommandBuffer(const Handle<
     return vulkanCommandBufferHandle;
 }
 
+Handle<CommandBuffer_t> VulkanResourceManager::recycleCommandBuffer(VulkanCommandPool *commandPool, CommandBufferLevel commandLevel)
+{
+    VulkanDevice *vulkanDevice = m_devices.get(commandPool->deviceHandle);
+    const VkCommandBufferLevel vkCommandLevel = commandBufferLevelToVkCommandBufferLevel(commandLevel);
+
+    // Hand out a command buffer that was reset with the pool if we have one
+    VulkanCommandPool::RecycledCommandBuffers &recycled = commandPool->recycledCommandBuffers(vkCommandLevel);
+    if (recycled.usedCount == recycled.commandBuffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = commandPool->commandPool;
+        allocInfo.level = vkCommandLevel;
+        allocInfo.commandBufferCount = 1U;
+
+        VkCommandBuffer vkCommandBuffer{ VK_NULL_HANDLE };
+        if (auto result = vkAllocateCommandBuffers(vulkanDevice->device, &allocInfo, &vkCommandBuffer); result != VK_SUCCESS) {
+            SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating allocating command buffers: {}", result);
+            return {};
+        }
+        recycled.commandBuffers.push_back(vkCommandBuffer);
+    }
+    VkCommandBuffer vkCommandBuffer = recycled.commandBuffers[recycled.usedCount++];
+
+    // The VkCommandBuffer remains owned by the pool
+    return m_commandBuffers.emplace(VulkanCommandBuffer(vkCommandBuffer,
+                                                        nullptr,
+                                                        vkCommandLevel,
+                                                        this,
+                                                        commandPool->deviceHandle));
+}
+
 void VulkanResourceManager::deleteCommandBuffer(const Handle<CommandBuffer_t> &handle)
 {
     VulkanCommandBuffer *commandBuffer = m_commandBuffers.get(handle);
@@ -2356,7 +2759,8 @@ void VulkanResourceManager::deleteCommandBuffer(const Handle<CommandBuffer_t> &h
     for (const Handle<Buffer_t> buf : commandBuffer->temporaryBuffersToRelease)
         deleteBuffer(buf);
 
-    vkFreeCommandBuffers(vulkanDevice->device, commandBuffer->commandPool, 1, &commandBuffer->commandBuffer);
+    if (commandBuffer->commandPool)
+        commandBuffer->commandPool->freeCommandBuffer(vulkanDevice->device, commandBuffer->commandBuffer);
     m_commandBuffers.remove(handle);
 }
 
@@ -2365,6 +2769,52 @@ VulkanCommandBuffer *VulkanResourceManager::getCommandBuffer(const Handle<Comman
     return m_commandBuffers.get(handle);
 }
 
+Handle<CommandPool_t> VulkanResourceManager::createCommandPool(const Handle<Device_t> &deviceHandle, const CommandPoolOptions &options)
+{
+    VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+
+    const QueueDescription *queueDescription = findQueueDescription(vulkanDevice, options.queue);
+    if (!queueDescription)
+        return {};
+
+    VkCommandPoolCreateInfo poolInfo = {};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.queueFamilyIndex = queueDescription->queueTypeIndex;
+
+    VkCommandPool vkCommandPool = VK_NULL_HANDLE;
+    if (auto result = vkCreateCommandPool(vulkanDevice->device, &poolInfo, nullptr, &vkCommandPool); result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating command pool for queue family {}: {}", queueDescription->queueTypeIndex, result);
+        return {};
+    }
+
+    setObjectName(vulkanDevice, VK_OBJECT_TYPE_COMMAND_POOL, reinterpret_cast<uint64_t>(vkCommandPool), options.label);
+
+    return m_commandPools.emplace(vkCommandPool, queueDescription->queueTypeIndex, deviceHandle);
+}
+
+void VulkanResourceManager::deleteCommandPool(const Handle<CommandPool_t> &handle)
+{
+    VulkanCommandPool *commandPool = m_commandPools.get(handle);
+    VulkanDevice *vulkanDevice = m_devices.get(commandPool->deviceHandle);
+
+    // Also frees all the command buffers that were allocated from it
+    vkDestroyCommandPool(vulkanDevice->device, commandPool->commandPool, nullptr);
+
+    m_commandPools.remove(handle);
+}
+
+VulkanCommandPool *VulkanResourceManager::getCommandPool(const Handle<CommandPool_t> &handle) const
+{
+    return m_commandPools.get(handle);
+}
+
+void VulkanResourceManager::resetCommandPool(const Handle<CommandPool_t> &handle)
+{
+    VulkanCommandPool *commandPool = m_commandPools.get(handle);
+    VulkanDevice *vulkanDevice = m_devices.get(commandPool->deviceHandle);
+    commandPool->reset(vulkanDevice->device);
+}
+
 Handle<BindGroupPool_t> VulkanResourceManager::createBindGroupPool(const Handle<Device_t> &deviceHandle, const BindGroupPoolOptions &options)
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
@@ -2390,6 +2840,9 @@ Handle<BindGroupPool_t> VulkanResourceManager::createBindGroupPool(const Handle<
     if (options.accelerationStructureCount > 0 && vulkanDevice->requestedFeatures.accelerationStructures)
         poolSizes.push_back({ VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, options.accelerationStructureCount });
 
+    if (options.flags.testFlag(BindGroupPoolFlagBits::DescriptorBuffer))
+        return createDescriptorBufferBindGroupPool(vulkanDevice, deviceHandle, options, poolSizes);
+
     VkDescriptorPool pool{ VK_NULL_HANDLE };
     VkDescriptorPoolCreateInfo poolInfo = {};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
@@ -2410,12 +2863,104 @@ Handle<BindGroupPool_t> VulkanResourceManager::createBindGroupPool(const Handle<
     return vulkanBindGroupPoolHandle;
 }
 
+Handle<BindGroupPool_t> VulkanResourceManager::createDescriptorBufferBindGroupPool(VulkanDevice *vulkanDevice,
+                                                                                   const Handle<Device_t> &deviceHandle,
+                                                                                   const BindGroupPoolOptions &options,
+                                                                                   const std::vector<VkDescriptorPoolSize> &poolSizes)
+{
+#if defined(VK_EXT_descriptor_buffer)
+    if (!vulkanDevice->requestedFeatures.descriptorBuffer || vulkanDevice->vkGetDescriptorEXT == nullptr) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "BindGroupPoolFlagBits::DescriptorBuffer requires the descriptorBuffer feature to be enabled on the Device");
+        return {};
+    }
+    if (!vulkanDevice->requestedFeatures.bufferDeviceAddress) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "BindGroupPoolFlagBits::DescriptorBuffer requires the bufferDeviceAddress feature to be enabled on the Device");
+        return {};
+    }
+    if (options.dynamicUniformBufferCount > 0) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Dynamic uniform buffers can't be allocated from a descriptor buffer BindGroupPool");
+        return {};
+    }
+
+    // Size the descriptor buffer from the requested descriptor counts, leaving room to align each BindGroup
+    const VkPhysicalDeviceDescriptorBufferPropertiesEXT &properties = vulkanDevice->descriptorBufferProperties;
+    const auto descriptorSize = [&properties](VkDescriptorType type) -> VkDeviceSize {
+        switch (type) {
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+            return properties.uniformBufferDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+            return properties.storageBufferDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:
+            return properties.combinedImageSamplerDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+            return properties.sampledImageDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+            return properties.samplerDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+            return properties.storageImageDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+            return properties.inputAttachmentDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+            return properties.accelerationStructureDescriptorSize;
+        default:
+            return 0;
+        }
+    };
+
+    VkDeviceSize bufferSize = VkDeviceSize(options.maxBindGroupCount) * properties.descriptorBufferOffsetAlignment;
+    for (const VkDescriptorPoolSize &poolSize : poolSizes)
+        bufferSize += VkDeviceSize(poolSize.descriptorCount) * descriptorSize(poolSize.type);
+
+    VulkanBindGroupPool::DescriptorBuffer descriptorBuffer;
+    descriptorBuffer.size = bufferSize;
+    descriptorBuffer.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    if (options.samplerCount > 0 || options.textureSamplerCount > 0)
+        descriptorBuffer.usage |= VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
+
+    VkBufferCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.size = bufferSize;
+    createInfo.usage = descriptorBuffer.usage;
+    createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    // Descriptors are written from the CPU, keep the buffer persistently mapped
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo allocationInfo;
+    if (auto result = vmaCreateBuffer(vulkanDevice->allocator, &createInfo, &allocInfo, &descriptorBuffer.buffer, &descriptorBuffer.allocation, &allocationInfo); result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating bindgroup pool descriptor buffer: {}", result);
+        return {};
+    }
+    descriptorBuffer.mapped = allocationInfo.pMappedData;
+
+    const VkBufferDeviceAddressInfo addressInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+        .buffer = descriptorBuffer.buffer,
+    };
+    descriptorBuffer.deviceAddress = vkGetBufferDeviceAddress(vulkanDevice->device, &addressInfo);
+
+    setObjectName(vulkanDevice, VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(descriptorBuffer.buffer), options.label);
+
+    VulkanBindGroupPool bindGroupPool(VK_NULL_HANDLE, this, deviceHandle, options.maxBindGroupCount, options.flags);
+    bindGroupPool.descriptorBuffer = descriptorBuffer;
+    return m_bindGroupPools.emplace(std::move(bindGroupPool));
+#else
+    SPDLOG_LOGGER_ERROR(Logger::logger(), "BindGroupPoolFlagBits::DescriptorBuffer is not supported by this build");
+    return {};
+#endif
+}
+
 void VulkanResourceManager::deleteBindGroupPool(const Handle<BindGroupPool_t> &handle)
 {
     VulkanBindGroupPool *bindGroupPool = m_bindGroupPools.get(handle);
     VulkanDevice *vulkanDevice = m_devices.get(bindGroupPool->deviceHandle);
 
-    vkDestroyDescriptorPool(vulkanDevice->device, bindGroupPool->descriptorPool, nullptr);
+    if (bindGroupPool->usesDescriptorBuffer())
+        vmaDestroyBuffer(vulkanDevice->allocator, bindGroupPool->descriptorBuffer.buffer, bindGroupPool->descriptorBuffer.allocation);
+    else
+        vkDestroyDescriptorPool(vulkanDevice->device, bindGroupPool->descriptorPool, nullptr);
 
     // Reset descriptorSet handle of all the bind groups that were created from this pool in case they have no implicit free
     const auto referencedBindGroups = bindGroupPool->bindGroups();
@@ -2424,6 +2969,7 @@ void VulkanResourceManager::deleteBindGroupPool(const Handle<BindGroupPool_t> &h
         if (vulkanBindGroup != nullptr) {
             // If the bind group is still valid, we can delete it
             vulkanBindGroup->descriptorSet = VK_NULL_HANDLE;
+            vulkanBindGroup->descriptorBufferOffset = VulkanBindGroup::InvalidDescriptorBufferOffset;
         }
     }
 
@@ -2443,19 +2989,22 @@ Handle<RenderPassCommandRecorder_t> VulkanResourceManager::createRenderPassComma
 
     // Find or create a render pass object that matches the request
     const VulkanRenderPassKey renderPassKey(options, this);
-    auto itRenderPass = vulkanDevice->renderPasses.find(renderPassKey);
     Handle<RenderPass_t> vulkanRenderPassHandle{};
-
-    if (itRenderPass == vulkanDevice->renderPasses.end()) {
-        // Create the render pass and cache the handle for it
-        vulkanRenderPassHandle = createImplicitRenderPass(deviceHandle,
-                                                          options.colorAttachments,
-                                                          options.depthStencilAttachment,
-                                                          options.samples,
-                                                          options.viewCount);
-        vulkanDevice->renderPasses.insert({ renderPassKey, vulkanRenderPassHandle });
-    } else {
-        vulkanRenderPassHandle = itRenderPass->second;
+    {
+        std::lock_guard renderPassesLock(*vulkanDevice->renderPassesAndFramebuffersMutex);
+        auto itRenderPass = vulkanDevice->renderPasses.find(renderPassKey);
+
+        if (itRenderPass == vulkanDevice->renderPasses.end()) {
+            // Create the render pass and cache the handle for it
+            vulkanRenderPassHandle = createImplicitRenderPass(deviceHandle,
+                                                              options.colorAttachments,
+                                                              options.depthStencilAttachment,
+                                                              options.samples,
+                                                              options.viewCount);
+            vulkanDevice->renderPasses.insert({ renderPassKey, vulkanRenderPassHandle });
+        } else {
+            vulkanRenderPassHandle = itRenderPass->second;
+        }
     }
 
     // Create Attachments from the ColorAttachments and DepthAttachment
@@ -2577,14 +3126,17 @@ Handle<RenderPassCommandRecorder_t> VulkanResourceManager::createRenderPassComma
     if (options.viewCount > 1)
         framebufferKey.layers = 1;
 
-    auto itFramebuffer = vulkanDevice->framebuffers.find(framebufferKey);
     Handle<Framebuffer_t> vulkanFramebufferHandle;
-    if (itFramebuffer == vulkanDevice->framebuffers.end()) {
-        // Create the framebuffer and cache the handle for it
-        vulkanFramebufferHandle = createFramebuffer(deviceHandle, framebufferKey);
-        vulkanDevice->framebuffers.insert({ framebufferKey, vulkanFramebufferHandle });
-    } else {
-        vulkanFramebufferHandle = itFramebuffer->second;
+    {
+        std::lock_guard framebuffersLock(*vulkanDevice->renderPassesAndFramebuffersMutex);
+        auto itFramebuffer = vulkanDevice->framebuffers.find(framebufferKey);
+        if (itFramebuffer == vulkanDevice->framebuffers.end()) {
+            // Create the framebuffer and cache the handle for it
+            vulkanFramebufferHandle = createFramebuffer(deviceHandle, framebufferKey);
+            vulkanDevice->framebuffers.insert({ framebufferKey, vulkanFramebufferHandle });
+        } else {
+            vulkanFramebufferHandle = itFramebuffer->second;
+        }
     }
 
     VulkanFramebuffer *vulkanFramebuffer = m_framebuffers.get(vulkanFramebufferHandle);
@@ -3243,6 +3795,155 @@ void VulkanResourceManager::deleteFramebuffer(const Handle<Framebuffer_t> &handl
     m_framebuffers.remove(handle);
 }
 
+namespace {
+
+BindGroupDescriptorCounts bindGroupLayoutDescriptorCounts(const VulkanBindGroupLayout &bindGroupLayout, uint32_t maxVariableArrayLength)
+{
+    BindGroupDescriptorCounts counts;
+    for (const ResourceBindingLayout &binding : bindGroupLayout.bindings) {
+        const uint64_t count = binding.flags.testFlag(ResourceBindingFlagBits::VariableBindGroupEntriesCountBit) ? maxVariableArrayLength : binding.count;
+        switch (binding.resourceType) {
+        case ResourceBindingType::UniformBuffer:
+            counts.uniformBufferCount += count;
+            break;
+        case ResourceBindingType::DynamicUniformBuffer:
+            counts.dynamicUniformBufferCount += count;
+            break;
+        case ResourceBindingType::StorageBuffer:
+            counts.storageBufferCount += count;
+            break;
+        case ResourceBindingType::CombinedImageSampler:
+            counts.textureSamplerCount += count;
+            break;
+        case ResourceBindingType::SampledImage:
+            counts.textureCount += count;
+            break;
+        case ResourceBindingType::Sampler:
+            counts.samplerCount += count;
+            break;
+        case ResourceBindingType::StorageImage:
+            counts.imageCount += count;
+            break;
+        case ResourceBindingType::InputAttachment:
+            counts.inputAttachmentCount += count;
+            break;
+        case ResourceBindingType::AccelerationStructure:
+            counts.accelerationStructureCount += count;
+            break;
+        default:
+            break;
+        }
+    }
+    return counts;
+}
+
+void addDescriptorCounts(BindGroupDescriptorCounts &counts, const BindGroupDescriptorCounts &other)
+{
+    counts.uniformBufferCount += other.uniformBufferCount;
+    counts.dynamicUniformBufferCount += other.dynamicUniformBufferCount;
+    counts.storageBufferCount += other.storageBufferCount;
+    counts.textureSamplerCount += other.textureSamplerCount;
+    counts.textureCount += other.textureCount;
+    counts.samplerCount += other.samplerCount;
+    counts.imageCount += other.imageCount;
+    counts.inputAttachmentCount += other.inputAttachmentCount;
+    counts.accelerationStructureCount += other.accelerationStructureCount;
+}
+
+} // namespace
+
+Handle<BindGroupPool_t> VulkanResourceManager::createInternalBindGroupPool(VulkanDevice *vulkanDevice,
+                                                                           const Handle<Device_t> &deviceHandle,
+                                                                           const BindGroupDescriptorCounts &requiredDescriptors)
+{
+    constexpr BindGroupPoolOptions defaultInternalPoolOptions{
+        .label = "Default BindGroupPool",
+        .uniformBufferCount = 512,
+        .dynamicUniformBufferCount = 16,
+        .storageBufferCount = 512,
+        .textureSamplerCount = 128,
+        .textureCount = 128,
+        .samplerCount = 8,
+        .imageCount = 8,
+        .inputAttachmentCount = 8,
+        .accelerationStructureCount = 8,
+        .maxBindGroupCount = 1024,
+        .flags = BindGroupPoolFlagBits::CreateFreeBindGroups
+    };
+
+    BindGroupPoolStatistics &statistics = vulkanDevice->descriptorSetPoolsStatistics;
+    BindGroupPoolOptions poolOptions = defaultInternalPoolOptions;
+
+    // Once some BindGroups have been allocated, size additional pools from the descriptor
+    // types actually consumed per BindGroup (with 25% headroom) rather than from fixed ratios
+    if (statistics.totalBindGroupAllocations > 0) {
+        constexpr uint64_t minDescriptorCount = 8;
+        const uint64_t bindGroupCount = statistics.totalBindGroupAllocations + 1;
+        const auto descriptorCount = [&](uint64_t allocated, uint64_t required) {
+            const uint64_t expected = (allocated + required) * poolOptions.maxBindGroupCount * 5 / (bindGroupCount * 4);
+            return static_cast<uint16_t>(std::clamp<uint64_t>(expected, minDescriptorCount, std::numeric_limits<uint16_t>::max()));
+        };
+
+        const BindGroupDescriptorCounts &allocated = statistics.totalDescriptorAllocations;
+        poolOptions.label = "Adaptive BindGroupPool";
+        poolOptions.uniformBufferCount = descriptorCount(allocated.uniformBufferCount, requiredDescriptors.uniformBufferCount);
+        poolOptions.dynamicUniformBufferCount = descriptorCount(allocated.dynamicUniformBufferCount, requiredDescriptors.dynamicUniformBufferCount);
+        poolOptions.storageBufferCount = descriptorCount(allocated.storageBufferCount, requiredDescriptors.storageBufferCount);
+        poolOptions.textureSamplerCount = descriptorCount(allocated.textureSamplerCount, requiredDescriptors.textureSamplerCount);
+        poolOptions.textureCount = descriptorCount(allocated.textureCount, requiredDescriptors.textureCount);
+        poolOptions.samplerCount = descriptorCount(allocated.samplerCount, requiredDescriptors.samplerCount);
+        poolOptions.imageCount = descriptorCount(allocated.imageCount, requiredDescriptors.imageCount);
+        poolOptions.inputAttachmentCount = descriptorCount(allocated.inputAttachmentCount, requiredDescriptors.inputAttachmentCount);
+        poolOptions.accelerationStructureCount = descriptorCount(allocated.accelerationStructureCount, requiredDescriptors.accelerationStructureCount);
+    }
+
+    // Whatever the sizing, the pool must be able to hold the BindGroup it is created for
+    const auto atLeastRequired = [](uint16_t count, uint64_t required) {
+        return static_cast<uint16_t>(std::clamp<uint64_t>(required, count, std::numeric_limits<uint16_t>::max()));
+    };
+    poolOptions.uniformBufferCount = atLeastRequired(poolOptions.uniformBufferCount, requiredDescriptors.uniformBufferCount);
+    poolOptions.dynamicUniformBufferCount = atLeastRequired(poolOptions.dynamicUniformBufferCount, requiredDescriptors.dynamicUniformBufferCount);
+    poolOptions.storageBufferCount = atLeastRequired(poolOptions.storageBufferCount, requiredDescriptors.storageBufferCount);
+    poolOptions.textureSamplerCount = atLeastRequired(poolOptions.textureSamplerCount, requiredDescriptors.textureSamplerCount);
+    poolOptions.textureCount = atLeastRequired(poolOptions.textureCount, requiredDescriptors.textureCount);
+    poolOptions.samplerCount = atLeastRequired(poolOptions.samplerCount, requiredDescriptors.samplerCount);
+    poolOptions.imageCount = atLeastRequired(poolOptions.imageCount, requiredDescriptors.imageCount);
+    poolOptions.inputAttachmentCount = atLeastRequired(poolOptions.inputAttachmentCount, requiredDescriptors.inputAttachmentCount);
+    poolOptions.accelerationStructureCount = atLeastRequired(poolOptions.accelerationStructureCount, requiredDescriptors.accelerationStructureCount);
+
+    const Handle<BindGroupPool_t> poolHandle = createBindGroupPool(deviceHandle, poolOptions);
+    if (!poolHandle.isValid())
+        return {};
+
+    ++statistics.poolCount;
+    statistics.bindGroupCapacity += poolOptions.maxBindGroupCount;
+    addDescriptorCounts(statistics.descriptorCapacity, BindGroupDescriptorCounts{
+                                                               .uniformBufferCount = poolOptions.uniformBufferCount,
+                                                               .dynamicUniformBufferCount = poolOptions.dynamicUniformBufferCount,
+                                                               .storageBufferCount = poolOptions.storageBufferCount,
+                                                               .textureSamplerCount = poolOptions.textureSamplerCount,
+                                                               .textureCount = poolOptions.textureCount,
+                                                               .samplerCount = poolOptions.samplerCount,
+                                                               .imageCount = poolOptions.imageCount,
+                                                               .inputAttachmentCount = poolOptions.inputAttachmentCount,
+                                                               .accelerationStructureCount = poolOptions.accelerationStructureCount,
+                                                       });
+    return poolHandle;
+}
+
+BindGroupPoolStatistics VulkanResourceManager::internalBindGroupPoolStatistics(const Handle<Device_t> &deviceHandle) const
+{
+    VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+
+    std::lock_guard lock(*vulkanDevice->descriptorSetPoolsMutex);
+    BindGroupPoolStatistics statistics = vulkanDevice->descriptorSetPoolsStatistics;
+    for (const Handle<BindGroupPool_t> &poolHandle : vulkanDevice->descriptorSetPools) {
+        if (const VulkanBindGroupPool *pool = m_bindGroupPools.get(poolHandle))
+            statistics.allocatedBindGroupCount += pool->bindGroupCount();
+    }
+    return statistics;
+}
+
 Handle<BindGroup_t> VulkanResourceManager::createBindGroup(const Handle<Device_t> &deviceHandle, const BindGroupOptions &options)
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
@@ -3273,33 +3974,36 @@ Handle<BindGroup_t> VulkanResourceManager::createBindGroup(const Handle<Device_t
     // Determine which bind group pool to use
     Handle<BindGroupPool_t> poolHandle = options.bindGroupPool;
     const bool useInternalPool = !poolHandle.isValid();
+    VulkanBindGroupLayout *bindGroupLayout = getBindGroupLayout(options.layout);
 
-    constexpr BindGroupPoolOptions defaultInternalPoolOptions{
-        .label = "Default BindGroupPool",
-        .uniformBufferCount = 512,
-        .dynamicUniformBufferCount = 16,
-        .storageBufferCount = 512,
-        .textureSamplerCount = 128,
-        .textureCount = 128,
-        .samplerCount = 8,
-        .imageCount = 8,
-        .inputAttachmentCount = 8,
-        .accelerationStructureCount = 8,
-        .maxBindGroupCount = 1024,
-        .flags = BindGroupPoolFlagBits::CreateFreeBindGroups
-    };
-
+    // Internal pools are shared by all threads creating BindGroups without a pool
+    std::unique_lock<std::mutex> internalPoolsLock;
+    BindGroupDescriptorCounts requiredDescriptors;
     if (useInternalPool) {
+        internalPoolsLock = std::unique_lock(*vulkanDevice->descriptorSetPoolsMutex);
+        requiredDescriptors = bindGroupLayoutDescriptorCounts(*bindGroupLayout, options.maxVariableArrayLength);
+
         // Use or create a default pool from the device's pool vector
         if (vulkanDevice->descriptorSetPools.empty()) {
-            // Create a default bind group pool with reasonable defaults
-            vulkanDevice->descriptorSetPools.emplace_back(createBindGroupPool(deviceHandle, defaultInternalPoolOptions));
+            const Handle<BindGroupPool_t> internalPoolHandle = createInternalBindGroupPool(vulkanDevice, deviceHandle, requiredDescriptors);
+            if (!internalPoolHandle.isValid()) {
+                SPDLOG_LOGGER_ERROR(Logger::logger(), "Unable to create internal BindGroupPool");
+                return {};
+            }
+            vulkanDevice->descriptorSetPools.emplace_back(internalPoolHandle);
         }
         poolHandle = vulkanDevice->descriptorSetPools.back();
     }
 
     VulkanBindGroupPool *vulkanBindGroupPool = getBindGroupPool(poolHandle);
-    VulkanBindGroupLayout *bindGroupLayout = getBindGroupLayout(options.layout);
+    if (!vulkanBindGroupPool) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Cannot find requested BindGroupPool");
+        return {};
+    }
+
+    if (vulkanBindGroupPool->usesDescriptorBuffer())
+        return createDescriptorBufferBindGroup(vulkanDevice, deviceHandle, poolHandle, bindGroupLayout, options);
+
     VkDescriptorSet descriptorSet{ VK_NULL_HANDLE };
 
     // Allocate DescriptorSet from the bind group pool
@@ -3310,13 +4014,21 @@ Handle<BindGroup_t> VulkanResourceManager::createBindGroup(const Handle<Device_t
     if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
         if (useInternalPool) {
             SPDLOG_LOGGER_INFO(Logger::logger(), "Internal BindGroup pool out of memory, creating additional pool");
-            vulkanDevice->descriptorSetPools.emplace_back(createBindGroupPool(deviceHandle, defaultInternalPoolOptions));
-            poolHandle = vulkanDevice->descriptorSetPools.back();
+            const Handle<BindGroupPool_t> internalPoolHandle = createInternalBindGroupPool(vulkanDevice, deviceHandle, requiredDescriptors);
+            if (!internalPoolHandle.isValid()) {
+                SPDLOG_LOGGER_ERROR(Logger::logger(), "Unable to create additional internal BindGroupPool");
+                return {};
+            }
+            vulkanDevice->descriptorSetPools.emplace_back(internalPoolHandle);
+            poolHandle = internalPoolHandle;
             vulkanBindGroupPool = getBindGroupPool(poolHandle);
             result = allocateDescriptorSet(vulkanDevice->device, vulkanBindGroupPool->descriptorPool,
                                            bindGroupLayout, descriptorSet, options.maxVariableArrayLength);
         } else {
-            SPDLOG_LOGGER_ERROR(Logger::logger(), "BindGroupPool out of memory");
+            // Not an error as such, callers such as KDGpuUtils::TransientBindGroupAllocator rely on
+            // running out of pool memory to move on to another pool
+            SPDLOG_LOGGER_DEBUG(Logger::logger(), "BindGroupPool out of memory");
+            return {};
         }
     }
 
@@ -3338,20 +4050,75 @@ Handle<BindGroup_t> VulkanResourceManager::createBindGroup(const Handle<Device_t
 
     const auto vulkanBindGroupHandle = m_bindGroups.emplace(VulkanBindGroup(descriptorSet,
                                                                             poolHandle,
+                                                                            options.layout,
                                                                             this,
                                                                             deviceHandle,
                                                                             options.implicitFree));
     // Record new bindgroup handle against pool
     vulkanBindGroupPool->addBindGroup(vulkanBindGroupHandle);
 
+    if (useInternalPool) {
+        BindGroupPoolStatistics &statistics = vulkanDevice->descriptorSetPoolsStatistics;
+        ++statistics.totalBindGroupAllocations;
+        addDescriptorCounts(statistics.totalDescriptorAllocations, requiredDescriptors);
+    }
+
     // Set up the initial bindings
     auto *vulkanBindGroup = m_bindGroups.get(vulkanBindGroupHandle);
-    for (const auto &resource : options.resources)
-        vulkanBindGroup->update(resource);
+    vulkanBindGroup->update(options.resources);
 
     return vulkanBindGroupHandle;
 }
 
+Handle<BindGroup_t> VulkanResourceManager::createDescriptorBufferBindGroup(VulkanDevice *vulkanDevice,
+                                                                           const Handle<Device_t> &deviceHandle,
+                                                                           const Handle<BindGroupPool_t> &poolHandle,
+                                                                           VulkanBindGroupLayout *bindGroupLayout,
+                                                                           const BindGroupOptions &options)
+{
+#if defined(VK_EXT_descriptor_buffer)
+    VulkanBindGroupPool *vulkanBindGroupPool = getBindGroupPool(poolHandle);
+
+    if (!bindGroupLayout->flags.testFlag(BindGroupLayoutFlagBits::DescriptorBuffer)) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "BindGroupPools using a descriptor buffer require a BindGroupLayout created with BindGroupLayoutFlagBits::DescriptorBuffer");
+        return {};
+    }
+
+    // Descriptor set pools enforce this through maxSets, we have to do it ourselves
+    if (vulkanBindGroupPool->bindGroupCount() >= vulkanBindGroupPool->maxBindGroupCount) {
+        SPDLOG_LOGGER_DEBUG(Logger::logger(), "BindGroupPool out of memory");
+        return {};
+    }
+
+    // Sub-allocate the BindGroup linearly from the pool's descriptor buffer. The space is only reclaimed by BindGroupPool::reset()
+    VkDeviceSize layoutSize = 0;
+    vulkanDevice->vkGetDescriptorSetLayoutSizeEXT(vulkanDevice->device, bindGroupLayout->descriptorSetLayout, &layoutSize);
+
+    VkDeviceSize descriptorBufferOffset = 0;
+    if (!vulkanBindGroupPool->allocateDescriptorBufferRange(layoutSize, vulkanDevice->descriptorBufferProperties.descriptorBufferOffsetAlignment, descriptorBufferOffset)) {
+        SPDLOG_LOGGER_DEBUG(Logger::logger(), "BindGroupPool descriptor buffer out of memory");
+        return {};
+    }
+
+    const auto vulkanBindGroupHandle = m_bindGroups.emplace(VulkanBindGroup(VK_NULL_HANDLE,
+                                                                            poolHandle,
+                                                                            options.layout,
+                                                                            this,
+                                                                            deviceHandle,
+                                                                            options.implicitFree,
+                                                                            descriptorBufferOffset));
+    vulkanBindGroupPool->addBindGroup(vulkanBindGroupHandle);
+
+    auto *vulkanBindGroup = m_bindGroups.get(vulkanBindGroupHandle);
+    vulkanBindGroup->update(options.resources);
+
+    return vulkanBindGroupHandle;
+#else
+    SPDLOG_LOGGER_ERROR(Logger::logger(), "Descriptor buffers are not supported by this build");
+    return {};
+#endif
+}
+
 void VulkanResourceManager::deleteBindGroup(const Handle<BindGroup_t> &handle)
 {
     VulkanBindGroup *vulkanBindGroup = m_bindGroups.get(handle);
@@ -3368,6 +4135,8 @@ void VulkanResourceManager::deleteBindGroup(const Handle<BindGroup_t> &handle)
         // would make BindGroupPool::allocatedBindGroupCount() return an incorrect value.
         vulkanBindGroupPool->removeBindGroup(handle);
     }
+    // BindGroups allocated from a descriptor buffer have nothing to free. Their range is only recycled
+    // when the pool is reset, so they remain counted by BindGroupPool::allocatedBindGroupCount() until then.
 
     m_bindGroups.remove(handle);
 }
@@ -3377,10 +4146,37 @@ VulkanBindGroup *VulkanResourceManager::getBindGroup(const Handle<BindGroup_t> &
     return m_bindGroups.get(handle);
 }
 
+namespace {
+
+// Key under which a layout is interned. The label only names the layout and bindings
+// are sorted the same way VulkanBindGroupLayout sorts them, so that the key can be
+// rebuilt from the VulkanBindGroupLayout when it is released.
+BindGroupLayoutOptions bindGroupLayoutKey(const std::vector<ResourceBindingLayout> &bindings, BindGroupLayoutFlags flags)
+{
+    BindGroupLayoutOptions key{ .bindings = bindings, .flags = flags };
+    std::sort(key.bindings.begin(), key.bindings.end(), [](const auto &b1, const auto &b2) {
+        return b1.binding < b2.binding;
+    });
+    return key;
+}
+
+} // namespace
+
 Handle<BindGroupLayout_t> VulkanResourceManager::createBindGroupLayout(const Handle<Device_t> &deviceHandle, const BindGroupLayoutOptions &options)
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
 
+    std::unique_lock<std::mutex> layoutsLock;
+    BindGroupLayoutOptions key;
+    if (vulkanDevice->deduplicateLayouts) {
+        layoutsLock = std::unique_lock(*vulkanDevice->layoutsMutex);
+        key = bindGroupLayoutKey(options.bindings, options.flags);
+        if (auto it = vulkanDevice->bindGroupLayouts.find(key); it != vulkanDevice->bindGroupLayouts.end()) {
+            ++m_bindGroupLayouts.get(it->second)->refCount;
+            return it->second;
+        }
+    }
+
     assert(options.bindings.size() <= std::numeric_limits<uint32_t>::max());
     const uint32_t bindingLayoutCount = static_cast<uint32_t>(options.bindings.size());
     std::vector<VkDescriptorSetLayoutBinding> vkBindingLayouts;
@@ -3432,12 +4228,15 @@ Handle<BindGroupLayout_t> VulkanResourceManager::createBindGroupLayout(const Han
 
     VkDescriptorSetLayout vkDescriptorSetLayout{ VK_NULL_HANDLE };
     if (auto result = vkCreateDescriptorSetLayout(vulkanDevice->device, &createInfo, nullptr, &vkDescriptorSetLayout); result != VK_SUCCESS) {
-        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating pipeline layout: {}", result);
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating bind group layout: {}", result);
+        return {};
     }
 
     setObjectName(vulkanDevice, VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, reinterpret_cast<uint64_t>(vkDescriptorSetLayout), options.label);
 
-    const auto vulkanBindGroupLayoutHandle = m_bindGroupLayouts.emplace(VulkanBindGroupLayout(vkDescriptorSetLayout, deviceHandle, options.bindings));
+    const auto vulkanBindGroupLayoutHandle = m_bindGroupLayouts.emplace(VulkanBindGroupLayout(vkDescriptorSetLayout, deviceHandle, options.bindings, options.flags));
+    if (vulkanDevice->deduplicateLayouts)
+        vulkanDevice->bindGroupLayouts.emplace(std::move(key), vulkanBindGroupLayoutHandle);
     return vulkanBindGroupLayoutHandle;
 }
 
@@ -3446,6 +4245,15 @@ void VulkanResourceManager::deleteBindGroupLayout(const Handle<BindGroupLayout_t
     VulkanBindGroupLayout *vulkanBindGroupLayout = m_bindGroupLayouts.get(handle);
     VulkanDevice *vulkanDevice = m_devices.get(vulkanBindGroupLayout->deviceHandle);
 
+    if (vulkanDevice->deduplicateLayouts) {
+        std::lock_guard lock(*vulkanDevice->layoutsMutex);
+        // Only destroy the layout once the last BindGroupLayout sharing it is released
+        if (--vulkanBindGroupLayout->refCount > 0)
+            return;
+        vulkanDevice->bindGroupLayouts.erase(bindGroupLayoutKey(vulkanBindGroupLayout->bindings, vulkanBindGroupLayout->flags));
+    }
+
+    vulkanBindGroupLayout->destroyDescriptorUpdateTemplate(vulkanDevice->device);
     vkDestroyDescriptorSetLayout(vulkanDevice->device, vulkanBindGroupLayout->descriptorSetLayout, nullptr);
 
     m_bindGroupLayouts.remove(handle);
@@ -3460,6 +4268,20 @@ Handle<Sampler_t> VulkanResourceManager::createSampler(const Handle<Device_t> &d
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
 
+    // The label only names the sampler, it doesn't take part in the lookup
+    SamplerOptions key = options;
+    key.label = {};
+
+    std::unique_lock<std::mutex> samplersLock;
+    if (vulkanDevice->deduplicateSamplers) {
+        samplersLock = std::unique_lock(*vulkanDevice->samplersMutex);
+        if (auto it = vulkanDevice->samplers.find(key); it != vulkanDevice->samplers.end()) {
+            ++m_samplers.get(it->second)->refCount;
+            ++vulkanDevice->samplerCacheHits;
+            return it->second;
+        }
+    }
+
     VkSamplerCreateInfo samplerInfo{};
     samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
     samplerInfo.magFilter = filterModeToVkFilterMode(options.magFilter);
@@ -3510,6 +4332,11 @@ Handle<Sampler_t> VulkanResourceManager::createSampler(const Handle<Device_t> &d
     setObjectName(vulkanDevice, VK_OBJECT_TYPE_SAMPLER, reinterpret_cast<uint64_t>(sampler), options.label);
 
     auto samplerHandle = m_samplers.emplace(VulkanSampler(sampler, deviceHandle));
+    m_samplers.get(samplerHandle)->options = key;
+    if (vulkanDevice->deduplicateSamplers) {
+        ++vulkanDevice->samplerCacheMisses;
+        vulkanDevice->samplers.emplace(std::move(key), samplerHandle);
+    }
     return samplerHandle;
 }
 
@@ -3518,6 +4345,14 @@ void VulkanResourceManager::deleteSampler(const Handle<Sampler_t> &handle)
     VulkanSampler *sampler = m_samplers.get(handle);
     VulkanDevice *vulkanDevice = m_devices.get(sampler->deviceHandle);
 
+    if (vulkanDevice->deduplicateSamplers) {
+        std::lock_guard lock(*vulkanDevice->samplersMutex);
+        // Only destroy the sampler once the last Sampler sharing it is released
+        if (--sampler->refCount > 0)
+            return;
+        vulkanDevice->samplers.erase(sampler->options);
+    }
+
     vkDestroySampler(vulkanDevice->device, sampler->sampler, nullptr);
     m_samplers.remove(handle);
 }
@@ -3527,6 +4362,20 @@ VulkanSampler *VulkanResourceManager::getSampler(const Handle<Sampler_t> &handle
     return m_samplers.get(handle);
 }
 
+CacheStatistics VulkanResourceManager::samplerCacheStatistics(const Handle<Device_t> &deviceHandle) const
+{
+    VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
+    if (!vulkanDevice->deduplicateSamplers)
+        return {};
+
+    std::lock_guard lock(*vulkanDevice->samplersMutex);
+    return CacheStatistics{
+        .hits = vulkanDevice->samplerCacheHits,
+        .misses = vulkanDevice->samplerCacheMisses,
+        .entryCount = static_cast<uint32_t>(vulkanDevice->samplers.size()),
+    };
+}
+
 Handle<Fence_t> VulkanResourceManager::createFence(const Handle<Device_t> &deviceHandle, const FenceOptions &options)
 {
     VulkanDevice *vulkanDevice = m_devices.get(deviceHandle);
@@ -3797,6 +4646,7 @@ std::string VulkanResourceManager::getMemoryStats(const Handle<Device_t> &device
         vmaFreeStatsString(vulkanDevice->allocator, statsAllocator);
     }
 
+    std::lock_guard lock(*vulkanDevice->externalAllocatorsMutex);
     for (const auto &[memoryHandleType, externalAllocator] : vulkanDevice->externalAllocators) {
         // Check if we have allocations in any of the heaps, otherwise don't build statistics
         const auto hasAllocations = [externalAllocator] {
@@ -3894,6 +4744,30 @@ bool VulkanResourceManager::fillShaderStageInfos(const std::vector<ShaderStage>
     return true;
 }
 
+VkPipelineCache VulkanResourceManager::createPipelineCache(VulkanDevice *vulkanDevice, const std::vector<uint8_t> &initialData) const
+{
+    VulkanAdapter *vulkanAdapter = getAdapter(vulkanDevice->adapterHandle);
+
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    if (!initialData.empty()) {
+        if (isPipelineCacheDataCompatible(initialData, vulkanAdapter->queryAdapterProperties())) {
+            createInfo.initialDataSize = initialData.size();
+            createInfo.pInitialData = initialData.data();
+        } else {
+            SPDLOG_LOGGER_WARN(Logger::logger(), "Discarding pipeline cache data created by a different adapter or driver");
+        }
+    }
+
+    VkPipelineCache vkPipelineCache{ VK_NULL_HANDLE };
+    if (auto result = vkCreatePipelineCache(vulkanDevice->device, &createInfo, nullptr, &vkPipelineCache); result != VK_SUCCESS) {
+        SPDLOG_LOGGER_ERROR(Logger::logger(), "Error when creating pipeline cache: {}", result);
+        return VK_NULL_HANDLE;
+    }
+
+    return vkPipelineCache;
+}
+
 std::vector<std::string> VulkanResourceManager::getAvailableLayers()
 {
     uint32_t layerCount{ 0 };
@@ -41,12 +41,17 @@
 #include <KDGpu/vulkan/vulkan_raytracing_pass_command_recorder.h>
 #include <KDGpu/vulkan/vulkan_ycbcr_conversion.h>
 
+#include <KDGpu/bind_group_pool_statistics.h>
+#include <KDGpu/cache_statistics.h>
+#include <KDGpu/command_pool.h>
 #include <KDGpu/instance.h>
 #include <KDGpu/pool.h>
 #include <KDGpu/kdgpu_export.h>
 
 #include <vulkan/vulkan.h>
 
+#include <span>
+
 namespace KDGpu {
 
 /**
@@ -123,14 +128,18 @@ public:
     [[nodiscard]] VulkanPipelineLayout *getPipelineLayout(const Handle<PipelineLayout_t> &handle) const;
 
     Handle<GraphicsPipeline_t> createGraphicsPipeline(const Handle<Device_t> &deviceHandle, const GraphicsPipelineOptions &options);
+    std::vector<Handle<GraphicsPipeline_t>> createGraphicsPipelines(const Handle<Device_t> &deviceHandle, std::span<const GraphicsPipelineOptions> options);
     void deleteGraphicsPipeline(const Handle<GraphicsPipeline_t> &handle);
     [[nodiscard]] VulkanGraphicsPipeline *getGraphicsPipeline(const Handle<GraphicsPipeline_t> &handle) const;
+    [[nodiscard]] CacheStatistics graphicsPipelineRegistryStatistics(const Handle<Device_t> &deviceHandle) const;
 
     Handle<ComputePipeline_t> createComputePipeline(const Handle<Device_t> &deviceHandle, const ComputePipelineOptions &options);
+    std::vector<Handle<ComputePipeline_t>> createComputePipelines(const Handle<Device_t> &deviceHandle, std::span<const ComputePipelineOptions> options);
     void deleteComputePipeline(const Handle<ComputePipeline_t> &handle);
     [[nodiscard]] VulkanComputePipeline *getComputePipeline(const Handle<ComputePipeline_t> &handle) const;
 
     Handle<RayTracingPipeline_t> createRayTracingPipeline(const Handle<Device_t> &deviceHandle, const RayTracingPipelineOptions &options);
+    std::vector<Handle<RayTracingPipeline_t>> createRayTracingPipelines(const Handle<Device_t> &deviceHandle, std::span<const RayTracingPipelineOptions> options);
     void deleteRayTracingPipeline(const Handle<RayTracingPipeline_t> &handle);
     [[nodiscard]] VulkanRayTracingPipeline *getRayTracingPipeline(const Handle<RayTracingPipeline_t> &handle) const;
 
@@ -183,9 +192,15 @@ public:
     void deleteCommandBuffer(const Handle<CommandBuffer_t> &handle);
     [[nodiscard]] VulkanCommandBuffer *getCommandBuffer(const Handle<CommandBuffer_t> &handle) const;
 
+    Handle<CommandPool_t> createCommandPool(const Handle<Device_t> &deviceHandle, const CommandPoolOptions &options);
+    void deleteCommandPool(const Handle<CommandPool_t> &handle);
+    [[nodiscard]] VulkanCommandPool *getCommandPool(const Handle<CommandPool_t> &handle) const;
+    void resetCommandPool(const Handle<CommandPool_t> &handle);
+
     Handle<BindGroupPool_t> createBindGroupPool(const Handle<Device_t> &deviceHandle, const BindGroupPoolOptions &options);
     void deleteBindGroupPool(const Handle<BindGroupPool_t> &handle);
     [[nodiscard]] VulkanBindGroupPool *getBindGroupPool(const Handle<BindGroupPool_t> &handle) const;
+    [[nodiscard]] BindGroupPoolStatistics internalBindGroupPoolStatistics(const Handle<Device_t> &deviceHandle) const;
 
     Handle<BindGroup_t> createBindGroup(const Handle<Device_t> &deviceHandle, const BindGroupOptions &options);
     void deleteBindGroup(const Handle<BindGroup_t> &handle);
@@ -198,6 +213,7 @@ public:
     Handle<Sampler_t> createSampler(const Handle<Device_t> &deviceHandle, const SamplerOptions &options);
     void deleteSampler(const Handle<Sampler_t> &handle);
     [[nodiscard]] VulkanSampler *getSampler(const Handle<Sampler_t> &handle) const;
+    [[nodiscard]] CacheStatistics samplerCacheStatistics(const Handle<Device_t> &deviceHandle) const;
 
     Handle<Fence_t> createFence(const Handle<Device_t> &deviceHandle, const FenceOptions &options);
     void deleteFence(const Handle<Fence_t> &handle);
@@ -234,6 +250,81 @@ private:
     bool fillShaderStageInfos(const std::vector<ShaderStage> &stages,
                               ShaderStagesInfo &shaderStagesInfo) const;
 
+    Handle<BindGroupPool_t> createDescriptorBufferBindGroupPool(VulkanDevice *vulkanDevice,
+                                                                const Handle<Device_t> &deviceHandle,
+                                                                const BindGroupPoolOptions &options,
+                                                                const std::vector<VkDescriptorPoolSize> &poolSizes);
+    Handle<BindGroupPool_t> createInternalBindGroupPool(VulkanDevice *vulkanDevice,
+                                                        const Handle<Device_t> &deviceHandle,
+                                                        const BindGroupDescriptorCounts &requiredDescriptors);
+    Handle<BindGroup_t> createDescriptorBufferBindGroup(VulkanDevice *vulkanDevice,
+                                                        const Handle<Device_t> &deviceHandle,
+                                                        const Handle<BindGroupPool_t> &poolHandle,
+                                                        VulkanBindGroupLayout *bindGroupLayout,
+                                                        const BindGroupOptions &options);
+
+    [[nodiscard]] const QueueDescription *findQueueDescription(const VulkanDevice *vulkanDevice, const Handle<Queue_t> &queue) const;
+    Handle<CommandBuffer_t> recycleCommandBuffer(VulkanCommandPool *commandPool, CommandBufferLevel commandLevel);
+
+    // Storage for everything a pipeline create info points to. These must not be
+    // moved once filled in, so that several of them can be passed to the driver at once.
+    struct GraphicsPipelineInfo {
+        ShaderStagesInfo shaderStagesInfo;
+        std::vector<VkVertexInputBindingDescription> vertexBindings;
+        std::vector<VkVertexInputAttributeDescription> attributes;
+        VkPipelineVertexInputStateCreateInfo vertexInputState{};
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        VkPipelineTessellationStateCreateInfo tessellationStateInfo{};
+        VkPipelineRasterizationStateCreateInfo rasterizer{};
+        VkPipelineMultisampleStateCreateInfo multisampling{};
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        std::vector<VkPipelineColorBlendAttachmentState> attachmentBlends;
+        std::vector<VkFormat> vkColorFormats;
+        VkPipelineColorBlendStateCreateInfo colorBlending{};
+        std::vector<VkDynamicState> dynamicStates;
+        VkPipelineDynamicStateCreateInfo dynamicStateInfo{};
+        VkPipelineViewportStateCreateInfo viewportState{};
+#if defined(VK_KHR_dynamic_rendering)
+        VkPipelineRenderingCreateInfoKHR pipelineDynamicRenderingCreateInfo{};
+        VkRenderingInputAttachmentIndexInfoKHR inputAttachmentLocations{};
+        VkRenderingAttachmentLocationInfoKHR outputAttachmentLocations{};
+        std::vector<uint32_t> outputLocations;
+        std::vector<uint32_t> inputColorLocations;
+        uint32_t inputDepthLocation{ VK_ATTACHMENT_UNUSED };
+        uint32_t inputStencilLocation{ VK_ATTACHMENT_UNUSED };
+#endif
+        Handle<RenderPass_t> implicitRenderPassHandle;
+        VkGraphicsPipelineCreateInfo pipelineInfo{};
+    };
+
+    struct ComputePipelineInfo {
+        VkSpecializationInfo shaderSpecializationInfo{};
+        std::vector<VkSpecializationMapEntry> shaderSpecializationMapEntries;
+        std::vector<uint8_t> shaderSpecializationRawData;
+        VkComputePipelineCreateInfo pipelineInfo{};
+    };
+
+#if defined(VK_KHR_ray_tracing_pipeline)
+    struct RayTracingPipelineInfo {
+        ShaderStagesInfo shaderStagesInfo;
+        std::vector<VkRayTracingShaderGroupCreateInfoKHR> shaderGroupsInfo;
+        std::vector<VkDynamicState> dynamicStates;
+        VkPipelineDynamicStateCreateInfo dynamicStateInfo{};
+        VkRayTracingPipelineCreateInfoKHR pipelineInfo{};
+    };
+#endif
+
+    bool fillGraphicsPipelineInfo(const Handle<Device_t> &deviceHandle,
+                                  const GraphicsPipelineOptions &options,
+                                  GraphicsPipelineInfo &info);
+    bool fillComputePipelineInfo(const ComputePipelineOptions &options,
+                                 ComputePipelineInfo &info) const;
+#if defined(VK_KHR_ray_tracing_pipeline)
+    bool fillRayTracingPipelineInfo(const Handle<Device_t> &deviceHandle,
+                                    const RayTracingPipelineOptions &options,
+                                    RayTracingPipelineInfo &info) const;
+#endif
+
     // For RenderPassCommandRecorder implicit RenderPass creation
     Handle<RenderPass_t> createImplicitRenderPass(const Handle<Device_t> &deviceHandle,
                                                   const std::vector<ColorAttachment> &colorAttachments,
@@ -241,6 +332,9 @@ private:
                                                   SampleCountFlagBits samples,
                                                   uint32_t viewCount);
 
+    std::vector<Handle<GraphicsPipeline_t>> compileGraphicsPipelines(const Handle<Device_t> &deviceHandle, std::span<const GraphicsPipelineOptions> options);
+    void destroyGraphicsPipeline(const Handle<GraphicsPipeline_t> &handle);
+
     // For GraphicsPipeline implicit RenderPass creation
     Handle<RenderPass_t> createImplicitRenderPass(const Handle<Device_t> &deviceHandle,
                                                   const std::vector<RenderTargetOptions> &colorAttachments,
@@ -254,6 +348,8 @@ private:
 
     static void setObjectName(VulkanDevice *device, VkObjectType type, uint64_t handle, std::string_view name);
 
+    [[nodiscard]] VkPipelineCache createPipelineCache(VulkanDevice *vulkanDevice, const std::vector<uint8_t> &initialData) const;
+
     [[nodiscard]] static std::vector<std::string> getAvailableLayers();
 
     [[nodiscard]] static MemoryHandle retrieveExternalMemoryHandle(VulkanInstance *instance,
@@ -261,36 +357,38 @@ private:
                                                                    const VmaAllocationInfo &allocationInfo,
                                                                    ExternalMemoryHandleTypeFlags handleType);
 
-    Pool<VulkanInstance, Instance_t> m_instances{ 1 };
-    Pool<VulkanAdapter, Adapter_t> m_adapters{ 1 };
-    Pool<VulkanDevice, Device_t> m_devices{ 1 };
-    Pool<VulkanQueue, Queue_t> m_queues{ 4 };
-    Pool<VulkanSurface, Surface_t> m_surfaces{ 1 };
-    Pool<VulkanSwapchain, Swapchain_t> m_swapchains{ 1 };
-    Pool<VulkanTexture, Texture_t> m_textures{ 128 };
-    Pool<VulkanTextureView, TextureView_t> m_textureViews{ 128 };
-    Pool<VulkanBuffer, Buffer_t> m_buffers{ 128 };
-    Pool<VulkanShaderModule, ShaderModule_t> m_shaderModules{ 64 };
-    Pool<VulkanPipelineLayout, PipelineLayout_t> m_pipelineLayouts{ 64 };
-    Pool<VulkanBindGroupLayout, BindGroupLayout_t> m_bindGroupLayouts{ 128 };
-    Pool<VulkanBindGroup, BindGroup_t> m_bindGroups{ 128 };
-    Pool<VulkanBindGroupPool, BindGroupPool_t> m_bindGroupPools{ 4 };
-    Pool<VulkanGraphicsPipeline, GraphicsPipeline_t> m_graphicsPipelines{ 64 };
-    Pool<VulkanComputePipeline, ComputePipeline_t> m_computePipelines{ 64 };
-    Pool<VulkanRayTracingPipeline, RayTracingPipeline_t> m_rayTracingPipelines{ 64 };
-    Pool<VulkanGpuSemaphore, GpuSemaphore_t> m_gpuSemaphores{ 32 };
-    Pool<VulkanCommandRecorder, CommandRecorder_t> m_commandRecorders{ 32 };
-    Pool<VulkanRenderPassCommandRecorder, RenderPassCommandRecorder_t> m_renderPassCommandRecorders{ 32 };
-    Pool<VulkanComputePassCommandRecorder, ComputePassCommandRecorder_t> m_computePassCommandRecorders{ 32 };
-    Pool<VulkanRayTracingPassCommandRecorder, RayTracingPassCommandRecorder_t> m_rayTracingPassCommandRecorders{ 32 };
-    Pool<VulkanCommandBuffer, CommandBuffer_t> m_commandBuffers{ 128 };
-    Pool<VulkanRenderPass, RenderPass_t> m_renderPasses{ 16 };
-    Pool<VulkanFramebuffer, Framebuffer_t> m_framebuffers{ 16 };
-    Pool<VulkanSampler, Sampler_t> m_samplers{ 16 };
-    Pool<VulkanFence, Fence_t> m_fences{ 16 };
-    Pool<VulkanTimestampQueryRecorder, TimestampQueryRecorder_t> m_timestampQueryRecorders{ 4 };
-    Pool<VulkanAccelerationStructure, AccelerationStructure_t> m_accelerationStructures{ 32 };
-    Pool<VulkanYCbCrConversion, YCbCrConversion_t> m_yCbCrConversions{ 16 };
+    // Resources can be created, destroyed and looked up from any thread
+    Pool<VulkanInstance, Instance_t, true> m_instances{ 1 };
+    Pool<VulkanAdapter, Adapter_t, true> m_adapters{ 1 };
+    Pool<VulkanDevice, Device_t, true> m_devices{ 1 };
+    Pool<VulkanQueue, Queue_t, true> m_queues{ 4 };
+    Pool<VulkanSurface, Surface_t, true> m_surfaces{ 1 };
+    Pool<VulkanSwapchain, Swapchain_t, true> m_swapchains{ 1 };
+    Pool<VulkanTexture, Texture_t, true> m_textures{ 128 };
+    Pool<VulkanTextureView, TextureView_t, true> m_textureViews{ 128 };
+    Pool<VulkanBuffer, Buffer_t, true> m_buffers{ 128 };
+    Pool<VulkanShaderModule, ShaderModule_t, true> m_shaderModules{ 64 };
+    Pool<VulkanPipelineLayout, PipelineLayout_t, true> m_pipelineLayouts{ 64 };
+    Pool<VulkanBindGroupLayout, BindGroupLayout_t, true> m_bindGroupLayouts{ 128 };
+    Pool<VulkanBindGroup, BindGroup_t, true> m_bindGroups{ 128 };
+    Pool<VulkanBindGroupPool, BindGroupPool_t, true> m_bindGroupPools{ 4 };
+    Pool<VulkanGraphicsPipeline, GraphicsPipeline_t, true> m_graphicsPipelines{ 64 };
+    Pool<VulkanComputePipeline, ComputePipeline_t, true> m_computePipelines{ 64 };
+    Pool<VulkanRayTracingPipeline, RayTracingPipeline_t, true> m_rayTracingPipelines{ 64 };
+    Pool<VulkanGpuSemaphore, GpuSemaphore_t, true> m_gpuSemaphores{ 32 };
+    Pool<VulkanCommandRecorder, CommandRecorder_t, true> m_commandRecorders{ 32 };
+    Pool<VulkanRenderPassCommandRecorder, RenderPassCommandRecorder_t, true> m_renderPassCommandRecorders{ 32 };
+    Pool<VulkanComputePassCommandRecorder, ComputePassCommandRecorder_t, true> m_computePassCommandRecorders{ 32 };
+    Pool<VulkanRayTracingPassCommandRecorder, RayTracingPassCommandRecorder_t, true> m_rayTracingPassCommandRecorders{ 32 };
+    Pool<VulkanCommandBuffer, CommandBuffer_t, true> m_commandBuffers{ 128 };
+    Pool<VulkanCommandPool, CommandPool_t, true> m_commandPools{ 8 };
+    Pool<VulkanRenderPass, RenderPass_t, true> m_renderPasses{ 16 };
+    Pool<VulkanFramebuffer, Framebuffer_t, true> m_framebuffers{ 16 };
+    Pool<VulkanSampler, Sampler_t, true> m_samplers{ 16 };
+    Pool<VulkanFence, Fence_t, true> m_fences{ 16 };
+    Pool<VulkanTimestampQueryRecorder, TimestampQueryRecorder_t, true> m_timestampQueryRecorders{ 4 };
+    Pool<VulkanAccelerationStructure, AccelerationStructure_t, true> m_accelerationStructures{ 32 };
+    Pool<VulkanYCbCrConversion, YCbCrConversion_t, true> m_yCbCrConversions{ 16 };
     struct TimestampQueryBucket {
         uint32_t start;
         uint32_t count;
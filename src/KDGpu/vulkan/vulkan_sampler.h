@@ -12,6 +12,7 @@
 
 #include <KDGpu/handle.h>
 #include <KDGpu/kdgpu_export.h>
+#include <KDGpu/sampler_options.h>
 #include <vulkan/vulkan.h>
 
 namespace KDGpu {
@@ -30,6 +31,8 @@ struct KDGPU_EXPORT VulkanSampler {
 
     VkSampler sampler{ VK_NULL_HANDLE };
     Handle<Device_t> deviceHandle;
+    SamplerOptions options; // Without label, used as key in VulkanDevice::samplers
+    uint32_t refCount{ 1 }; // Only grows beyond 1 for samplers shared through VulkanDevice::samplers
 };
 
 } // namespace KDGpu
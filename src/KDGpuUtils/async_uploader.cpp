@@ -0,0 +1,107 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/async_uploader.h>
+
+#include <KDGpu/adapter.h>
+#include <KDGpu/adapter_queue_type.h>
+#include <KDGpu/device.h>
+
+#include <KDUtils/logging.h>
+
+namespace KDGpuUtils {
+
+namespace {
+
+bool isTransferOnly(KDGpu::QueueFlags flags)
+{
+    return flags.testFlag(KDGpu::QueueFlagBits::TransferBit) &&
+            !flags.testFlag(KDGpu::QueueFlagBits::GraphicsBit) &&
+            !flags.testFlag(KDGpu::QueueFlagBits::ComputeBit);
+}
+
+bool isTransferWithoutGraphics(KDGpu::QueueFlags flags)
+{
+    return flags.testFlag(KDGpu::QueueFlagBits::TransferBit) && !flags.testFlag(KDGpu::QueueFlagBits::GraphicsBit);
+}
+
+} // namespace
+
+AsyncUploader::AsyncUploader(KDGpu::Device *device, KDGpu::Queue *transferQueue, KDGpu::Queue *graphicsQueue, size_t maxBatchesInFlight)
+    : m_uploader(device, transferQueue, maxBatchesInFlight, graphicsQueue)
+{
+    if (!m_uploader.transfersOwnership())
+        SPDLOG_WARN("AsyncUploader transfer and graphics queues are of the same type, uploads won't overlap with rendering");
+
+    m_semaphores.reserve(maxBatchesInFlight);
+    for (size_t i = 0; i < maxBatchesInFlight; ++i)
+        m_semaphores.emplace_back(device->createGpuSemaphore());
+}
+
+AsyncUploader::~AsyncUploader()
+{
+    waitUntilIdle();
+}
+
+std::optional<uint32_t> AsyncUploader::findTransferQueueTypeIndex(const KDGpu::Adapter *adapter)
+{
+    const auto queueTypes = adapter->queueTypes();
+    for (uint32_t i = 0; i < queueTypes.size(); ++i) {
+        if (isTransferOnly(queueTypes[i].flags))
+            return i;
+    }
+    for (uint32_t i = 0; i < queueTypes.size(); ++i) {
+        if (isTransferWithoutGraphics(queueTypes[i].flags))
+            return i;
+    }
+    return std::nullopt;
+}
+
+KDGpu::Queue *AsyncUploader::findTransferQueue(KDGpu::Device *device)
+{
+    KDGpu::Queue *fallback = nullptr;
+    for (KDGpu::Queue &queue : device->queues()) {
+        if (isTransferOnly(queue.flags()))
+            return &queue;
+        if (fallback == nullptr && isTransferWithoutGraphics(queue.flags()))
+            fallback = &queue;
+    }
+    return fallback;
+}
+
+void AsyncUploader::uploadBufferData(const KDGpu::BufferUploadOptions &options)
+{
+    m_uploader.uploadBufferData(options);
+}
+
+void AsyncUploader::uploadTextureData(const KDGpu::TextureUploadOptions &options, KDGpu::DeviceSize texelBlockSize)
+{
+    m_uploader.uploadTextureData(options, texelBlockSize);
+}
+
+KDGpu::Handle<KDGpu::GpuSemaphore_t> AsyncUploader::submit()
+{
+    const KDGpu::Handle<KDGpu::GpuSemaphore_t> semaphore = m_semaphores[m_uploader.batchIndex()];
+    if (!m_uploader.submit({ semaphore }).isValid())
+        return {};
+    return semaphore;
+}
+
+void AsyncUploader::recordAcquireBarriers(const KDGpu::CommandRecorder &commandRecorder)
+{
+    m_uploader.recordAcquireBarriers(commandRecorder);
+}
+
+void AsyncUploader::waitUntilIdle()
+{
+    m_uploader.waitUntilIdle();
+}
+
+} // namespace KDGpuUtils
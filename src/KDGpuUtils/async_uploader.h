@@ -0,0 +1,84 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpuUtils/kdgpuutils_export.h>
+#include <KDGpuUtils/batched_uploader.h>
+
+#include <KDGpu/gpu_semaphore.h>
+#include <KDGpu/handle.h>
+
+#include <optional>
+#include <vector>
+
+namespace KDGpu {
+class Adapter;
+class Device;
+} // namespace KDGpu
+
+namespace KDGpuUtils {
+
+/**
+ * @brief Streams uploads through a dedicated transfer queue
+ *
+ * Uploads are batched by a BatchedUploader recording on a transfer queue, so
+ * that copies run on the DMA engine of the GPU, when it has one, and overlap
+ * with the rendering happening on the graphics queue.
+ *
+ * Each submit() releases ownership of the uploaded resources to the queue type
+ * of the graphicsQueue and returns a semaphore signalled once the batch is
+ * done. The next submission to the graphicsQueue that uses the resources has to
+ * wait on that semaphore and start with the barriers recorded by
+ * recordAcquireBarriers(). A semaphore is reused maxBatchesInFlight submits
+ * later, by which time it has to have been waited on.
+ *
+ * The transfer queue has to have been requested when creating the Device, see
+ * findTransferQueueTypeIndex().
+ */
+class KDGPUUTILS_EXPORT AsyncUploader
+{
+public:
+    AsyncUploader(KDGpu::Device *device, KDGpu::Queue *transferQueue, KDGpu::Queue *graphicsQueue, size_t maxBatchesInFlight = 2);
+    ~AsyncUploader();
+
+    AsyncUploader(AsyncUploader const &other) = delete;
+    AsyncUploader &operator=(AsyncUploader const &other) = delete;
+
+    AsyncUploader(AsyncUploader &&other) = delete;
+    AsyncUploader &operator=(AsyncUploader &&other) = delete;
+
+    // Index of a queue type only supporting transfers, falling back to one supporting transfers but not graphics.
+    // Meant to fill a QueueRequest of the DeviceOptions.
+    static std::optional<uint32_t> findTransferQueueTypeIndex(const KDGpu::Adapter *adapter);
+    // The first queue of the device created for such a queue type, nullptr if there are none
+    static KDGpu::Queue *findTransferQueue(KDGpu::Device *device);
+
+    void uploadBufferData(const KDGpu::BufferUploadOptions &options);
+    void uploadTextureData(const KDGpu::TextureUploadOptions &options, KDGpu::DeviceSize texelBlockSize);
+
+    // Submits the uploads recorded since the last submit on the transfer queue and returns the semaphore
+    // the graphics queue has to wait on. Returns an invalid handle if there was nothing to upload.
+    KDGpu::Handle<KDGpu::GpuSemaphore_t> submit();
+
+    // Records the ownership acquire barriers for all the batches submitted since the last call.
+    // Must be recorded into a command buffer submitted to the graphicsQueue.
+    void recordAcquireBarriers(const KDGpu::CommandRecorder &commandRecorder);
+
+    void waitUntilIdle();
+
+    const BatchedUploader &batchedUploader() const noexcept { return m_uploader; }
+
+private:
+    BatchedUploader m_uploader;
+    std::vector<KDGpu::GpuSemaphore> m_semaphores; // One per batch slot
+};
+
+} // namespace KDGpuUtils
@@ -0,0 +1,263 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/batched_uploader.h>
+
+#include <KDGpu/device.h>
+#include <KDGpu/memory_barrier.h>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+namespace KDGpuUtils {
+
+namespace {
+
+KDGpu::TextureSubresourceRange createRangeFromRegions(const std::vector<KDGpu::BufferTextureCopyRegion> &regions)
+{
+    const auto maxMipLayerPair = std::accumulate(
+            regions.begin(), regions.end(), std::make_pair(0U, 0U),
+            [](std::pair<uint32_t, uint32_t> acc, const KDGpu::BufferTextureCopyRegion &region) {
+                return std::make_pair(std::max(acc.first, region.textureSubResource.mipLevel),
+                                      std::max(acc.second, region.textureSubResource.baseArrayLayer));
+            });
+
+    return KDGpu::TextureSubresourceRange{
+        .aspectMask = KDGpu::TextureAspectFlags(regions.empty() ? KDGpu::TextureAspectFlagBits::ColorBit : regions.front().textureSubResource.aspectMask),
+        .levelCount = maxMipLayerPair.first + 1,
+        .layerCount = maxMipLayerPair.second + 1
+    };
+}
+
+} // namespace
+
+BatchedUploader::BatchedUploader(KDGpu::Device *device, KDGpu::Queue *queue, size_t maxBatchesInFlight, KDGpu::Queue *destinationQueue)
+    : m_device{ device }
+    , m_queue{ queue }
+    , m_deleter{ device, maxBatchesInFlight }
+    , m_batches(maxBatchesInFlight)
+{
+    assert(maxBatchesInFlight > 0);
+    // Queues of the same type share ownership of resources
+    if (destinationQueue != nullptr && destinationQueue->queueTypeIndex() != queue->queueTypeIndex()) {
+        m_srcQueueTypeIndex = queue->queueTypeIndex();
+        m_dstQueueTypeIndex = destinationQueue->queueTypeIndex();
+    }
+    for (Batch &batch : m_batches) {
+        batch.stagingPool = std::make_unique<StagingBufferPool>(m_device, &m_deleter);
+        batch.fence = m_device->createFence(KDGpu::FenceOptions{ .createSignalled = false });
+    }
+}
+
+BatchedUploader::~BatchedUploader()
+{
+    waitUntilIdle();
+    // Pools release their bins through the deleter, destroy them first
+    for (Batch &batch : m_batches)
+        batch.stagingPool.reset();
+}
+
+KDGpu::CommandRecorder &BatchedUploader::recorder()
+{
+    if (!m_recorder.has_value()) {
+        // Reclaim the slot we are about to record into
+        recycle(m_batches[m_batchIndex]);
+        m_recorder.emplace(m_device->createCommandRecorder(KDGpu::CommandRecorderOptions{ .queue = m_queue->handle() }));
+    }
+    return *m_recorder;
+}
+
+void BatchedUploader::recycle(Batch &batch)
+{
+    if (!batch.inFlight)
+        return;
+
+    batch.fence.wait();
+    batch.fence.reset();
+    batch.inFlight = false;
+
+    m_deleter.derefFrameIndex(m_batchIndex);
+    batch.stagingPool->moveToNextFrame();
+    batch.commandBuffer = {};
+}
+
+void BatchedUploader::uploadBufferData(const KDGpu::BufferUploadOptions &options)
+{
+    if (options.byteSize == 0)
+        return;
+
+    KDGpu::CommandRecorder &commandRecorder = recorder();
+    const auto [offset, stagingBuffer] = m_batches[m_batchIndex].stagingPool->stage(options.data, options.byteSize);
+
+    commandRecorder.copyBuffer(KDGpu::BufferCopy{
+            .src = stagingBuffer,
+            .srcOffset = offset,
+            .dst = options.destinationBuffer,
+            .dstOffset = options.dstOffset,
+            .byteSize = options.byteSize,
+    });
+
+    if (transfersOwnership()) {
+        // Release the written range to the destination queue, which has to acquire it with the same barrier
+        KDGpu::BufferMemoryBarrierOptions barrier{
+            .srcStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TransferBit),
+            .srcMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::TransferWriteBit),
+            .dstStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::BottomOfPipeBit),
+            .srcQueueTypeIndex = m_srcQueueTypeIndex,
+            .dstQueueTypeIndex = m_dstQueueTypeIndex,
+            .buffer = options.destinationBuffer,
+            .offset = options.dstOffset,
+            .size = options.byteSize,
+        };
+        commandRecorder.bufferMemoryBarrier(barrier);
+
+        barrier.srcStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TopOfPipeBit);
+        barrier.srcMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::None);
+        barrier.dstStages = options.dstStages;
+        barrier.dstMask = options.dstMask;
+        m_pendingBufferAcquires.push_back(barrier);
+    } else {
+        // A single barrier covering all the buffer copies is recorded on submit
+        m_bufferDstStages |= options.dstStages;
+        m_bufferDstMask |= options.dstMask;
+    }
+    ++m_pendingUploadCount;
+}
+
+void BatchedUploader::uploadTextureData(const KDGpu::TextureUploadOptions &options, KDGpu::DeviceSize texelBlockSize)
+{
+    if (options.byteSize == 0)
+        return;
+    assert(texelBlockSize > 0);
+
+    // Offsets of buffer to texture copies have to be a multiple of both the texel block size and 4
+    const size_t alignment = std::lcm<size_t>(texelBlockSize, 4);
+
+    KDGpu::CommandRecorder &commandRecorder = recorder();
+    const auto [offset, stagingBuffer] = m_batches[m_batchIndex].stagingPool->stage(options.data, options.byteSize, alignment);
+
+    // Find a suitable subresource we will be copying and transitioning
+    const KDGpu::TextureSubresourceRange range = options.range.aspectMask == KDGpu::TextureAspectFlagBits::None ? createRangeFromRegions(options.regions) : options.range;
+
+    commandRecorder.textureMemoryBarrier(KDGpu::TextureMemoryBarrierOptions{
+            .srcStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TopOfPipeBit),
+            .dstStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TransferBit),
+            .dstMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::TransferWriteBit),
+            .oldLayout = options.oldLayout,
+            .newLayout = KDGpu::TextureLayout::TransferDstOptimal,
+            .texture = options.destinationTexture,
+            .range = range,
+    });
+
+    // Regions are relative to the start of the uploaded data
+    std::vector<KDGpu::BufferTextureCopyRegion> regions = options.regions;
+    for (KDGpu::BufferTextureCopyRegion &region : regions)
+        region.bufferOffset += offset;
+
+    commandRecorder.copyBufferToTexture(KDGpu::BufferToTextureCopy{
+            .srcBuffer = stagingBuffer,
+            .dstTexture = options.destinationTexture,
+            .dstTextureLayout = KDGpu::TextureLayout::TransferDstOptimal,
+            .regions = std::move(regions),
+    });
+
+    // Finally, we transition the texture to the specified final layout. When transferring ownership, the
+    // transition is part of the release and has to be repeated identically by the acquire barrier.
+    KDGpu::TextureMemoryBarrierOptions toFinalLayout{
+        .srcStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TransferBit),
+        .srcMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::TransferWriteBit),
+        .dstStages = options.dstStages,
+        .dstMask = options.dstMask,
+        .oldLayout = KDGpu::TextureLayout::TransferDstOptimal,
+        .newLayout = options.newLayout,
+        .texture = options.destinationTexture,
+        .range = range,
+    };
+    if (transfersOwnership()) {
+        KDGpu::TextureMemoryBarrierOptions release = toFinalLayout;
+        release.dstStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::BottomOfPipeBit);
+        release.dstMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::None);
+        release.srcQueueTypeIndex = m_srcQueueTypeIndex;
+        release.dstQueueTypeIndex = m_dstQueueTypeIndex;
+        commandRecorder.textureMemoryBarrier(release);
+
+        toFinalLayout.srcStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TopOfPipeBit);
+        toFinalLayout.srcMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::None);
+        toFinalLayout.srcQueueTypeIndex = m_srcQueueTypeIndex;
+        toFinalLayout.dstQueueTypeIndex = m_dstQueueTypeIndex;
+        m_pendingTextureAcquires.push_back(toFinalLayout);
+    } else {
+        commandRecorder.textureMemoryBarrier(toFinalLayout);
+    }
+    ++m_pendingUploadCount;
+}
+
+KDGpu::Handle<KDGpu::Fence_t> BatchedUploader::submit(const std::vector<KDGpu::Handle<KDGpu::GpuSemaphore_t>> &signalSemaphores)
+{
+    if (!m_recorder.has_value())
+        return {};
+
+    Batch &batch = m_batches[m_batchIndex];
+    batch.stagingPool->flush();
+
+    if (m_bufferDstStages) {
+        m_recorder->memoryBarrier(KDGpu::MemoryBarrierOptions{
+                .srcStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TransferBit),
+                .dstStages = m_bufferDstStages,
+                .memoryBarriers = { { .srcMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::TransferWriteBit),
+                                      .dstMask = m_bufferDstMask } },
+        });
+    }
+
+    batch.commandBuffer = m_recorder->finish();
+    m_recorder.reset();
+
+    m_queue->submit(KDGpu::SubmitOptions{
+            .commandBuffers = { batch.commandBuffer },
+            .signalSemaphores = signalSemaphores,
+            .signalFence = batch.fence,
+    });
+    batch.inFlight = true;
+
+    // Staging bins dropped by the pools from now on belong to the next batch
+    m_deleter.moveToNextFrame();
+
+    m_submittedBufferAcquires.insert(m_submittedBufferAcquires.end(), m_pendingBufferAcquires.begin(), m_pendingBufferAcquires.end());
+    m_submittedTextureAcquires.insert(m_submittedTextureAcquires.end(), m_pendingTextureAcquires.begin(), m_pendingTextureAcquires.end());
+    m_pendingBufferAcquires.clear();
+    m_pendingTextureAcquires.clear();
+
+    m_pendingUploadCount = 0;
+    m_bufferDstStages = {};
+    m_bufferDstMask = {};
+    m_batchIndex = (m_batchIndex + 1) % m_batches.size();
+    return batch.fence;
+}
+
+void BatchedUploader::waitUntilIdle()
+{
+    for (Batch &batch : m_batches) {
+        if (batch.inFlight)
+            batch.fence.wait();
+    }
+}
+
+void BatchedUploader::recordAcquireBarriers(const KDGpu::CommandRecorder &commandRecorder)
+{
+    for (const KDGpu::BufferMemoryBarrierOptions &barrier : m_submittedBufferAcquires)
+        commandRecorder.bufferMemoryBarrier(barrier);
+    for (const KDGpu::TextureMemoryBarrierOptions &barrier : m_submittedTextureAcquires)
+        commandRecorder.textureMemoryBarrier(barrier);
+    m_submittedBufferAcquires.clear();
+    m_submittedTextureAcquires.clear();
+}
+
+} // namespace KDGpuUtils
@@ -0,0 +1,121 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpuUtils/kdgpuutils_export.h>
+#include <KDGpuUtils/resource_deleter.h>
+#include <KDGpuUtils/staging_buffer_pool.h>
+
+#include <KDGpu/buffer.h>
+#include <KDGpu/command_buffer.h>
+#include <KDGpu/command_recorder.h>
+#include <KDGpu/fence.h>
+#include <KDGpu/handle.h>
+#include <KDGpu/memory_barrier.h>
+#include <KDGpu/queue.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace KDGpu {
+class Device;
+struct GpuSemaphore_t;
+} // namespace KDGpu
+
+namespace KDGpuUtils {
+
+/**
+ * @brief Batches buffer and texture uploads into a single submission
+ *
+ * Queue::uploadBufferData() and Queue::uploadTextureData() create a staging
+ * Buffer, a CommandRecorder and a Fence for every call. The BatchedUploader
+ * instead copies the data into bins of a StagingBufferPool and records all the
+ * copies made until submit() into one command buffer, which is submitted with
+ * a single Fence.
+ *
+ * Up to maxBatchesInFlight batches can be pending on the GPU. Each batch slot
+ * owns its staging bins, which are only recycled once the fence of the batch
+ * last submitted from that slot has signalled.
+ *
+ * When a destinationQueue from another queue type is given, the uploaded
+ * resources are released to it at the end of each batch. The matching acquire
+ * barriers have to be recorded with recordAcquireBarriers() into a command
+ * buffer submitted to destinationQueue once the batch has completed, usually by
+ * having that submission wait on a semaphore passed to submit().
+ *
+ * A BatchedUploader must only be used from one thread at a time.
+ */
+class KDGPUUTILS_EXPORT BatchedUploader
+{
+public:
+    BatchedUploader(KDGpu::Device *device, KDGpu::Queue *queue, size_t maxBatchesInFlight = 2, KDGpu::Queue *destinationQueue = nullptr);
+    ~BatchedUploader();
+
+    BatchedUploader(BatchedUploader const &other) = delete;
+    BatchedUploader &operator=(BatchedUploader const &other) = delete;
+
+    BatchedUploader(BatchedUploader &&other) = delete;
+    BatchedUploader &operator=(BatchedUploader &&other) = delete;
+
+    // Stage the data and record the copies into the current batch. Nothing reaches the GPU before submit().
+    // texelBlockSize is the size in bytes of a texel (or of a block for compressed formats) of the destination
+    // texture's format, which the staging offset of the texture data has to be aligned to.
+    void uploadBufferData(const KDGpu::BufferUploadOptions &options);
+    void uploadTextureData(const KDGpu::TextureUploadOptions &options, KDGpu::DeviceSize texelBlockSize);
+
+    // Submits all the uploads recorded since the last submit and returns the fence signalled once they have completed.
+    // Returns an invalid handle if there was nothing to upload. May block if all batch slots are still in flight.
+    KDGpu::Handle<KDGpu::Fence_t> submit(const std::vector<KDGpu::Handle<KDGpu::GpuSemaphore_t>> &signalSemaphores = {});
+
+    // Blocks until all submitted batches have completed
+    void waitUntilIdle();
+
+    // Records the queue ownership acquire barriers of all the batches submitted since the last call.
+    // Only needed when transferring ownership to the destinationQueue.
+    void recordAcquireBarriers(const KDGpu::CommandRecorder &commandRecorder);
+    bool transfersOwnership() const noexcept { return m_dstQueueTypeIndex != KDGpu::IgnoreQueueType; }
+
+    size_t pendingUploadCount() const noexcept { return m_pendingUploadCount; }
+    size_t batchIndex() const noexcept { return m_batchIndex; }
+    size_t maxBatchesInFlight() const noexcept { return m_batches.size(); }
+
+private:
+    struct Batch {
+        std::unique_ptr<StagingBufferPool> stagingPool;
+        KDGpu::Fence fence;
+        KDGpu::CommandBuffer commandBuffer;
+        bool inFlight{ false };
+    };
+
+    KDGpu::CommandRecorder &recorder();
+    void recycle(Batch &batch);
+
+    KDGpu::Device *m_device{ nullptr };
+    KDGpu::Queue *m_queue{ nullptr };
+    ResourceDeleter m_deleter;
+    std::vector<Batch> m_batches;
+    size_t m_batchIndex{ 0 };
+    std::optional<KDGpu::CommandRecorder> m_recorder;
+    size_t m_pendingUploadCount{ 0 };
+    KDGpu::PipelineStageFlags m_bufferDstStages;
+    KDGpu::AccessFlags m_bufferDstMask;
+
+    uint32_t m_srcQueueTypeIndex{ KDGpu::IgnoreQueueType };
+    uint32_t m_dstQueueTypeIndex{ KDGpu::IgnoreQueueType };
+    // Acquire barriers for the batch being recorded and for the batches already submitted
+    std::vector<KDGpu::BufferMemoryBarrierOptions> m_pendingBufferAcquires;
+    std::vector<KDGpu::TextureMemoryBarrierOptions> m_pendingTextureAcquires;
+    std::vector<KDGpu::BufferMemoryBarrierOptions> m_submittedBufferAcquires;
+    std::vector<KDGpu::TextureMemoryBarrierOptions> m_submittedTextureAcquires;
+};
+
+} // namespace KDGpuUtils
@@ -0,0 +1,207 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/concurrent_staging_buffer_pool.h>
+#include <KDGpuUtils/resource_deleter.h>
+
+#include <KDGpu/buffer_options.h>
+#include <KDGpu/device.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace KDGpuUtils {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+ConcurrentStagingBufferPool::ConcurrentStagingBufferPool(KDGpu::Device *device, ResourceDeleter *deleter, const ConcurrentStagingBufferPoolOptions &options)
+    : m_device{ device }
+    , m_deleter{ deleter }
+    , m_binSize{ options.binSize }
+    , m_maxFreeBinCount{ options.maxFreeBinCount }
+{
+}
+
+ConcurrentStagingBufferPool::~ConcurrentStagingBufferPool()
+{
+    for (auto &bin : m_bins)
+        m_deleter->deleteLater(std::move(bin->buffer));
+}
+
+StagingRegion ConcurrentStagingBufferPool::allocate(size_t byteSize, size_t alignment)
+{
+    assert(alignment > 0);
+    // Reserving the worst case padding lets the cursor be bumped without knowing where it currently is
+    const size_t reservedSize = byteSize + alignment - 1;
+
+    if (reservedSize > m_binSize) {
+        // Too large for a bin, give it a bin of its own
+        std::lock_guard lock(m_binsMutex);
+        Bin *bin = createBin(byteSize);
+        if (bin == nullptr)
+            return {};
+        bin->cursor = byteSize;
+        return StagingRegion{ .buffer = bin->buffer.handle(), .offset = 0, .size = byteSize, .data = bin->mapped };
+    }
+
+    Bin *bin = m_currentBin.load(std::memory_order_acquire);
+    while (true) {
+        if (bin != nullptr) {
+            const size_t start = bin->cursor.fetch_add(reservedSize, std::memory_order_relaxed);
+            if (start + reservedSize <= bin->size) {
+                const size_t offset = alignUp(start, alignment);
+                return StagingRegion{ .buffer = bin->buffer.handle(), .offset = offset, .size = byteSize, .data = bin->mapped + offset };
+            }
+        }
+
+        // Bin exhausted (or none yet), whichever thread gets the lock first installs a new one
+        bin = replaceCurrentBin(bin);
+        if (bin == nullptr)
+            return {};
+    }
+}
+
+StagingRegion ConcurrentStagingBufferPool::stage(const void *data, size_t byteSize, size_t alignment)
+{
+    const StagingRegion region = allocate(byteSize, alignment);
+    if (region.isValid())
+        std::memcpy(region.data, data, byteSize);
+    return region;
+}
+
+ConcurrentStagingBufferPool::Bin *ConcurrentStagingBufferPool::replaceCurrentBin(Bin *exhaustedBin)
+{
+    std::lock_guard lock(m_binsMutex);
+
+    // Another thread already replaced it
+    Bin *currentBin = m_currentBin.load(std::memory_order_acquire);
+    if (currentBin != exhaustedBin)
+        return currentBin;
+
+    Bin *bin = nullptr;
+    if (!m_freeBins.empty()) {
+        bin = m_freeBins.back();
+        m_freeBins.pop_back();
+        bin->frameIndex = m_frameIndex;
+    } else {
+        bin = createBin(m_binSize);
+        if (bin == nullptr)
+            return nullptr;
+    }
+
+    m_currentBin.store(bin, std::memory_order_release);
+    return bin;
+}
+
+ConcurrentStagingBufferPool::Bin *ConcurrentStagingBufferPool::createBin(size_t size)
+{
+    auto bin = std::make_unique<Bin>();
+    bin->buffer = m_device->createBuffer(KDGpu::BufferOptions{
+            .size = size,
+            .usage = KDGpu::BufferUsageFlagBits::TransferSrcBit,
+            .memoryUsage = KDGpu::MemoryUsage::CpuOnly,
+            .persistentlyMapped = true, // Written to by worker threads for as long as the bin lives
+    });
+    bin->mapped = static_cast<uint8_t *>(bin->buffer.map());
+    if (bin->mapped == nullptr)
+        return nullptr;
+    bin->size = size;
+    bin->frameIndex = m_frameIndex;
+    return m_bins.emplace_back(std::move(bin)).get();
+}
+
+void ConcurrentStagingBufferPool::enqueueBufferCopy(const StagingRegion &region, const KDGpu::Handle<KDGpu::Buffer_t> &dst, size_t dstOffset)
+{
+    const KDGpu::BufferCopy copy{
+        .src = region.buffer,
+        .srcOffset = region.offset,
+        .dst = dst,
+        .dstOffset = dstOffset,
+        .byteSize = region.size,
+    };
+    std::lock_guard lock(m_copiesMutex);
+    m_bufferCopies.push_back(copy);
+}
+
+void ConcurrentStagingBufferPool::enqueueTextureCopy(const StagingRegion &region, const KDGpu::Handle<KDGpu::Texture_t> &dst,
+                                                     KDGpu::TextureLayout dstTextureLayout, std::vector<KDGpu::BufferTextureCopyRegion> regions)
+{
+    for (KDGpu::BufferTextureCopyRegion &copyRegion : regions)
+        copyRegion.bufferOffset += region.offset;
+
+    KDGpu::BufferToTextureCopy copy{
+        .srcBuffer = region.buffer,
+        .dstTexture = dst,
+        .dstTextureLayout = dstTextureLayout,
+        .regions = std::move(regions),
+    };
+    std::lock_guard lock(m_copiesMutex);
+    m_textureCopies.push_back(std::move(copy));
+}
+
+size_t ConcurrentStagingBufferPool::recordCopies(const KDGpu::CommandRecorder &commandRecorder)
+{
+    std::vector<KDGpu::BufferCopy> bufferCopies;
+    std::vector<KDGpu::BufferToTextureCopy> textureCopies;
+    {
+        std::lock_guard lock(m_copiesMutex);
+        bufferCopies.swap(m_bufferCopies);
+        textureCopies.swap(m_textureCopies);
+    }
+
+    for (const KDGpu::BufferCopy &copy : bufferCopies)
+        commandRecorder.copyBuffer(copy);
+    for (const KDGpu::BufferToTextureCopy &copy : textureCopies)
+        commandRecorder.copyBufferToTexture(copy);
+    return bufferCopies.size() + textureCopies.size();
+}
+
+void ConcurrentStagingBufferPool::derefFrameIndex(size_t frameIndex)
+{
+    std::lock_guard lock(m_binsMutex);
+    m_frameIndex = frameIndex;
+
+    // The current bin belongs to the previous frame, start the new frame with a fresh one
+    m_currentBin.store(nullptr, std::memory_order_release);
+
+    for (auto it = m_bins.begin(); it != m_bins.end();) {
+        Bin *bin = it->get();
+        const bool isFree = std::find(m_freeBins.begin(), m_freeBins.end(), bin) != m_freeBins.end();
+        if (bin->frameIndex != frameIndex || isFree) {
+            ++it;
+            continue;
+        }
+
+        if (bin->size == m_binSize && m_freeBins.size() < m_maxFreeBinCount) {
+            bin->cursor = 0;
+            m_freeBins.push_back(bin);
+            ++it;
+        } else {
+            m_deleter->deleteLater(std::move(bin->buffer));
+            it = m_bins.erase(it);
+        }
+    }
+}
+
+size_t ConcurrentStagingBufferPool::binCount() const
+{
+    std::lock_guard lock(m_binsMutex);
+    return m_bins.size();
+}
+
+} // namespace KDGpuUtils
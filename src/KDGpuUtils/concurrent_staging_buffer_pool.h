@@ -0,0 +1,126 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpuUtils/kdgpuutils_export.h>
+
+#include <KDGpu/buffer.h>
+#include <KDGpu/command_recorder.h>
+#include <KDGpu/handle.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace KDGpu {
+class Device;
+struct Texture_t;
+} // namespace KDGpu
+
+namespace KDGpuUtils {
+
+class ResourceDeleter;
+
+struct ConcurrentStagingBufferPoolOptions {
+    size_t binSize{ 2 * 1024 * 1024 };
+    // Empty bins kept around for reuse, others are released when their frame is dereferenced
+    size_t maxFreeBinCount{ 4 };
+};
+
+struct StagingRegion {
+    KDGpu::Handle<KDGpu::Buffer_t> buffer;
+    size_t offset{ 0 }; // in bytes, within buffer
+    size_t size{ 0 }; // in bytes
+    // Mapped memory where the content of the region has to be written to
+    void *data{ nullptr };
+
+    bool isValid() const noexcept { return data != nullptr; }
+};
+
+/**
+ * @brief Staging memory that several threads can write into concurrently
+ *
+ * allocate() can be called from any thread. It claims a region of the mapped
+ * bin currently in use with an atomic fetch-add on the bin's cursor, so that
+ * worker threads can decode their data straight into staging memory without
+ * taking a lock. Only replacing an exhausted bin goes through a mutex.
+ *
+ * Once a region has been written, the worker enqueues the copy out of it with
+ * enqueueBufferCopy() or enqueueTextureCopy(). At submit time, the thread
+ * owning the CommandRecorder records all the enqueued copies with recordCopies().
+ *
+ * Bins are tagged with the frame index they were used in and only recycled once
+ * derefFrameIndex() comes back to that frame index. derefFrameIndex() must not
+ * be called while other threads are allocating.
+ */
+class KDGPUUTILS_EXPORT ConcurrentStagingBufferPool
+{
+public:
+    ConcurrentStagingBufferPool(KDGpu::Device *device, ResourceDeleter *deleter, const ConcurrentStagingBufferPoolOptions &options = {});
+    ~ConcurrentStagingBufferPool();
+
+    ConcurrentStagingBufferPool(ConcurrentStagingBufferPool const &other) = delete;
+    ConcurrentStagingBufferPool &operator=(ConcurrentStagingBufferPool const &other) = delete;
+
+    ConcurrentStagingBufferPool(ConcurrentStagingBufferPool &&other) = delete;
+    ConcurrentStagingBufferPool &operator=(ConcurrentStagingBufferPool &&other) = delete;
+
+    // Thread safe. Regions larger than a bin get a bin of their own. The offset is a multiple of alignment.
+    StagingRegion allocate(size_t byteSize, size_t alignment = 1);
+    // Thread safe. Allocates a region and copies data into it.
+    StagingRegion stage(const void *data, size_t byteSize, size_t alignment = 1);
+
+    // Thread safe. The copies are recorded by the next call to recordCopies().
+    void enqueueBufferCopy(const StagingRegion &region, const KDGpu::Handle<KDGpu::Buffer_t> &dst, size_t dstOffset = 0);
+    // Region buffer offsets are relative to the start of the StagingRegion. The texture has to be in dstTextureLayout.
+    void enqueueTextureCopy(const StagingRegion &region, const KDGpu::Handle<KDGpu::Texture_t> &dst,
+                            KDGpu::TextureLayout dstTextureLayout, std::vector<KDGpu::BufferTextureCopyRegion> regions);
+
+    // Records the copies enqueued so far and returns how many were recorded
+    size_t recordCopies(const KDGpu::CommandRecorder &commandRecorder);
+
+    // Recycles the bins of frameIndex, see ResourceDeleter::derefFrameIndex()
+    void derefFrameIndex(size_t frameIndex);
+    size_t frameIndex() const noexcept { return m_frameIndex; }
+
+    size_t binCount() const;
+    size_t binSize() const noexcept { return m_binSize; }
+
+private:
+    struct Bin {
+        KDGpu::Buffer buffer;
+        uint8_t *mapped{ nullptr };
+        size_t size{ 0 };
+        size_t frameIndex{ 0 };
+        std::atomic<size_t> cursor{ 0 };
+    };
+
+    Bin *createBin(size_t size);
+    Bin *replaceCurrentBin(Bin *exhaustedBin);
+
+    KDGpu::Device *m_device{ nullptr };
+    ResourceDeleter *m_deleter{ nullptr };
+    size_t m_binSize{ 0 };
+    size_t m_maxFreeBinCount{ 0 };
+    size_t m_frameIndex{ 0 };
+
+    std::atomic<Bin *> m_currentBin{ nullptr };
+    mutable std::mutex m_binsMutex; // Guards the members below
+    std::vector<std::unique_ptr<Bin>> m_bins;
+    std::vector<Bin *> m_freeBins;
+
+    std::mutex m_copiesMutex; // Only held to push or take copy records
+    std::vector<KDGpu::BufferCopy> m_bufferCopies;
+    std::vector<KDGpu::BufferToTextureCopy> m_textureCopies;
+};
+
+} // namespace KDGpuUtils
@@ -0,0 +1,45 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/frame_command_allocator.h>
+
+#include <KDGpu/device.h>
+
+#include <cassert>
+
+namespace KDGpuUtils {
+
+FrameCommandAllocator::FrameCommandAllocator(KDGpu::Device *device, size_t maxFramesInFlight, const KDGpu::Handle<KDGpu::Queue_t> &queue)
+    : m_device{ device }
+    , m_queue{ queue }
+{
+    m_commandPools.reserve(maxFramesInFlight);
+    for (size_t i = 0; i < maxFramesInFlight; ++i)
+        m_commandPools.emplace_back(m_device->createCommandPool(KDGpu::CommandPoolOptions{ .queue = m_queue }));
+}
+
+FrameCommandAllocator::~FrameCommandAllocator() = default;
+
+void FrameCommandAllocator::derefFrameIndex(size_t frameIndex)
+{
+    assert(frameIndex < m_commandPools.size());
+    m_frameIndex = frameIndex;
+    m_commandPools[m_frameIndex].reset();
+}
+
+KDGpu::CommandRecorder FrameCommandAllocator::createCommandRecorder(KDGpu::CommandBufferLevel level)
+{
+    return m_device->createCommandRecorder(KDGpu::CommandRecorderOptions{
+            .queue = m_queue,
+            .level = level,
+            .commandPool = m_commandPools[m_frameIndex] });
+}
+
+} // namespace KDGpuUtils
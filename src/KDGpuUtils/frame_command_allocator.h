@@ -0,0 +1,65 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpuUtils/kdgpuutils_export.h>
+
+#include <KDGpu/command_pool.h>
+#include <KDGpu/command_recorder.h>
+#include <KDGpu/handle.h>
+
+#include <vector>
+
+namespace KDGpu {
+class Device;
+struct Queue_t;
+} // namespace KDGpu
+
+namespace KDGpuUtils {
+
+/**
+ * @brief Hands out CommandRecorders whose command buffers are recycled every frame
+ *
+ * One CommandPool is kept for each frame in flight. Rather than allocating and
+ * freeing a command buffer for every recording, the whole pool of a frame is
+ * reset once the GPU is done with it and its command buffers are reused.
+ *
+ * Like the CommandPools it wraps, a FrameCommandAllocator must only be used
+ * from one thread at a time.
+ */
+class KDGPUUTILS_EXPORT FrameCommandAllocator
+{
+public:
+    FrameCommandAllocator(KDGpu::Device *device, size_t maxFramesInFlight, const KDGpu::Handle<KDGpu::Queue_t> &queue = {});
+    ~FrameCommandAllocator();
+
+    FrameCommandAllocator(FrameCommandAllocator const &other) = delete;
+    FrameCommandAllocator &operator=(FrameCommandAllocator const &other) = delete;
+
+    FrameCommandAllocator(FrameCommandAllocator &&other) = delete;
+    FrameCommandAllocator &operator=(FrameCommandAllocator &&other) = delete;
+
+    // Resets the pool of frameIndex and records into it from now on, see ResourceDeleter::derefFrameIndex()
+    void derefFrameIndex(size_t frameIndex);
+    size_t frameIndex() const noexcept { return m_frameIndex; }
+
+    KDGpu::CommandRecorder createCommandRecorder(KDGpu::CommandBufferLevel level = KDGpu::CommandBufferLevel::Primary);
+
+    const std::vector<KDGpu::CommandPool> &commandPools() const noexcept { return m_commandPools; }
+
+private:
+    KDGpu::Device *m_device{ nullptr };
+    KDGpu::Handle<KDGpu::Queue_t> m_queue;
+    std::vector<KDGpu::CommandPool> m_commandPools;
+    size_t m_frameIndex{ 0 };
+};
+
+} // namespace KDGpuUtils
@@ -0,0 +1,223 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/readback_pool.h>
+
+#include <KDGpu/buffer_options.h>
+#include <KDGpu/device.h>
+#include <KDGpu/fence.h>
+#include <KDGpu/memory_barrier.h>
+#include <KDUtils/logging.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace KDGpuUtils {
+
+namespace {
+
+ReadbackFuture emptyReadback()
+{
+    std::promise<std::span<const std::byte>> promise;
+    promise.set_value({});
+    return promise.get_future();
+}
+
+} // namespace
+
+ReadbackPool::ReadbackPool(KDGpu::Device *device, size_t maxFramesInFlight, size_t maxFreeBufferCount)
+    : m_device{ device }
+    , m_maxFramesInFlight{ maxFramesInFlight }
+    , m_maxFreeBufferCount{ maxFreeBufferCount }
+{
+    assert(maxFramesInFlight > 0);
+}
+
+ReadbackPool::~ReadbackPool() = default;
+
+ReadbackPool::Readback &ReadbackPool::createReadback(size_t byteSize)
+{
+    Readback readback;
+    readback.byteSize = byteSize;
+    readback.frameIndex = m_frameIndex;
+
+    // Recycle a buffer of the same size class if we have one
+    const size_t sizeClass = std::bit_ceil(std::max<size_t>(byteSize, 256));
+    auto it = std::find_if(m_freeBuffers.begin(), m_freeBuffers.end(),
+                           [&](const StagingBuffer &b) { return b.size == sizeClass; });
+    if (it != m_freeBuffers.end()) {
+        readback.staging = std::move(*it);
+        m_freeBuffers.erase(it);
+    } else {
+        readback.staging = StagingBuffer{
+            .buffer = m_device->createBuffer(KDGpu::BufferOptions{
+                    .size = sizeClass,
+                    .usage = KDGpu::BufferUsageFlagBits::TransferDstBit,
+                    .memoryUsage = KDGpu::MemoryUsage::GpuToCpu,
+                    .persistentlyMapped = true,
+            }),
+            .size = sizeClass,
+        };
+    }
+
+    return m_readbacks.emplace_back(std::move(readback));
+}
+
+void ReadbackPool::recordHostReadBarrier(const KDGpu::CommandRecorder &commandRecorder, const Readback &readback)
+{
+    // Make the copy visible to the host once the fence has signalled
+    commandRecorder.bufferMemoryBarrier(KDGpu::BufferMemoryBarrierOptions{
+            .srcStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TransferBit),
+            .srcMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::TransferWriteBit),
+            .dstStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::HostBit),
+            .dstMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::HostReadBit),
+            .buffer = readback.staging.buffer,
+            .size = readback.byteSize,
+    });
+}
+
+ReadbackFuture ReadbackPool::readBuffer(const KDGpu::CommandRecorder &commandRecorder, const ReadbackBufferOptions &options)
+{
+    if (options.byteSize == 0)
+        return emptyReadback();
+
+    Readback &readback = createReadback(options.byteSize);
+
+    if (options.srcStages) {
+        commandRecorder.bufferMemoryBarrier(KDGpu::BufferMemoryBarrierOptions{
+                .srcStages = options.srcStages,
+                .srcMask = options.srcMask,
+                .dstStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TransferBit),
+                .dstMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::TransferReadBit),
+                .buffer = options.srcBuffer,
+                .offset = options.srcOffset,
+                .size = options.byteSize,
+        });
+    }
+
+    commandRecorder.copyBuffer(KDGpu::BufferCopy{
+            .src = options.srcBuffer,
+            .srcOffset = options.srcOffset,
+            .dst = readback.staging.buffer,
+            .byteSize = options.byteSize,
+    });
+    recordHostReadBarrier(commandRecorder, readback);
+
+    return readback.promise.get_future();
+}
+
+ReadbackFuture ReadbackPool::readTexture(const KDGpu::CommandRecorder &commandRecorder, const ReadbackTextureOptions &options)
+{
+    if (options.byteSize == 0 || options.regions.empty())
+        return emptyReadback();
+
+    Readback &readback = createReadback(options.byteSize);
+
+    if (options.srcStages) {
+        // Only makes the writes visible, the texture stays in srcTextureLayout
+        for (const KDGpu::BufferTextureCopyRegion &region : options.regions) {
+            commandRecorder.textureMemoryBarrier(KDGpu::TextureMemoryBarrierOptions{
+                    .srcStages = options.srcStages,
+                    .srcMask = options.srcMask,
+                    .dstStages = KDGpu::PipelineStageFlags(KDGpu::PipelineStageFlagBit::TransferBit),
+                    .dstMask = KDGpu::AccessFlags(KDGpu::AccessFlagBit::TransferReadBit),
+                    .oldLayout = options.srcTextureLayout,
+                    .newLayout = options.srcTextureLayout,
+                    .texture = options.srcTexture,
+                    .range = KDGpu::TextureSubresourceRange{
+                            .aspectMask = region.textureSubResource.aspectMask,
+                            .baseMipLevel = region.textureSubResource.mipLevel,
+                            .levelCount = 1,
+                            .baseArrayLayer = region.textureSubResource.baseArrayLayer,
+                            .layerCount = region.textureSubResource.layerCount,
+                    },
+            });
+        }
+    }
+
+    commandRecorder.copyTextureToBuffer(KDGpu::TextureToBufferCopy{
+            .srcTexture = options.srcTexture,
+            .srcTextureLayout = options.srcTextureLayout,
+            .dstBuffer = readback.staging.buffer,
+            .regions = options.regions,
+    });
+    recordHostReadBarrier(commandRecorder, readback);
+
+    return readback.promise.get_future();
+}
+
+void ReadbackPool::markSubmitted(const KDGpu::Fence &fence)
+{
+    for (Readback &readback : m_readbacks) {
+        if (!readback.resolved && readback.fence == nullptr)
+            readback.fence = &fence;
+    }
+}
+
+void ReadbackPool::resolve(Readback &readback)
+{
+    readback.staging.buffer.invalidate(0, readback.byteSize);
+    const auto *data = static_cast<const std::byte *>(readback.staging.buffer.map());
+    readback.promise.set_value(std::span<const std::byte>(data, readback.byteSize));
+    readback.resolved = true;
+}
+
+size_t ReadbackPool::poll()
+{
+    size_t resolvedCount = 0;
+    for (Readback &readback : m_readbacks) {
+        if (readback.resolved || readback.fence == nullptr)
+            continue;
+        if (readback.fence->status() == KDGpu::FenceStatus::Signalled) {
+            resolve(readback);
+            ++resolvedCount;
+        }
+    }
+    return resolvedCount;
+}
+
+void ReadbackPool::derefFrameIndex(size_t frameIndex)
+{
+    assert(frameIndex < m_maxFramesInFlight);
+    m_frameIndex = frameIndex;
+
+    // Readbacks resolved before this call have had their chance to be read, recycle their buffers
+    for (auto it = m_readbacks.begin(); it != m_readbacks.end();) {
+        if (it->frameIndex == frameIndex && it->resolved) {
+            if (m_freeBuffers.size() < m_maxFreeBufferCount)
+                m_freeBuffers.push_back(std::move(it->staging));
+            it = m_readbacks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // The GPU is done with the frame, resolve what poll() hasn't seen complete yet. Readbacks that
+    // were never marked as submitted hold no data, dropping them breaks their promise instead.
+    for (auto it = m_readbacks.begin(); it != m_readbacks.end();) {
+        if (it->frameIndex != frameIndex || it->resolved) {
+            ++it;
+        } else if (it->fence != nullptr) {
+            resolve(*it);
+            ++it;
+        } else {
+            SPDLOG_WARN("Dropping readback recorded in frame {} which was never marked as submitted", frameIndex);
+            it = m_readbacks.erase(it);
+        }
+    }
+}
+
+size_t ReadbackPool::pendingReadbackCount() const noexcept
+{
+    return std::count_if(m_readbacks.begin(), m_readbacks.end(), [](const Readback &readback) { return !readback.resolved; });
+}
+
+} // namespace KDGpuUtils
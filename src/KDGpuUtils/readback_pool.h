@@ -0,0 +1,134 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpuUtils/kdgpuutils_export.h>
+
+#include <KDGpu/buffer.h>
+#include <KDGpu/command_recorder.h>
+#include <KDGpu/handle.h>
+
+#include <cstddef>
+#include <future>
+#include <span>
+#include <vector>
+
+namespace KDGpu {
+class Device;
+class Fence;
+struct Texture_t;
+} // namespace KDGpu
+
+namespace KDGpuUtils {
+
+struct ReadbackBufferOptions {
+    KDGpu::Handle<KDGpu::Buffer_t> srcBuffer;
+    size_t srcOffset{ 0 };
+    size_t byteSize{ 0 };
+    // Stages and accesses of the writes to srcBuffer the copy has to wait for, no barrier is recorded if empty
+    KDGpu::PipelineStageFlags srcStages;
+    KDGpu::AccessFlags srcMask;
+};
+
+struct ReadbackTextureOptions {
+    KDGpu::Handle<KDGpu::Texture_t> srcTexture;
+    // Layout the texture is in, TransferSrcOptimal or General
+    KDGpu::TextureLayout srcTextureLayout{ KDGpu::TextureLayout::TransferSrcOptimal };
+    // Size of the data covered by the regions, whose buffer offsets are relative to the start of the readback
+    size_t byteSize{ 0 };
+    std::vector<KDGpu::BufferTextureCopyRegion> regions;
+    // Stages and accesses of the writes to srcTexture the copy has to wait for, no barrier is recorded if empty
+    KDGpu::PipelineStageFlags srcStages;
+    KDGpu::AccessFlags srcMask;
+};
+
+using ReadbackFuture = std::future<std::span<const std::byte>>;
+
+/**
+ * @brief Downloads buffer and texture content from the GPU without blocking
+ *
+ * readBuffer() and readTexture() record a copy into a GpuToCpu staging buffer
+ * and return a future which becomes ready, with the mapped content of that
+ * buffer, once the GPU has executed the copy. Staging buffers are kept mapped
+ * and recycled by size class.
+ *
+ * After submitting the command buffer the copies were recorded into,
+ * markSubmitted() tells the pool which fence to watch. poll() resolves the
+ * futures whose fence has signalled and never blocks. derefFrameIndex()
+ * resolves whatever is left for its frame index, since the GPU is done with it
+ * by then. Readbacks of that frame index which were never marked as submitted
+ * are dropped instead and their futures report a broken promise. Reading back
+ * 0 bytes records nothing and returns a future that is already ready.
+ *
+ * The span stays valid until derefFrameIndex() is called for the frame index
+ * the readback was recorded in, once more after the future became ready.
+ * Futures that were never resolved report a broken promise if the pool is
+ * destroyed first.
+ *
+ * A ReadbackPool must only be used from one thread at a time, the futures can
+ * be waited on from any thread.
+ */
+class KDGPUUTILS_EXPORT ReadbackPool
+{
+public:
+    ReadbackPool(KDGpu::Device *device, size_t maxFramesInFlight, size_t maxFreeBufferCount = 8);
+    ~ReadbackPool();
+
+    ReadbackPool(ReadbackPool const &other) = delete;
+    ReadbackPool &operator=(ReadbackPool const &other) = delete;
+
+    ReadbackPool(ReadbackPool &&other) = delete;
+    ReadbackPool &operator=(ReadbackPool &&other) = delete;
+
+    [[nodiscard]] ReadbackFuture readBuffer(const KDGpu::CommandRecorder &commandRecorder, const ReadbackBufferOptions &options);
+    [[nodiscard]] ReadbackFuture readTexture(const KDGpu::CommandRecorder &commandRecorder, const ReadbackTextureOptions &options);
+
+    // The readbacks recorded since the last call are complete once fence signals. The fence must outlive them.
+    void markSubmitted(const KDGpu::Fence &fence);
+
+    // Resolves the futures whose fence has signalled. Returns how many were resolved.
+    size_t poll();
+
+    // Resolves and recycles the readbacks of frameIndex, see ResourceDeleter::derefFrameIndex()
+    void derefFrameIndex(size_t frameIndex);
+    size_t frameIndex() const noexcept { return m_frameIndex; }
+
+    size_t pendingReadbackCount() const noexcept;
+    size_t freeBufferCount() const noexcept { return m_freeBuffers.size(); }
+
+private:
+    struct StagingBuffer {
+        KDGpu::Buffer buffer;
+        size_t size{ 0 };
+    };
+
+    struct Readback {
+        StagingBuffer staging;
+        size_t byteSize{ 0 };
+        size_t frameIndex{ 0 };
+        const KDGpu::Fence *fence{ nullptr };
+        bool resolved{ false };
+        std::promise<std::span<const std::byte>> promise;
+    };
+
+    Readback &createReadback(size_t byteSize);
+    void resolve(Readback &readback);
+    static void recordHostReadBarrier(const KDGpu::CommandRecorder &commandRecorder, const Readback &readback);
+
+    KDGpu::Device *m_device{ nullptr };
+    size_t m_maxFramesInFlight{ 0 };
+    size_t m_maxFreeBufferCount{ 0 };
+    size_t m_frameIndex{ 0 };
+    std::vector<Readback> m_readbacks;
+    std::vector<StagingBuffer> m_freeBuffers;
+};
+
+} // namespace KDGpuUtils
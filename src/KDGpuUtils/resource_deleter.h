@@ -103,6 +103,9 @@ public:
     void moveToNextFrame();
     uint64_t frameNumber() const noexcept { return m_frameNumber; }
 
+    // Releases what was scheduled the last time frameIndex was current and makes it current again.
+    // As for the derefFrameIndex() of the other frame based helpers of KDGpuUtils, it must only be
+    // called once the fence of the last submission recorded for frameIndex has signalled.
     void derefFrameIndex(size_t frameIndex);
 
     template<typename Resource>
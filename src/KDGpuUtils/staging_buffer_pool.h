@@ -16,8 +16,13 @@
 #include <KDGpu/buffer_options.h>
 #include <KDGpuUtils/resource_deleter.h>
 
-#include <map>
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <span>
 
 constexpr unsigned long long operator""_Mb(unsigned long long const x)
 {
@@ -26,6 +31,12 @@ constexpr unsigned long long operator""_Mb(unsigned long long const x)
 
 namespace KDGpuUtils {
 
+// Bins of BinSize bytes are sub-allocated linearly with a cursor. Each frame index
+// keeps the bin it currently allocates from, a free list of bins with space left
+// and a free list of empty bins, so that picking a bin doesn't have to go through
+// all of them. Payloads larger than BinSize get an oversized bin of their own, sized
+// to the next power of two so that it can be recycled for payloads of the same size class.
+// Oversized bins that weren't used since the previous moveToNextFrame() are released.
 template<uint16_t MinimumBinCount = 1, size_t BinSize = 2_Mb>
 class StagingBufferPoolImpl
 {
@@ -43,8 +54,10 @@ public:
 
     void derefFrameIndex(size_t frameIndex)
     {
-        assert(m_lastBin == nullptr); // Flush should have been called
+        assert(m_mappedBin == NoBin); // Flush should have been called
         m_frameIndex = frameIndex;
+        if (m_frames.size() <= frameIndex)
+            m_frames.resize(frameIndex + 1);
     }
 
     void cleanup()
@@ -53,143 +66,146 @@ public:
         for (auto &bin : m_bins)
             m_deleter->deleteLater(std::move(bin.buffer));
         m_bins.clear();
+        for (auto &frame : m_frames)
+            frame = {};
     }
 
-    std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> stage(std::span<const uint8_t> data)
+    std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> stage(std::span<const uint8_t> data, size_t alignment = 1)
     {
-        return stage(data.data(), data.size());
+        return stage(data.data(), data.size(), alignment);
     }
 
     // Returns offset at which data was copied into the staging buffer
-    // and handle to the underlying VkBuffer
-    std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> stage(const void *data, size_t byteSize)
+    // and handle to the underlying VkBuffer. The offset is a multiple of alignment,
+    // which copies to textures need to be a multiple of the texel block size.
+    std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> stage(const void *data, size_t byteSize, size_t alignment = 1)
     {
-        assert(byteSize <= BinSize); // We can allocate a buffer largen than the BinSize for the StagingBuffer Pool
+        if (byteSize > BinSize)
+            return stageOversized(data, byteSize);
 
-        auto copyContent = [this](const void *data, size_t byteSize) {
-            const Allocation alloc = m_lastBin->allocate(byteSize);
+        FrameBins &frame = m_frames[m_frameIndex];
 
-            // Copy content into buffer
-            std::memcpy(reinterpret_cast<uint8_t *>(m_lastBin->mapped) + alloc.offset, data, byteSize);
-            return std::make_pair(alloc.offset, m_lastBin->buffer.handle());
-        };
+        if (frame.current == NoBin || !m_bins[frame.current].canAccommodate(byteSize, alignment)) {
+            size_t binIndex = NoBin;
 
-        // Find Bin with enough empty space to store around allocation
-        if (m_lastBin) {
-            if (m_lastBin->canAccommodate(byteSize)) {
-                // We can use the bin and bin already mapped
-                return copyContent(data, byteSize);
+            // Check the oldest bin with space left, bins that can't take this
+            // allocation are dropped from the free list until the next frame
+            if (!frame.partialBins.empty()) {
+                const size_t partialIndex = frame.partialBins.front();
+                frame.partialBins.pop_front();
+                if (m_bins[partialIndex].canAccommodate(byteSize, alignment))
+                    binIndex = partialIndex;
             }
-            // Else -> last bin not big enough
 
-            // Unmap and unset lastBin
-            m_lastBin->unmap();
-            m_lastBin = nullptr;
-        }
+            if (binIndex == NoBin && !frame.emptyBins.empty()) {
+                binIndex = frame.emptyBins.back();
+                frame.emptyBins.pop_back();
+            }
+
+            // Else -> create new bin if nothing can accommodate
+            if (binIndex == NoBin)
+                binIndex = createBin(BinSize);
 
-        // Check if any bin big enough
-        for (auto it = m_bins.begin(), end = m_bins.end(); it != end; ++it) {
-            if (it->frameIndex == m_frameIndex && it->canAccommodate(byteSize)) {
-                // If satisfactory bin found, record it as lastBin
-                // and map it
-                m_lastBin = &(*it);
-                m_lastBin->map();
-                return copyContent(data, byteSize);
+            if (frame.current != NoBin) {
+                unmap(frame.current);
+                if (m_bins[frame.current].cursor < BinSize)
+                    frame.partialBins.push_back(frame.current);
             }
+            frame.current = binIndex;
         }
 
-        // Else -> create new bin if nothing can accommodate
-        m_bins.emplace_back(Bin{ m_frameIndex });
-        m_lastBin = &m_bins.back();
-
-        // Init bin (create VK Buffer) and map it
-        m_lastBin->init(m_device);
-        m_lastBin->map();
-        return copyContent(data, byteSize);
+        return copyContent(frame.current, data, byteSize, alignment);
     }
 
     void flush()
     {
         // Ensure we unmap last mapped bin
-        if (m_lastBin)
-            m_lastBin->unmap(); // Unmap
-        m_lastBin = nullptr;
+        if (m_mappedBin != NoBin)
+            unmap(m_mappedBin);
     }
 
     void moveToNextFrame()
     {
         // We should have been flushed before calling this
-        assert(m_lastBin == nullptr);
+        assert(m_mappedBin == NoBin);
+
+        for (auto &frame : m_frames)
+            frame = {};
 
         // Early return if we have no bins
         if (m_bins.empty())
             return;
 
-        struct BinCounter {
-            int value = 0;
-        };
-        std::map<int, BinCounter> binToImageIndex;
-
         // Destroy excess bins
-        // We keep at most MinimumBinCount bins for each frameIndex
-        for (int64_t m = m_bins.size() - 1; m >= 0; --m) {
-            const Bin &bin = m_bins[m];
-            BinCounter &binCounter = binToImageIndex[bin.frameIndex];
-            if (binCounter.value + 1 > MinimumBinCount) {
-                auto it = m_bins.begin() + m;
-                auto &bin = *it;
-                m_deleter->deleteLater(std::move(bin.buffer));
-                m_bins.erase(it);
+        // We keep at most MinimumBinCount bins for each frameIndex, and as many oversized
+        // bins for each frameIndex and size class among those used since the last call
+        std::vector<Bin> keptBins;
+        keptBins.reserve(m_bins.size());
+        for (auto &bin : m_bins) {
+            FrameBins &frame = m_frames[bin.frameIndex];
+            bool keep = false;
+            if (bin.size == BinSize) {
+                keep = frame.emptyBins.size() < MinimumBinCount;
+                if (keep)
+                    frame.emptyBins.push_back(keptBins.size());
+            } else if (bin.cursor > 0) {
+                const auto sameSizeClassCount = std::count_if(frame.oversizedBins.begin(), frame.oversizedBins.end(),
+                                                              [&](size_t i) { return keptBins[i].size == bin.size; });
+                keep = static_cast<size_t>(sameSizeClassCount) < MinimumBinCount;
+                if (keep)
+                    frame.oversizedBins.push_back(keptBins.size());
+            }
+
+            if (keep) {
+                // Clean bins we keep alive
+                bin.clear();
+                keptBins.push_back(std::move(bin));
             } else {
-                ++(binCounter.value);
+                m_deleter->deleteLater(std::move(bin.buffer));
             }
         }
+        m_bins = std::move(keptBins);
 
-        // Clean bins we keep alive
-        for (auto &bin : m_bins)
-            bin.clear();
+        // Empty bins are popped from the back, reuse them in creation order
+        for (auto &frame : m_frames)
+            std::reverse(frame.emptyBins.begin(), frame.emptyBins.end());
     }
 
-    struct Allocation {
-        size_t offset = 0; // in bytes
-        size_t size = 0; // in bytes
-    };
-
     struct Bin {
 
-        bool canAccommodate(size_t s)
+        // Offset the next allocation would get once aligned
+        size_t nextOffset(size_t alignment) const
         {
-            assert(s <= BinSize);
-            if (m_allocations.empty())
-                return true;
+            return (cursor + alignment - 1) / alignment * alignment;
+        }
 
-            const Allocation &lastAlloc = m_allocations.back();
-            const size_t remainingCapacity = BinSize - (lastAlloc.offset + lastAlloc.size);
-            return remainingCapacity >= s;
+        bool canAccommodate(size_t s, size_t alignment = 1) const
+        {
+            const size_t offset = nextOffset(alignment);
+            return offset <= size && size - offset >= s;
         }
 
-        const Allocation &allocate(size_t s)
+        size_t allocate(size_t s, size_t alignment = 1)
         {
             // Assume we can accommodate
-            Allocation lastAlloc;
-            if (!m_allocations.empty())
-                lastAlloc = m_allocations.back();
-
-            m_allocations.push_back({ lastAlloc.offset + lastAlloc.size, s });
-            return m_allocations.back();
+            const size_t offset = nextOffset(alignment);
+            cursor = offset + s;
+            return offset;
         }
 
         void clear()
         {
-            m_allocations.clear();
+            cursor = 0;
         }
 
         void init(KDGpu::Device *device)
         {
             buffer = device->createBuffer(KDGpu::BufferOptions{
-                    .size = BinSize,
+                    .size = size,
                     .usage = KDGpu::BufferUsageFlags(KDGpu::BufferUsageFlagBits::TransferSrcBit),
-                    .memoryUsage = KDGpu::MemoryUsage::CpuOnly });
+                    .memoryUsage = KDGpu::MemoryUsage::CpuOnly,
+                    .persistentlyMapped = true, // So that switching bins doesn't go through vmaMapMemory/vmaUnmapMemory
+            });
         }
 
         void map()
@@ -206,17 +222,84 @@ public:
         }
 
         size_t frameIndex;
+        size_t size = BinSize; // in bytes, larger than BinSize for oversized bins
         KDGpu::Buffer buffer;
         bool isMapped = false;
         void *mapped = nullptr;
-        std::vector<Allocation> m_allocations;
+        size_t cursor = 0; // End of the last allocation, in bytes
     };
 
     const std::vector<Bin> &bins() const noexcept { return m_bins; }
 
 private:
+    static constexpr size_t NoBin = std::numeric_limits<size_t>::max();
+
+    // Indices into m_bins of the bins of a frame index
+    struct FrameBins {
+        size_t current = NoBin;
+        std::deque<size_t> partialBins;
+        std::vector<size_t> emptyBins;
+        std::vector<size_t> oversizedBins; // Unused oversized bins of any size class
+    };
+
+    size_t createBin(size_t size)
+    {
+        Bin &bin = m_bins.emplace_back();
+        bin.frameIndex = m_frameIndex;
+        bin.size = size;
+        bin.init(m_device);
+        return m_bins.size() - 1;
+    }
+
+    std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> stageOversized(const void *data, size_t byteSize)
+    {
+        const size_t sizeClass = std::bit_ceil(byteSize);
+        std::vector<size_t> &oversizedBins = m_frames[m_frameIndex].oversizedBins;
+
+        size_t binIndex = NoBin;
+        auto it = std::find_if(oversizedBins.begin(), oversizedBins.end(),
+                               [&](size_t i) { return m_bins[i].size == sizeClass; });
+        if (it != oversizedBins.end()) {
+            binIndex = *it;
+            oversizedBins.erase(it);
+        } else {
+            binIndex = createBin(sizeClass);
+        }
+
+        // An oversized bin only ever holds a single allocation
+        const auto result = copyContent(binIndex, data, byteSize, 1);
+        unmap(binIndex);
+        return result;
+    }
+
+    std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> copyContent(size_t binIndex, const void *data, size_t byteSize, size_t alignment)
+    {
+        Bin &bin = m_bins[binIndex];
+        if (m_mappedBin != binIndex) {
+            if (m_mappedBin != NoBin)
+                unmap(m_mappedBin);
+            bin.map();
+            m_mappedBin = binIndex;
+        }
+
+        const size_t offset = bin.allocate(byteSize, alignment);
+
+        // Copy content into buffer
+        std::memcpy(reinterpret_cast<uint8_t *>(bin.mapped) + offset, data, byteSize);
+        return std::make_pair(offset, bin.buffer.handle());
+    }
+
+    void unmap(size_t binIndex)
+    {
+        if (m_bins[binIndex].isMapped)
+            m_bins[binIndex].unmap();
+        if (m_mappedBin == binIndex)
+            m_mappedBin = NoBin;
+    }
+
     std::vector<Bin> m_bins;
-    Bin *m_lastBin = nullptr;
+    std::vector<FrameBins> m_frames = std::vector<FrameBins>(1); // Indexed by frame index
+    size_t m_mappedBin = NoBin;
     KDGpu::Device *m_device = nullptr;
     ResourceDeleter *m_deleter = nullptr;
     size_t m_frameIndex = 0;
@@ -0,0 +1,83 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/transient_bind_group_allocator.h>
+
+#include <KDGpu/device.h>
+#include <KDUtils/logging.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace KDGpuUtils {
+
+TransientBindGroupAllocator::TransientBindGroupAllocator(KDGpu::Device *device, size_t maxFramesInFlight, const KDGpu::BindGroupPoolOptions &poolOptions)
+    : m_device{ device }
+    , m_poolLabel{ poolOptions.label }
+    , m_poolOptions{ poolOptions }
+    , m_frames(maxFramesInFlight)
+{
+    assert(maxFramesInFlight > 0);
+    assert(poolOptions.maxBindGroupCount > 0);
+
+    // BindGroups are only ever released by resetting their whole pool
+    m_poolOptions.label = m_poolLabel;
+    m_poolOptions.flags &= ~KDGpu::BindGroupPoolFlags(KDGpu::BindGroupPoolFlagBits::CreateFreeBindGroups);
+
+    // Otherwise no pool could ever hold a BindGroup and createBindGroup() would keep creating pools
+    m_poolOptions.maxBindGroupCount = std::max<uint16_t>(m_poolOptions.maxBindGroupCount, 1);
+}
+
+TransientBindGroupAllocator::~TransientBindGroupAllocator() = default;
+
+void TransientBindGroupAllocator::derefFrameIndex(size_t frameIndex)
+{
+    assert(frameIndex < m_frames.size());
+    m_frameIndex = frameIndex;
+
+    Frame &frame = m_frames[m_frameIndex];
+    for (KDGpu::BindGroupPool &pool : frame.pools)
+        pool.reset();
+    frame.currentPool = 0;
+}
+
+KDGpu::BindGroup TransientBindGroupAllocator::createBindGroup(const KDGpu::BindGroupOptions &options)
+{
+    Frame &frame = m_frames[m_frameIndex];
+
+    KDGpu::BindGroupOptions transientOptions = options;
+    transientOptions.implicitFree = false;
+
+    // Skip pools whose BindGroup budget is already spent without trying to allocate from them
+    while (currentPool(frame).allocatedBindGroupCount() >= m_poolOptions.maxBindGroupCount)
+        ++frame.currentPool;
+
+    transientOptions.bindGroupPool = currentPool(frame);
+    KDGpu::BindGroup bindGroup = m_device->createBindGroup(transientOptions);
+    if (bindGroup.isValid())
+        return bindGroup;
+
+    // Out of descriptors of some type, move on to the next pool of the frame
+    ++frame.currentPool;
+    transientOptions.bindGroupPool = currentPool(frame);
+    bindGroup = m_device->createBindGroup(transientOptions);
+    if (!bindGroup.isValid())
+        SPDLOG_ERROR("Unable to allocate transient BindGroup \"{}\" even from a fresh pool", options.label);
+    return bindGroup;
+}
+
+KDGpu::BindGroupPool &TransientBindGroupAllocator::currentPool(Frame &frame)
+{
+    if (frame.currentPool == frame.pools.size())
+        frame.pools.emplace_back(m_device->createBindGroupPool(m_poolOptions));
+    return frame.pools[frame.currentPool];
+}
+
+} // namespace KDGpuUtils
@@ -0,0 +1,94 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpuUtils/kdgpuutils_export.h>
+
+#include <KDGpu/bind_group.h>
+#include <KDGpu/bind_group_options.h>
+#include <KDGpu/bind_group_pool.h>
+#include <KDGpu/bind_group_pool_options.h>
+
+#include <string>
+#include <vector>
+
+namespace KDGpu {
+class Device;
+} // namespace KDGpu
+
+namespace KDGpuUtils {
+
+/**
+ * @brief Hands out BindGroups that only live for the frame they were created in
+ *
+ * A list of BindGroupPools is kept for each frame in flight. BindGroups are
+ * allocated linearly from the current frame's pools, which are created without
+ * BindGroupPoolFlagBits::CreateFreeBindGroups. Nothing is ever freed individually:
+ * once the GPU is done with a frame, all of its pools are reset at once and
+ * the BindGroups allocated from them become invalid.
+ *
+ * When the pools of a frame are exhausted, another pool is added to that frame
+ * and kept around for the frames to come.
+ *
+ * Like the BindGroupPools it wraps, a TransientBindGroupAllocator must only be
+ * used from one thread at a time.
+ */
+class KDGPUUTILS_EXPORT TransientBindGroupAllocator
+{
+public:
+    static constexpr KDGpu::BindGroupPoolOptions DefaultPoolOptions{
+        .label = "TransientBindGroupAllocator Pool",
+        .uniformBufferCount = 512,
+        .dynamicUniformBufferCount = 64,
+        .storageBufferCount = 256,
+        .textureSamplerCount = 256,
+        .textureCount = 256,
+        .samplerCount = 32,
+        .imageCount = 32,
+        .inputAttachmentCount = 8,
+        .maxBindGroupCount = 512,
+        .flags = KDGpu::BindGroupPoolFlagBits::None,
+    };
+
+    TransientBindGroupAllocator(KDGpu::Device *device, size_t maxFramesInFlight, const KDGpu::BindGroupPoolOptions &poolOptions = DefaultPoolOptions);
+    ~TransientBindGroupAllocator();
+
+    TransientBindGroupAllocator(TransientBindGroupAllocator const &other) = delete;
+    TransientBindGroupAllocator &operator=(TransientBindGroupAllocator const &other) = delete;
+
+    TransientBindGroupAllocator(TransientBindGroupAllocator &&other) = delete;
+    TransientBindGroupAllocator &operator=(TransientBindGroupAllocator &&other) = delete;
+
+    // Resets the pools of frameIndex and allocates from them from now on, see ResourceDeleter::derefFrameIndex()
+    void derefFrameIndex(size_t frameIndex);
+    size_t frameIndex() const noexcept { return m_frameIndex; }
+
+    // The bindGroupPool and implicitFree members of options are ignored
+    KDGpu::BindGroup createBindGroup(const KDGpu::BindGroupOptions &options);
+
+    const std::vector<KDGpu::BindGroupPool> &bindGroupPools(size_t frameIndex) const { return m_frames.at(frameIndex).pools; }
+
+private:
+    struct Frame {
+        std::vector<KDGpu::BindGroupPool> pools;
+        size_t currentPool{ 0 };
+    };
+
+    KDGpu::BindGroupPool &currentPool(Frame &frame);
+
+    KDGpu::Device *m_device{ nullptr };
+    std::string m_poolLabel;
+    KDGpu::BindGroupPoolOptions m_poolOptions;
+    std::vector<Frame> m_frames;
+    size_t m_frameIndex{ 0 };
+};
+
+} // namespace KDGpuUtils
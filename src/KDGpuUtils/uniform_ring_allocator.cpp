@@ -0,0 +1,111 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/uniform_ring_allocator.h>
+
+#include <KDGpu/adapter.h>
+#include <KDGpu/bind_group_options.h>
+#include <KDGpu/buffer_options.h>
+#include <KDGpu/device.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+namespace KDGpuUtils {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+UniformRingAllocator::UniformRingAllocator(KDGpu::Device *device, size_t maxFramesInFlight, const UniformRingAllocatorOptions &options)
+    : m_alignment{ std::max<size_t>(device->adapter()->properties().limits.minUniformBufferOffsetAlignment, 1) }
+    , m_segmentSize{ alignUp(options.frameSegmentSize, m_alignment) }
+    , m_bindingSize{ options.bindingSize }
+    , m_cursors(maxFramesInFlight, 0)
+{
+    assert(maxFramesInFlight > 0);
+    assert(options.bindingSize <= options.frameSegmentSize);
+
+    // The tail leaves room for a full binding range after the last offset of the last segment
+    m_buffer = device->createBuffer(KDGpu::BufferOptions{
+            .size = m_segmentSize * maxFramesInFlight + m_bindingSize,
+            .usage = KDGpu::BufferUsageFlagBits::UniformBufferBit,
+            .memoryUsage = KDGpu::MemoryUsage::CpuToGpu, // So we can map it to CPU address space
+            .persistentlyMapped = true,
+    });
+    m_mapped = static_cast<uint8_t *>(m_buffer.map());
+
+    m_bindGroup = device->createBindGroup(KDGpu::BindGroupOptions{
+            .layout = options.bindGroupLayout,
+            .resources = { {
+                    .binding = options.binding,
+                    .resource = KDGpu::DynamicUniformBufferBinding{ .buffer = m_buffer, .size = m_bindingSize },
+            } },
+    });
+}
+
+UniformRingAllocator::~UniformRingAllocator()
+{
+    if (m_mapped)
+        m_buffer.unmap();
+}
+
+void UniformRingAllocator::derefFrameIndex(size_t frameIndex)
+{
+    assert(frameIndex < m_cursors.size());
+    m_frameIndex = frameIndex;
+    m_cursors[m_frameIndex] = 0;
+}
+
+UniformRingAllocation UniformRingAllocator::allocate(size_t byteSize)
+{
+    assert(byteSize <= m_bindingSize); // The shader wouldn't see anything past the binding range
+
+    size_t &cursor = m_cursors[m_frameIndex];
+    const size_t offsetInSegment = alignUp(cursor, m_alignment);
+    if (m_mapped == nullptr || offsetInSegment + byteSize > m_segmentSize)
+        return {};
+    cursor = offsetInSegment + byteSize;
+
+    const size_t offset = m_frameIndex * m_segmentSize + offsetInSegment;
+    m_dirtyBegin = std::min(m_dirtyBegin, offset);
+    m_dirtyEnd = std::max(m_dirtyEnd, offset + byteSize);
+    return UniformRingAllocation{
+        .bindGroup = m_bindGroup,
+        .dynamicOffset = static_cast<uint32_t>(offset),
+        .data = m_mapped + offset,
+    };
+}
+
+UniformRingAllocation UniformRingAllocator::allocate(const void *data, size_t byteSize)
+{
+    UniformRingAllocation allocation = allocate(byteSize);
+    if (allocation.isValid())
+        std::memcpy(allocation.data, data, byteSize);
+    return allocation;
+}
+
+void UniformRingAllocator::flush()
+{
+    if (m_dirtyBegin >= m_dirtyEnd)
+        return;
+    m_buffer.flush(m_dirtyBegin, m_dirtyEnd - m_dirtyBegin);
+    m_dirtyBegin = std::numeric_limits<size_t>::max();
+    m_dirtyEnd = 0;
+}
+
+} // namespace KDGpuUtils
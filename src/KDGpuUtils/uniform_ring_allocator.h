@@ -0,0 +1,115 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#pragma once
+
+#include <KDGpuUtils/kdgpuutils_export.h>
+
+#include <KDGpu/bind_group.h>
+#include <KDGpu/buffer.h>
+#include <KDGpu/handle.h>
+
+#include <limits>
+#include <vector>
+
+namespace KDGpu {
+class Device;
+struct BindGroupLayout_t;
+} // namespace KDGpu
+
+namespace KDGpuUtils {
+
+struct UniformRingAllocatorOptions {
+    // Layout holding a single ResourceBindingType::DynamicUniformBuffer at binding
+    KDGpu::Handle<KDGpu::BindGroupLayout_t> bindGroupLayout;
+    uint32_t binding{ 0 };
+    // Size of the range the shader sees at each dynamic offset. No allocation can be larger.
+    uint32_t bindingSize{ 256 };
+    // Bytes available to each frame in flight
+    size_t frameSegmentSize{ 1024 * 1024 };
+};
+
+struct UniformRingAllocation {
+    // Bind with dynamicBufferOffsets = { dynamicOffset }
+    KDGpu::Handle<KDGpu::BindGroup_t> bindGroup;
+    uint32_t dynamicOffset{ 0 };
+    // Where the uniform data has to be written to
+    void *data{ nullptr };
+
+    bool isValid() const noexcept { return data != nullptr; }
+};
+
+/**
+ * @brief Sub-allocates per-draw uniform data from a single mapped buffer
+ *
+ * A uniform buffer large enough for maxFramesInFlight segments of
+ * UniformRingAllocatorOptions::frameSegmentSize bytes is created and kept
+ * mapped. Each allocation is carved out of the current frame's segment at an
+ * offset aligned to AdapterLimits::minUniformBufferOffsetAlignment and is
+ * returned along with a BindGroup exposing the buffer as a dynamic uniform
+ * buffer. The same BindGroup is shared by all allocations, only the dynamic
+ * offset passed to setBindGroup() changes from one draw to the next.
+ *
+ * A segment is only rewound once derefFrameIndex() comes back to its frame, so
+ * allocations remain valid until the GPU is done with the frame they were made in.
+ * When a segment is full, allocate() returns an invalid allocation.
+ *
+ * Like the command recorders it is meant to feed, a UniformRingAllocator must
+ * only be used from one thread at a time.
+ */
+class KDGPUUTILS_EXPORT UniformRingAllocator
+{
+public:
+    UniformRingAllocator(KDGpu::Device *device, size_t maxFramesInFlight, const UniformRingAllocatorOptions &options);
+    ~UniformRingAllocator();
+
+    UniformRingAllocator(UniformRingAllocator const &other) = delete;
+    UniformRingAllocator &operator=(UniformRingAllocator const &other) = delete;
+
+    UniformRingAllocator(UniformRingAllocator &&other) = delete;
+    UniformRingAllocator &operator=(UniformRingAllocator &&other) = delete;
+
+    // Rewinds the segment of frameIndex and allocates from it from now on, see ResourceDeleter::derefFrameIndex()
+    void derefFrameIndex(size_t frameIndex);
+    size_t frameIndex() const noexcept { return m_frameIndex; }
+
+    UniformRingAllocation allocate(size_t byteSize);
+    UniformRingAllocation allocate(const void *data, size_t byteSize);
+    template<typename T>
+    UniformRingAllocation allocate(const T &value)
+    {
+        return allocate(&value, sizeof(T));
+    }
+
+    // Makes the data allocated since the last flush visible to the GPU. Must be called before submitting.
+    // Only the range covering those allocations is flushed, and nothing at all on HOST_COHERENT memory.
+    void flush();
+
+    const KDGpu::Buffer &buffer() const noexcept { return m_buffer; }
+    const KDGpu::BindGroup &bindGroup() const noexcept { return m_bindGroup; }
+    size_t alignment() const noexcept { return m_alignment; }
+    size_t frameSegmentSize() const noexcept { return m_segmentSize; }
+    // Number of bytes allocated from the current frame's segment, including alignment padding
+    size_t usedSize() const noexcept { return m_cursors[m_frameIndex]; }
+
+private:
+    KDGpu::Buffer m_buffer;
+    KDGpu::BindGroup m_bindGroup;
+    uint8_t *m_mapped{ nullptr };
+    size_t m_alignment{ 0 };
+    size_t m_segmentSize{ 0 };
+    uint32_t m_bindingSize{ 0 };
+    std::vector<size_t> m_cursors; // Offset of the next allocation within each frame's segment
+    size_t m_frameIndex{ 0 };
+    size_t m_dirtyBegin{ std::numeric_limits<size_t>::max() }; // Range of the buffer allocated since the last flush
+    size_t m_dirtyEnd{ 0 };
+};
+
+} // namespace KDGpuUtils
@@ -0,0 +1,111 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/async_uploader.h>
+
+#include <KDGpu/adapter_queue_type.h>
+#include <KDGpu/buffer.h>
+#include <KDGpu/buffer_options.h>
+#include <KDGpu/device.h>
+#include <KDGpu/instance.h>
+#include <KDGpu/vulkan/vulkan_graphics_api.h>
+
+#include <array>
+#include <cstring>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+namespace {
+
+std::vector<KDGpu::QueueRequest> queueRequests(KDGpu::Adapter *adapter)
+{
+    std::vector<KDGpu::QueueRequest> requests = { { .queueTypeIndex = 0, .count = 1, .priorities = { 1.0f } } };
+    const std::optional<uint32_t> transferQueueTypeIndex = KDGpuUtils::AsyncUploader::findTransferQueueTypeIndex(adapter);
+    if (transferQueueTypeIndex.has_value() && *transferQueueTypeIndex != 0)
+        requests.push_back({ .queueTypeIndex = *transferQueueTypeIndex, .count = 1, .priorities = { 1.0f } });
+    return requests;
+}
+
+} // namespace
+
+TEST_SUITE("AsyncUploader")
+{
+    std::unique_ptr<KDGpu::GraphicsApi> api = std::make_unique<KDGpu::VulkanGraphicsApi>();
+    KDGpu::Instance instance = api->createInstance(KDGpu::InstanceOptions{
+            .applicationName = "AsyncUploader",
+            .applicationVersion = KDGPU_MAKE_API_VERSION(0, 1, 0, 0) });
+    KDGpu::Adapter *discreteGPUAdapter = instance.selectAdapter(KDGpu::AdapterDeviceType::Default);
+    KDGpu::Device device = discreteGPUAdapter->createDevice(KDGpu::DeviceOptions{ .queues = queueRequests(discreteGPUAdapter) });
+
+    TEST_CASE("Transfer queue lookup")
+    {
+        // WHEN
+        const std::optional<uint32_t> queueTypeIndex = KDGpuUtils::AsyncUploader::findTransferQueueTypeIndex(discreteGPUAdapter);
+        KDGpu::Queue *transferQueue = KDGpuUtils::AsyncUploader::findTransferQueue(&device);
+
+        // THEN
+        if (queueTypeIndex.has_value()) {
+            const KDGpu::AdapterQueueType &queueType = discreteGPUAdapter->queueTypes()[*queueTypeIndex];
+            CHECK(queueType.supportsFeature(KDGpu::QueueFlagBits::TransferBit));
+            CHECK(!queueType.supportsFeature(KDGpu::QueueFlagBits::GraphicsBit));
+            REQUIRE(transferQueue != nullptr);
+            CHECK(transferQueue->queueTypeIndex() == *queueTypeIndex);
+        } else {
+            CHECK(transferQueue == nullptr);
+        }
+    }
+
+    TEST_CASE("Uploads are handed over to the graphics queue")
+    {
+        // GIVEN
+        KDGpu::Queue &graphicsQueue = device.queues()[0];
+        KDGpu::Queue *transferQueue = KDGpuUtils::AsyncUploader::findTransferQueue(&device);
+        if (transferQueue == nullptr)
+            transferQueue = &graphicsQueue;
+
+        KDGpuUtils::AsyncUploader uploader(&device, transferQueue, &graphicsQueue);
+        const std::array<uint32_t, 4> data = { 1, 2, 3, 4 };
+        KDGpu::Buffer dst = device.createBuffer(KDGpu::BufferOptions{
+                .size = sizeof(data),
+                .usage = KDGpu::BufferUsageFlagBits::TransferDstBit,
+                .memoryUsage = KDGpu::MemoryUsage::GpuToCpu,
+        });
+
+        // THEN
+        CHECK(uploader.batchedUploader().transfersOwnership() == (transferQueue != &graphicsQueue));
+        CHECK(!uploader.submit().isValid());
+
+        // WHEN
+        uploader.uploadBufferData(KDGpu::BufferUploadOptions{
+                .destinationBuffer = dst,
+                .dstStages = KDGpu::PipelineStageFlagBit::HostBit,
+                .dstMask = KDGpu::AccessFlagBit::HostReadBit,
+                .data = data.data(),
+                .byteSize = sizeof(data),
+        });
+        const KDGpu::Handle<KDGpu::GpuSemaphore_t> semaphore = uploader.submit();
+
+        KDGpu::CommandRecorder commandRecorder = device.createCommandRecorder(KDGpu::CommandRecorderOptions{ .queue = graphicsQueue });
+        uploader.recordAcquireBarriers(commandRecorder);
+        KDGpu::CommandBuffer commandBuffer = commandRecorder.finish();
+        graphicsQueue.submit(KDGpu::SubmitOptions{
+                .commandBuffers = { commandBuffer },
+                .waitSemaphores = { semaphore },
+        });
+        graphicsQueue.waitUntilIdle();
+
+        // THEN
+        CHECK(semaphore.isValid());
+        dst.invalidate();
+        CHECK(std::memcmp(dst.map(), data.data(), sizeof(data)) == 0);
+        dst.unmap();
+    }
+}
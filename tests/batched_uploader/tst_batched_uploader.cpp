@@ -0,0 +1,258 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/batched_uploader.h>
+
+#include <KDGpu/buffer.h>
+#include <KDGpu/buffer_options.h>
+#include <KDGpu/device.h>
+#include <KDGpu/fence.h>
+#include <KDGpu/instance.h>
+#include <KDGpu/texture.h>
+#include <KDGpu/texture_options.h>
+#include <KDGpu/vulkan/vulkan_graphics_api.h>
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_SUITE("BatchedUploader")
+{
+    std::unique_ptr<KDGpu::GraphicsApi> api = std::make_unique<KDGpu::VulkanGraphicsApi>();
+    KDGpu::Instance instance = api->createInstance(KDGpu::InstanceOptions{
+            .applicationName = "BatchedUploader",
+            .applicationVersion = KDGPU_MAKE_API_VERSION(0, 1, 0, 0) });
+    KDGpu::Adapter *discreteGPUAdapter = instance.selectAdapter(KDGpu::AdapterDeviceType::Default);
+    KDGpu::Device device = discreteGPUAdapter->createDevice();
+    KDGpu::Queue &queue = device.queues()[0];
+
+    KDGpu::Buffer createReadbackBuffer(size_t byteSize)
+    {
+        return device.createBuffer(KDGpu::BufferOptions{
+                .size = byteSize,
+                .usage = KDGpu::BufferUsageFlagBits::TransferDstBit,
+                .memoryUsage = KDGpu::MemoryUsage::GpuToCpu,
+        });
+    }
+
+    TEST_CASE("Creation")
+    {
+        // GIVEN
+        KDGpuUtils::BatchedUploader uploader(&device, &queue, 3);
+
+        // THEN
+        CHECK(uploader.maxBatchesInFlight() == 3);
+        CHECK(uploader.batchIndex() == 0);
+        CHECK(uploader.pendingUploadCount() == 0);
+
+        // WHEN -> Nothing to submit
+        const KDGpu::Handle<KDGpu::Fence_t> fence = uploader.submit();
+
+        // THEN
+        CHECK(!fence.isValid());
+        CHECK(uploader.batchIndex() == 0);
+    }
+
+    TEST_CASE("Uploads are batched into a single submission")
+    {
+        // GIVEN
+        KDGpuUtils::BatchedUploader uploader(&device, &queue);
+        const std::array<uint32_t, 4> a = { 1, 2, 3, 4 };
+        const std::array<uint32_t, 3> b = { 5, 6, 7 };
+        KDGpu::Buffer dstA = createReadbackBuffer(sizeof(a));
+        KDGpu::Buffer dstB = createReadbackBuffer(sizeof(b));
+
+        // WHEN
+        uploader.uploadBufferData(KDGpu::BufferUploadOptions{
+                .destinationBuffer = dstA,
+                .dstStages = KDGpu::PipelineStageFlagBit::HostBit,
+                .dstMask = KDGpu::AccessFlagBit::HostReadBit,
+                .data = a.data(),
+                .byteSize = sizeof(a),
+        });
+        uploader.uploadBufferData(KDGpu::BufferUploadOptions{
+                .destinationBuffer = dstB,
+                .dstStages = KDGpu::PipelineStageFlagBit::HostBit,
+                .dstMask = KDGpu::AccessFlagBit::HostReadBit,
+                .data = b.data(),
+                .byteSize = sizeof(b),
+        });
+
+        // THEN
+        CHECK(uploader.pendingUploadCount() == 2);
+
+        // WHEN
+        const KDGpu::Handle<KDGpu::Fence_t> fence = uploader.submit();
+        uploader.waitUntilIdle();
+
+        // THEN
+        CHECK(fence.isValid());
+        CHECK(uploader.pendingUploadCount() == 0);
+        CHECK(uploader.batchIndex() == 1);
+
+        dstA.invalidate();
+        dstB.invalidate();
+        CHECK(std::memcmp(dstA.map(), a.data(), sizeof(a)) == 0);
+        CHECK(std::memcmp(dstB.map(), b.data(), sizeof(b)) == 0);
+        dstA.unmap();
+        dstB.unmap();
+    }
+
+    TEST_CASE("Batch slots are reused once their fence signalled")
+    {
+        // GIVEN
+        KDGpuUtils::BatchedUploader uploader(&device, &queue, 2);
+        const uint32_t value = 42;
+        KDGpu::Buffer dst = createReadbackBuffer(sizeof(value));
+        const KDGpu::BufferUploadOptions uploadOptions{
+            .destinationBuffer = dst,
+            .dstStages = KDGpu::PipelineStageFlagBit::HostBit,
+            .dstMask = KDGpu::AccessFlagBit::HostReadBit,
+            .data = &value,
+            .byteSize = sizeof(value),
+        };
+
+        // WHEN
+        std::vector<KDGpu::Handle<KDGpu::Fence_t>> fences;
+        for (size_t i = 0; i < 3; ++i) {
+            uploader.uploadBufferData(uploadOptions);
+            fences.push_back(uploader.submit());
+        }
+        uploader.waitUntilIdle();
+
+        // THEN -> The third batch went through the first slot again
+        CHECK(fences[0] == fences[2]);
+        CHECK(fences[0] != fences[1]);
+        CHECK(uploader.batchIndex() == 1);
+    }
+
+    TEST_CASE("Uploads larger than a staging bin")
+    {
+        // GIVEN
+        KDGpuUtils::BatchedUploader uploader(&device, &queue);
+        const std::vector<uint8_t> data(3_Mb, 0xab);
+        KDGpu::Buffer dst = createReadbackBuffer(data.size());
+
+        // WHEN
+        uploader.uploadBufferData(KDGpu::BufferUploadOptions{
+                .destinationBuffer = dst,
+                .dstStages = KDGpu::PipelineStageFlagBit::HostBit,
+                .dstMask = KDGpu::AccessFlagBit::HostReadBit,
+                .data = data.data(),
+                .byteSize = data.size(),
+        });
+        uploader.submit();
+        uploader.waitUntilIdle();
+
+        // THEN
+        dst.invalidate();
+        CHECK(std::memcmp(dst.map(), data.data(), data.size()) == 0);
+        dst.unmap();
+    }
+
+    TEST_CASE("Texture uploads are staged at an offset suitable for the texel block size")
+    {
+        const auto uploadAndReadBack = [](KDGpu::Format format, size_t texelBlockSize) {
+            // GIVEN
+            constexpr uint32_t extent = 4;
+            const size_t textureByteSize = extent * extent * texelBlockSize;
+            std::vector<uint8_t> textureData(textureByteSize);
+            for (size_t i = 0; i < textureByteSize; ++i)
+                textureData[i] = static_cast<uint8_t>(i);
+            const std::array<uint8_t, 3> oddData = { 1, 2, 3 };
+
+            KDGpuUtils::BatchedUploader uploader(&device, &queue);
+            KDGpu::Buffer oddDst = createReadbackBuffer(oddData.size());
+            KDGpu::Texture texture = device.createTexture(KDGpu::TextureOptions{
+                    .type = KDGpu::TextureType::TextureType2D,
+                    .format = format,
+                    .extent = { extent, extent, 1 },
+                    .mipLevels = 1,
+                    .usage = KDGpu::TextureUsageFlagBits::TransferSrcBit | KDGpu::TextureUsageFlagBits::TransferDstBit,
+                    .memoryUsage = KDGpu::MemoryUsage::GpuOnly,
+            });
+            const KDGpu::BufferTextureCopyRegion region{
+                .textureSubResource = { .aspectMask = KDGpu::TextureAspectFlagBits::ColorBit },
+                .textureExtent = { extent, extent, 1 },
+            };
+
+            // WHEN -> The odd sized buffer upload leaves the staging cursor unaligned
+            uploader.uploadBufferData(KDGpu::BufferUploadOptions{
+                    .destinationBuffer = oddDst,
+                    .dstStages = KDGpu::PipelineStageFlagBit::HostBit,
+                    .dstMask = KDGpu::AccessFlagBit::HostReadBit,
+                    .data = oddData.data(),
+                    .byteSize = oddData.size(),
+            });
+            uploader.uploadTextureData(KDGpu::TextureUploadOptions{
+                                               .destinationTexture = texture,
+                                               .dstStages = KDGpu::PipelineStageFlagBit::TransferBit,
+                                               .dstMask = KDGpu::AccessFlagBit::TransferReadBit,
+                                               .data = textureData.data(),
+                                               .byteSize = textureByteSize,
+                                               .oldLayout = KDGpu::TextureLayout::Undefined,
+                                               .newLayout = KDGpu::TextureLayout::TransferSrcOptimal,
+                                               .regions = { region },
+                                       },
+                                       texelBlockSize);
+            uploader.submit();
+            uploader.waitUntilIdle();
+
+            // THEN
+            KDGpu::Buffer textureDst = createReadbackBuffer(textureByteSize);
+            KDGpu::CommandRecorder commandRecorder = device.createCommandRecorder();
+            commandRecorder.copyTextureToBuffer(KDGpu::TextureToBufferCopy{
+                    .srcTexture = texture,
+                    .srcTextureLayout = KDGpu::TextureLayout::TransferSrcOptimal,
+                    .dstBuffer = textureDst,
+                    .regions = { region },
+            });
+            commandRecorder.bufferMemoryBarrier(KDGpu::BufferMemoryBarrierOptions{
+                    .srcStages = KDGpu::PipelineStageFlagBit::TransferBit,
+                    .srcMask = KDGpu::AccessFlagBit::TransferWriteBit,
+                    .dstStages = KDGpu::PipelineStageFlagBit::HostBit,
+                    .dstMask = KDGpu::AccessFlagBit::HostReadBit,
+                    .buffer = textureDst,
+            });
+            KDGpu::CommandBuffer commandBuffer = commandRecorder.finish();
+            KDGpu::Fence fence = device.createFence({ .createSignalled = false });
+            queue.submit(KDGpu::SubmitOptions{ .commandBuffers = { commandBuffer }, .signalFence = fence });
+            fence.wait();
+
+            oddDst.invalidate();
+            textureDst.invalidate();
+            CHECK(std::memcmp(oddDst.map(), oddData.data(), oddData.size()) == 0);
+            CHECK(std::memcmp(textureDst.map(), textureData.data(), textureByteSize) == 0);
+            oddDst.unmap();
+            textureDst.unmap();
+        };
+
+        const auto supportsTransfers = [](KDGpu::Format format) {
+            const KDGpu::FormatFeatureFlags features = discreteGPUAdapter->formatProperties(format).optimalTilingFeatures;
+            return features.testFlag(KDGpu::FormatFeatureFlagBit::TransferSrcBit) && features.testFlag(KDGpu::FormatFeatureFlagBit::TransferDstBit);
+        };
+
+        SUBCASE("4 byte texels")
+        {
+            uploadAndReadBack(KDGpu::Format::R8G8B8A8_UNORM, 4);
+        }
+
+        SUBCASE("12 byte texels")
+        {
+            // 3 component formats are optional
+            if (!supportsTransfers(KDGpu::Format::R32G32B32_SFLOAT))
+                return;
+            uploadAndReadBack(KDGpu::Format::R32G32B32_SFLOAT, 12);
+        }
+    }
+}
@@ -27,6 +27,8 @@
 #include <KDGpu/vulkan/vulkan_graphics_api.h>
 #include <KDGpu/vulkan/vulkan_bind_group.h>
 
+#include <vector>
+
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest.h>
 
@@ -166,6 +168,114 @@ TEST_SUITE("BindGroup")
             t.update(BindGroupEntry{ .binding = 0, .resource = StorageBufferBinding{ .buffer = ssbo } });
         }
 
+        SUBCASE("Several entries at once")
+        {
+            // GIVEN
+            auto ubo = device.createBuffer(BufferOptions{
+                    .size = 16 * sizeof(float),
+                    .usage = BufferUsageFlagBits::UniformBufferBit,
+                    .memoryUsage = MemoryUsage::CpuToGpu,
+            });
+            auto ssbo = device.createBuffer(BufferOptions{
+                    .size = 16 * sizeof(float),
+                    .usage = BufferUsageFlagBits::StorageBufferBit,
+                    .memoryUsage = MemoryUsage::GpuOnly,
+            });
+
+            const BindGroupLayout bindGroupLayout = device.createBindGroupLayout(BindGroupLayoutOptions{
+                    .bindings = {
+                            { .binding = 0,
+                              .count = 1,
+                              .resourceType = ResourceBindingType::UniformBuffer,
+                              .shaderStages = ShaderStageFlags(ShaderStageFlagBits::ComputeBit) },
+                            { .binding = 1,
+                              .count = 2,
+                              .resourceType = ResourceBindingType::StorageBuffer,
+                              .shaderStages = ShaderStageFlags(ShaderStageFlagBits::ComputeBit) },
+                    },
+            });
+
+            const std::vector<BindGroupEntry> entries = {
+                { .binding = 0, .resource = UniformBufferBinding{ .buffer = ubo } },
+                { .binding = 1, .resource = StorageBufferBinding{ .buffer = ssbo }, .arrayElement = 0 },
+                { .binding = 1, .resource = StorageBufferBinding{ .buffer = ssbo }, .arrayElement = 1 },
+            };
+
+            // WHEN
+            BindGroup t = device.createBindGroup(BindGroupOptions{
+                    .layout = bindGroupLayout,
+                    .resources = entries,
+            });
+
+            // THEN
+            CHECK(t.isValid());
+
+            // WHEN
+            t.update(std::span<const BindGroupEntry>(entries));
+
+            // THEN
+            CHECK(t.isValid());
+        }
+
+        SUBCASE("With a descriptor update template")
+        {
+            // GIVEN
+            auto ubo = device.createBuffer(BufferOptions{
+                    .size = 16 * sizeof(float),
+                    .usage = BufferUsageFlagBits::UniformBufferBit,
+                    .memoryUsage = MemoryUsage::CpuToGpu,
+            });
+            auto ssbo = device.createBuffer(BufferOptions{
+                    .size = 16 * sizeof(float),
+                    .usage = BufferUsageFlagBits::StorageBufferBit,
+                    .memoryUsage = MemoryUsage::GpuOnly,
+            });
+
+            // Bindings deliberately out of order, resources are expected sorted by binding
+            const BindGroupLayout bindGroupLayout = device.createBindGroupLayout(BindGroupLayoutOptions{
+                    .bindings = {
+                            { .binding = 1,
+                              .count = 2,
+                              .resourceType = ResourceBindingType::StorageBuffer,
+                              .shaderStages = ShaderStageFlags(ShaderStageFlagBits::ComputeBit) },
+                            { .binding = 0,
+                              .count = 1,
+                              .resourceType = ResourceBindingType::UniformBuffer,
+                              .shaderStages = ShaderStageFlags(ShaderStageFlagBits::ComputeBit) },
+                    },
+            });
+            BindGroup t = device.createBindGroup(BindGroupOptions{ .layout = bindGroupLayout });
+
+            const std::vector<BindingResource> resources = {
+                UniformBufferBinding{ .buffer = ubo },
+                StorageBufferBinding{ .buffer = ssbo },
+                StorageBufferBinding{ .buffer = ssbo, .offset = 0, .size = 8 * sizeof(float) },
+            };
+
+            // WHEN
+            t.updateWithTemplate(resources);
+            t.updateWithTemplate(resources);
+
+            // THEN
+            auto *vulkanBindGroupLayout = api->resourceManager()->getBindGroupLayout(bindGroupLayout);
+            CHECK(t.isValid());
+            CHECK(vulkanBindGroupLayout->descriptorCount() == 3);
+            CHECK(vulkanBindGroupLayout->updateTemplate != VK_NULL_HANDLE);
+
+            // WHEN -> Resources not sorted by binding
+            const std::vector<BindingResource> unsortedResources = {
+                StorageBufferBinding{ .buffer = ssbo },
+                StorageBufferBinding{ .buffer = ssbo },
+                UniformBufferBinding{ .buffer = ubo },
+            };
+            std::vector<VulkanDescriptorUpdateTemplateData> templateData;
+            auto *vulkanDevice = api->resourceManager()->getDevice(device);
+
+            // THEN
+            CHECK(vulkanDevice->packDescriptorUpdateTemplateData(templateData, *vulkanBindGroupLayout, resources));
+            CHECK(!vulkanDevice->packDescriptorUpdateTemplateData(templateData, *vulkanBindGroupLayout, unsortedResources));
+        }
+
         SUBCASE("TextureViewSampler")
         {
             // GIVEN
@@ -918,6 +1028,105 @@ TEST_SUITE("BindGroup")
             CHECK(!bindGroup.isValid());
         }
 
+        SUBCASE("Create BindGroups from a descriptor buffer pool")
+        {
+            if (!discreteGPUAdapter->features().descriptorBuffer || !discreteGPUAdapter->features().bufferDeviceAddress)
+                return;
+
+            // GIVEN
+            const BindGroupPoolOptions poolOptions = {
+                .label = "Descriptor Buffer Pool",
+                .uniformBufferCount = 2,
+                .maxBindGroupCount = 2,
+                .flags = BindGroupPoolFlagBits::DescriptorBuffer
+            };
+
+            BindGroupPool pool = device.createBindGroupPool(poolOptions);
+            CHECK(pool.isValid());
+
+            Buffer ubo = device.createBuffer(BufferOptions{
+                    .size = 16 * sizeof(float),
+                    .usage = BufferUsageFlagBits::UniformBufferBit | BufferUsageFlagBits::ShaderDeviceAddressBit,
+                    .memoryUsage = MemoryUsage::CpuToGpu,
+            });
+
+            const BindGroupLayout bindGroupLayout = device.createBindGroupLayout(BindGroupLayoutOptions{
+                    .bindings = {
+                            { .binding = 0,
+                              .count = 1,
+                              .resourceType = ResourceBindingType::UniformBuffer,
+                              .shaderStages = ShaderStageFlags(ShaderStageFlagBits::VertexBit) },
+                    },
+                    .flags = BindGroupLayoutFlagBits::DescriptorBuffer,
+            });
+
+            const BindGroupOptions bindGroupOptions = {
+                .layout = bindGroupLayout,
+                .resources = {
+                        { .binding = 0, .resource = UniformBufferBinding{ .buffer = ubo } },
+                },
+                .bindGroupPool = pool
+            };
+
+            // WHEN
+            BindGroup bindGroupA = device.createBindGroup(bindGroupOptions);
+            BindGroup bindGroupB = device.createBindGroup(bindGroupOptions);
+
+            // THEN -> BindGroups are linearly sub-allocated from the descriptor buffer
+            CHECK(bindGroupA.isValid());
+            CHECK(bindGroupB.isValid());
+            CHECK(pool.allocatedBindGroupCount() == 2);
+            auto *vulkanBindGroupA = api->resourceManager()->getBindGroup(bindGroupA);
+            auto *vulkanBindGroupB = api->resourceManager()->getBindGroup(bindGroupB);
+            CHECK(vulkanBindGroupA->descriptorSet == VK_NULL_HANDLE);
+            CHECK(vulkanBindGroupA->usesDescriptorBuffer());
+            CHECK(vulkanBindGroupB->descriptorBufferOffset > vulkanBindGroupA->descriptorBufferOffset);
+
+            // WHEN -> Going past maxBindGroupCount
+            BindGroup bindGroupC = device.createBindGroup(bindGroupOptions);
+
+            // THEN
+            CHECK(!bindGroupC.isValid());
+            CHECK(pool.allocatedBindGroupCount() == 2);
+
+            // WHEN -> Using a layout that wasn't created for descriptor buffers
+            const BindGroupLayout descriptorSetLayout = device.createBindGroupLayout(BindGroupLayoutOptions{
+                    .bindings = {
+                            { .binding = 0,
+                              .count = 1,
+                              .resourceType = ResourceBindingType::UniformBuffer,
+                              .shaderStages = ShaderStageFlags(ShaderStageFlagBits::VertexBit) },
+                    },
+            });
+            pool.reset();
+            BindGroup bindGroupD = device.createBindGroup(BindGroupOptions{
+                    .layout = descriptorSetLayout,
+                    .resources = {
+                            { .binding = 0, .resource = UniformBufferBinding{ .buffer = ubo } },
+                    },
+                    .bindGroupPool = pool,
+            });
+
+            // THEN
+            CHECK(!bindGroupD.isValid());
+            CHECK(pool.allocatedBindGroupCount() == 0);
+
+            // WHEN
+            bindGroupA = device.createBindGroup(bindGroupOptions);
+            bindGroupB = device.createBindGroup(bindGroupOptions);
+            bindGroupA = {};
+
+            // THEN -> Its descriptor buffer range is only recycled by reset(), so it remains counted
+            CHECK(pool.allocatedBindGroupCount() == 2);
+
+            // WHEN
+            pool.reset();
+
+            // THEN -> Rewinding the descriptor buffer invalidates the BindGroups
+            CHECK(pool.allocatedBindGroupCount() == 0);
+            CHECK(!bindGroupB.isValid());
+        }
+
         SUBCASE("Create BindGroups with implicitFree = false")
         {
             // GIVEN
@@ -1067,4 +1276,85 @@ TEST_SUITE("BindGroup")
 
         // THEN -> No validation errors (BindGroups are released against the BindGroupPool they were created with)
     }
+
+    TEST_CASE("Internal BindGroupPool statistics")
+    {
+        // GIVEN
+        const BindGroupLayout bindGroupLayout = device.createBindGroupLayout(BindGroupLayoutOptions{
+                .bindings = {
+                        { .binding = 0,
+                          .count = 2,
+                          .resourceType = ResourceBindingType::SampledImage,
+                          .shaderStages = ShaderStageFlags(ShaderStageFlagBits::FragmentBit) },
+                },
+        });
+        const BindGroupPoolStatistics initialStatistics = device.internalBindGroupPoolStatistics();
+
+        // WHEN
+        BindGroup b1 = device.createBindGroup(BindGroupOptions{ .layout = bindGroupLayout });
+        BindGroup b2 = device.createBindGroup(BindGroupOptions{ .layout = bindGroupLayout });
+
+        // THEN -> Descriptor consumption is tracked per type
+        const BindGroupPoolStatistics statistics = device.internalBindGroupPoolStatistics();
+        CHECK(statistics.poolCount >= 1);
+        CHECK(statistics.bindGroupCapacity >= statistics.allocatedBindGroupCount);
+        CHECK(statistics.allocatedBindGroupCount == initialStatistics.allocatedBindGroupCount + 2);
+        CHECK(statistics.totalBindGroupAllocations == initialStatistics.totalBindGroupAllocations + 2);
+        CHECK(statistics.totalDescriptorAllocations.textureCount == initialStatistics.totalDescriptorAllocations.textureCount + 4);
+        CHECK(statistics.totalDescriptorAllocations.uniformBufferCount == initialStatistics.totalDescriptorAllocations.uniformBufferCount);
+
+        // WHEN
+        b1 = {};
+        b2 = {};
+
+        // THEN -> Only the live count goes back down
+        const BindGroupPoolStatistics finalStatistics = device.internalBindGroupPoolStatistics();
+        CHECK(finalStatistics.allocatedBindGroupCount == initialStatistics.allocatedBindGroupCount);
+        CHECK(finalStatistics.totalBindGroupAllocations == statistics.totalBindGroupAllocations);
+    }
+
+    TEST_CASE("Internal BindGroupPool sizing follows the observed descriptor mix" * doctest::skip(discreteGPUAdapter->properties().limits.maxPerStageDescriptorSampledImages < 160 || discreteGPUAdapter->properties().limits.maxDescriptorSetSampledImages < 160))
+    {
+        // GIVEN -> A fresh Device so that its internal pools haven't been used yet
+        Device freshDevice = discreteGPUAdapter->createDevice();
+        const BindGroupLayout bindGroupLayout = freshDevice.createBindGroupLayout(BindGroupLayoutOptions{
+                .bindings = {
+                        { .binding = 0,
+                          .count = 160, // More than the default internal pool holds
+                          .resourceType = ResourceBindingType::SampledImage,
+                          .shaderStages = ShaderStageFlags(ShaderStageFlagBits::FragmentBit) },
+                },
+        });
+
+        // WHEN
+        std::vector<BindGroup> bindGroups;
+        bindGroups.emplace_back(freshDevice.createBindGroup(BindGroupOptions{ .layout = bindGroupLayout }));
+
+        // THEN -> The first pool is large enough for the first BindGroup
+        const BindGroupPoolStatistics firstPoolStatistics = freshDevice.internalBindGroupPoolStatistics();
+        CHECK(bindGroups.front().isValid());
+        REQUIRE(firstPoolStatistics.poolCount == 1);
+        CHECK(firstPoolStatistics.descriptorCapacity.textureCount >= 160);
+
+        // WHEN -> Allocating until the first pool runs out
+        while (bindGroups.size() <= firstPoolStatistics.bindGroupCapacity && freshDevice.internalBindGroupPoolStatistics().poolCount == 1) {
+            bindGroups.emplace_back(freshDevice.createBindGroup(BindGroupOptions{ .layout = bindGroupLayout }));
+            REQUIRE(bindGroups.back().isValid());
+        }
+
+        // THEN -> The second pool favours sampled images over the descriptor types that were never used.
+        // Some drivers don't report pool exhaustion past the pool's capacity, in which case no second pool is created
+        const BindGroupPoolStatistics statistics = freshDevice.internalBindGroupPoolStatistics();
+        if (statistics.poolCount > 1) {
+            CHECK(statistics.poolCount == 2);
+            const uint64_t secondPoolTextureCount = statistics.descriptorCapacity.textureCount - firstPoolStatistics.descriptorCapacity.textureCount;
+            const uint64_t secondPoolUniformBufferCount = statistics.descriptorCapacity.uniformBufferCount - firstPoolStatistics.descriptorCapacity.uniformBufferCount;
+            const uint64_t secondPoolStorageBufferCount = statistics.descriptorCapacity.storageBufferCount - firstPoolStatistics.descriptorCapacity.storageBufferCount;
+            CHECK(secondPoolTextureCount > firstPoolStatistics.descriptorCapacity.textureCount);
+            CHECK(secondPoolUniformBufferCount < firstPoolStatistics.descriptorCapacity.uniformBufferCount);
+            CHECK(secondPoolStorageBufferCount < firstPoolStatistics.descriptorCapacity.storageBufferCount);
+        }
+
+        bindGroups.clear();
+    }
 }
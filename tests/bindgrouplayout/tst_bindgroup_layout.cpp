@@ -304,4 +304,81 @@ TEST_SUITE("BindGroupLayout")
             CHECK(a != b);
         }
     }
+
+    TEST_CASE("Deduplication")
+    {
+        // GIVEN
+        Device dedupDevice = discreteGPUAdapter->createDevice(DeviceOptions{
+                .requestedFeatures = discreteGPUAdapter->features(),
+                .deduplicateLayouts = true,
+        });
+        const ResourceBindingLayout uboBinding = {
+            .binding = 0,
+            .resourceType = ResourceBindingType::UniformBuffer,
+            .shaderStages = ShaderStageFlags(ShaderStageFlagBits::VertexBit),
+        };
+        const ResourceBindingLayout ssboBinding = {
+            .binding = 1,
+            .resourceType = ResourceBindingType::StorageBuffer,
+            .shaderStages = ShaderStageFlags(ShaderStageFlagBits::VertexBit),
+        };
+
+        SUBCASE("Identical options share the same BindGroupLayout regardless of label and binding order")
+        {
+            // WHEN
+            BindGroupLayout a = dedupDevice.createBindGroupLayout(BindGroupLayoutOptions{
+                    .label = "A",
+                    .bindings = { uboBinding, ssboBinding },
+            });
+            BindGroupLayout b = dedupDevice.createBindGroupLayout(BindGroupLayoutOptions{
+                    .label = "B",
+                    .bindings = { ssboBinding, uboBinding },
+            });
+
+            // THEN
+            CHECK(a.isValid());
+            CHECK(a.handle() == b.handle());
+            CHECK(a.isCompatibleWith(b.handle()));
+        }
+
+        SUBCASE("Different flags yield different BindGroupLayouts")
+        {
+            if (!discreteGPUAdapter->features().bindGroupBindingUniformBufferUpdateAfterBind)
+                return;
+
+            // WHEN
+            BindGroupLayout a = dedupDevice.createBindGroupLayout(BindGroupLayoutOptions{
+                    .bindings = { uboBinding },
+            });
+            BindGroupLayout b = dedupDevice.createBindGroupLayout(BindGroupLayoutOptions{
+                    .bindings = { uboBinding },
+                    .flags = BindGroupLayoutFlagBits::UpdateAfterBind,
+            });
+
+            // THEN
+            CHECK(a.handle() != b.handle());
+        }
+
+        SUBCASE("The shared BindGroupLayout is kept alive until its last user is released")
+        {
+            // GIVEN
+            const BindGroupLayoutOptions options = { .bindings = { uboBinding } };
+            BindGroupLayout a = dedupDevice.createBindGroupLayout(options);
+            const Handle<BindGroupLayout_t> sharedHandle = a.handle();
+
+            {
+                BindGroupLayout b = dedupDevice.createBindGroupLayout(options);
+                REQUIRE(b.handle() == sharedHandle);
+            }
+
+            // THEN
+            CHECK(api->resourceManager()->getBindGroupLayout(sharedHandle) != nullptr);
+
+            // WHEN
+            a = {};
+
+            // THEN
+            CHECK(api->resourceManager()->getBindGroupLayout(sharedHandle) == nullptr);
+        }
+    }
 }
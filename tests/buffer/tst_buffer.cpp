@@ -15,6 +15,7 @@
 #include <KDGpu/instance.h>
 #include <KDGpu/vulkan/vulkan_graphics_api.h>
 
+#include <array>
 #include <set>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
@@ -231,6 +232,44 @@ TEST_SUITE("Buffer")
             // THEN -> It's all good
         }
 
+        SUBCASE("Persistently mapped Buffer")
+        {
+            // GIVEN
+            const BufferOptions bufferOptions = {
+                .size = 4 * sizeof(float),
+                .usage = BufferUsageFlagBits::VertexBufferBit,
+                .memoryUsage = MemoryUsage::CpuToGpu,
+                .persistentlyMapped = true,
+            };
+
+            const std::vector<float> vertexData = {
+                1.0f, -1.0f, 0.0f, 1.0f
+            };
+
+            // WHEN
+            Buffer b = device.createBuffer(bufferOptions, vertexData.data());
+
+            // THEN
+            CHECK(b.isValid());
+            auto *vulkanBuffer = api->resourceManager()->getBuffer(b.handle());
+            REQUIRE(vulkanBuffer->persistentMapping != nullptr);
+
+            // WHEN
+            const float *rawData = reinterpret_cast<const float *>(b.map());
+
+            // THEN
+            CHECK(rawData == vulkanBuffer->persistentMapping);
+            CHECK(rawData[0] == vertexData[0]);
+            CHECK(rawData[3] == vertexData[3]);
+
+            // WHEN
+            b.unmap();
+
+            // THEN -> Unmapping keeps the persistent mapping around
+            CHECK(vulkanBuffer->persistentMapping != nullptr);
+            CHECK(b.map() == rawData);
+        }
+
         SUBCASE("Flush")
         {
             // GIVEN
@@ -263,6 +302,35 @@ TEST_SUITE("Buffer")
             b.unmap();
         }
 
+        SUBCASE("Ranged Flush")
+        {
+            // GIVEN
+            const BufferOptions bufferOptions = {
+                .size = 1024,
+                .usage = BufferUsageFlagBits::UniformBufferBit,
+                .memoryUsage = MemoryUsage::CpuToGpu,
+                .persistentlyMapped = true,
+            };
+            Buffer b = device.createBuffer(bufferOptions);
+            REQUIRE(b.isValid());
+
+            // WHEN
+            const std::vector<float> data = { 1.0f, 2.0f, 3.0f, 4.0f };
+            auto *rawData = reinterpret_cast<uint8_t *>(b.map());
+            std::memcpy(rawData, data.data(), data.size() * sizeof(float));
+            std::memcpy(rawData + 512, data.data(), data.size() * sizeof(float));
+            b.flush(0, data.size() * sizeof(float));
+            const std::array<MappedBufferRange, 2> ranges = {
+                MappedBufferRange{ .offset = 0, .size = data.size() * sizeof(float) },
+                MappedBufferRange{ .offset = 512, .size = data.size() * sizeof(float) },
+            };
+            b.flush(ranges);
+            b.invalidate(ranges);
+
+            // THEN -> No validation errors, whether the memory is host coherent or not
+            CHECK(std::memcmp(rawData + 512, data.data(), data.size() * sizeof(float)) == 0);
+        }
+
         SUBCASE("Invalidate")
         {
             // GIVEN
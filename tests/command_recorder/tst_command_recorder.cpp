@@ -17,7 +17,9 @@
 #include <KDGpu/texture.h>
 #include <KDGpu/vulkan/vulkan_graphics_api.h>
 
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest.h>
@@ -380,6 +382,104 @@ TEST_CASE("CommandRecorder")
         gpuToCpu.unmap();
     }
 
+    SUBCASE("Record Command Buffers From Several Threads")
+    {
+        // GIVEN
+        constexpr size_t threadCount = 4;
+        const BufferOptions cpuGpuBufferOptions = {
+            .size = threadCount * sizeof(float),
+            .usage = BufferUsageFlagBits::TransferSrcBit,
+            .memoryUsage = MemoryUsage::CpuToGpu
+        };
+        const BufferOptions gpuCpuBufferOptions = {
+            .size = threadCount * sizeof(float),
+            .usage = BufferUsageFlagBits::TransferSrcBit | BufferUsageFlagBits::TransferDstBit,
+            .memoryUsage = MemoryUsage::GpuToCpu
+        };
+        const float initialData[] = { 1.0f, 2.0f, 3.0f, 4.0f };
+        Buffer cpuToGpu = device.createBuffer(cpuGpuBufferOptions, initialData);
+        Buffer gpuToCpu = device.createBuffer(gpuCpuBufferOptions);
+
+        CHECK(cpuToGpu.isValid());
+        CHECK(gpuToCpu.isValid());
+
+        // WHEN
+        std::vector<CommandBuffer> commandBuffers(threadCount);
+        {
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i < threadCount; ++i) {
+                threads.emplace_back([&, i] {
+                    CommandRecorder c = device.createCommandRecorder();
+                    c.copyBuffer(BufferCopy{
+                            .src = cpuToGpu,
+                            .srcOffset = i * sizeof(float),
+                            .dst = gpuToCpu,
+                            .dstOffset = i * sizeof(float),
+                            .byteSize = sizeof(float) });
+                    commandBuffers[i] = c.finish();
+                });
+            }
+            for (std::thread &thread : threads)
+                thread.join();
+        }
+
+        std::vector<Handle<CommandBuffer_t>> commandBufferHandles;
+        for (const CommandBuffer &commandBuffer : commandBuffers) {
+            CHECK(commandBuffer.isValid());
+            commandBufferHandles.push_back(commandBuffer);
+        }
+
+        transferQueue.submit(SubmitOptions{
+                .commandBuffers = commandBufferHandles });
+
+        device.waitUntilIdle();
+
+        // THEN
+        const float *m = reinterpret_cast<const float *>(gpuToCpu.map());
+
+        CHECK(m != nullptr);
+        CHECK(m[0] == initialData[0]);
+        CHECK(m[1] == initialData[1]);
+        CHECK(m[2] == initialData[2]);
+        CHECK(m[3] == initialData[3]);
+
+        gpuToCpu.unmap();
+
+        // Command buffers recorded on other threads are released from this one
+        commandBuffers.clear();
+    }
+
+    SUBCASE("Release The Command Pools Of A Worker Thread")
+    {
+        // GIVEN
+        VulkanDevice *vulkanDevice = api->resourceManager()->getDevice(device);
+        const size_t commandPoolCount = vulkanDevice->commandPools.size();
+        CommandBuffer commandBuffer;
+
+        // WHEN
+        std::thread worker([&] {
+            CommandRecorder c = device.createCommandRecorder();
+            commandBuffer = c.finish();
+            device.releaseThreadCommandPools();
+        });
+        worker.join();
+
+        // THEN -> Kept alive by the command buffer
+        CHECK(commandBuffer.isValid());
+        CHECK(vulkanDevice->commandPools.size() == commandPoolCount);
+        CHECK(vulkanDevice->retiredCommandPools.size() == 1);
+
+        // WHEN
+        commandBuffer = {};
+        std::thread otherWorker([&] {
+            device.releaseThreadCommandPools();
+        });
+        otherWorker.join();
+
+        // THEN
+        CHECK(vulkanDevice->retiredCommandPools.empty());
+    }
+
     SUBCASE("Blit Texture")
     {
         // GIVEN
@@ -213,4 +213,146 @@ TEST_SUITE("ComputePipeline")
             CHECK(c.isValid());
         }
     }
+
+    TEST_CASE("Pipeline Cache")
+    {
+        // GIVEN
+        PipelineLayout pipelineLayout = device.createPipelineLayout(PipelineLayoutOptions{});
+        const ComputePipelineOptions computePipelineOptions{
+            .layout = pipelineLayout,
+            .shaderStage = ComputeShaderStage{
+                    .shaderModule = computeShader.handle(),
+            },
+        };
+
+        SUBCASE("Pipeline creation populates the Device pipeline cache")
+        {
+            // WHEN
+            ComputePipeline c = device.createComputePipeline(computePipelineOptions);
+
+            // THEN
+            CHECK(c.isValid());
+            CHECK(!device.pipelineCacheData().empty());
+        }
+
+        SUBCASE("A Device can be seeded with previously retrieved pipeline cache data")
+        {
+            // GIVEN
+            ComputePipeline c = device.createComputePipeline(computePipelineOptions);
+            const std::vector<uint8_t> cacheData = device.pipelineCacheData();
+            REQUIRE(!cacheData.empty());
+
+            // WHEN
+            Device seededDevice = discreteGPUAdapter->createDevice(DeviceOptions{
+                    .pipelineCacheData = cacheData,
+            });
+
+            // THEN
+            CHECK(seededDevice.isValid());
+            CHECK(seededDevice.pipelineCacheData().size() >= cacheData.size());
+        }
+
+        SUBCASE("Incompatible pipeline cache data is discarded")
+        {
+            // WHEN
+            Device seededDevice = discreteGPUAdapter->createDevice(DeviceOptions{
+                    .pipelineCacheData = std::vector<uint8_t>(64, 0xff),
+            });
+
+            // THEN
+            CHECK(seededDevice.isValid());
+        }
+    }
+
+    TEST_CASE("Asynchronous Creation")
+    {
+        // GIVEN
+        PipelineLayout pipelineLayout = device.createPipelineLayout(PipelineLayoutOptions{});
+        const ComputePipelineOptions computePipelineOptions{
+            .layout = pipelineLayout,
+            .shaderStage = ComputeShaderStage{
+                    .shaderModule = computeShader.handle(),
+            },
+        };
+
+        SUBCASE("A ComputePipeline can be compiled on a worker thread")
+        {
+            // WHEN
+            std::future<ComputePipeline> future = device.createComputePipelineAsync(computePipelineOptions);
+            ComputePipeline c = future.get();
+
+            // THEN
+            CHECK(c.isValid());
+        }
+
+        SUBCASE("Several ComputePipelines can be compiled concurrently")
+        {
+            // WHEN
+            std::vector<std::future<ComputePipeline>> futures;
+            for (uint32_t i = 0; i < 8; ++i)
+                futures.emplace_back(device.createComputePipelineAsync(computePipelineOptions));
+
+            std::vector<ComputePipeline> pipelines;
+            for (auto &future : futures)
+                pipelines.emplace_back(future.get());
+
+            // THEN
+            for (size_t i = 0; i < pipelines.size(); ++i) {
+                CHECK(pipelines[i].isValid());
+                for (size_t j = i + 1; j < pipelines.size(); ++j)
+                    CHECK(pipelines[i] != pipelines[j]);
+            }
+        }
+    }
+
+    TEST_CASE("Batch Creation")
+    {
+        // GIVEN
+        PipelineLayout pipelineLayout = device.createPipelineLayout(PipelineLayoutOptions{});
+        std::vector<ComputePipelineOptions> computePipelineOptions;
+        for (uint32_t i = 0; i < 4; ++i) {
+            computePipelineOptions.emplace_back(ComputePipelineOptions{
+                    .layout = pipelineLayout,
+                    .shaderStage = ComputeShaderStage{
+                            .shaderModule = computeShader.handle(),
+                    },
+            });
+        }
+
+        SUBCASE("A ComputePipeline is created for each set of options")
+        {
+            // WHEN
+            std::vector<ComputePipeline> pipelines = device.createComputePipelines(computePipelineOptions);
+
+            // THEN
+            REQUIRE(pipelines.size() == computePipelineOptions.size());
+            for (const ComputePipeline &pipeline : pipelines)
+                CHECK(pipeline.isValid());
+        }
+
+        SUBCASE("Invalid options only fail their own pipeline")
+        {
+            // GIVEN
+            computePipelineOptions[1].layout = {};
+
+            // WHEN
+            std::vector<ComputePipeline> pipelines = device.createComputePipelines(computePipelineOptions);
+
+            // THEN
+            REQUIRE(pipelines.size() == computePipelineOptions.size());
+            CHECK(pipelines[0].isValid());
+            CHECK(!pipelines[1].isValid());
+            CHECK(pipelines[2].isValid());
+            CHECK(pipelines[3].isValid());
+        }
+
+        SUBCASE("An empty batch creates no pipelines")
+        {
+            // WHEN
+            std::vector<ComputePipeline> pipelines = device.createComputePipelines({});
+
+            // THEN
+            CHECK(pipelines.empty());
+        }
+    }
 }
@@ -0,0 +1,176 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/concurrent_staging_buffer_pool.h>
+#include <KDGpuUtils/resource_deleter.h>
+
+#include <KDGpu/buffer_options.h>
+#include <KDGpu/device.h>
+#include <KDGpu/instance.h>
+#include <KDGpu/vulkan/vulkan_graphics_api.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_SUITE("ConcurrentStagingBufferPool")
+{
+    std::unique_ptr<KDGpu::GraphicsApi> api = std::make_unique<KDGpu::VulkanGraphicsApi>();
+    KDGpu::Instance instance = api->createInstance(KDGpu::InstanceOptions{
+            .applicationName = "ConcurrentStagingBufferPool",
+            .applicationVersion = KDGPU_MAKE_API_VERSION(0, 1, 0, 0) });
+    KDGpu::Adapter *discreteGPUAdapter = instance.selectAdapter(KDGpu::AdapterDeviceType::Default);
+    KDGpu::Device device = discreteGPUAdapter->createDevice();
+    constexpr size_t MAX_FRAMES_IN_FLIGHT = 2;
+
+    TEST_CASE("Allocations")
+    {
+        SUBCASE("Regions are carved out of a shared bin")
+        {
+            // GIVEN
+            KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+            KDGpuUtils::ConcurrentStagingBufferPool pool(&device, &deleter, { .binSize = 1024 });
+            const std::vector<uint8_t> testData(100, 0xaa);
+
+            // WHEN
+            const KDGpuUtils::StagingRegion r1 = pool.stage(testData.data(), testData.size());
+            const KDGpuUtils::StagingRegion r2 = pool.stage(testData.data(), testData.size(), 64);
+
+            // THEN
+            REQUIRE(r1.isValid());
+            REQUIRE(r2.isValid());
+            CHECK(pool.binCount() == 1);
+            CHECK(r1.buffer == r2.buffer);
+            CHECK(r1.offset == 0);
+            CHECK(r2.offset % 64 == 0);
+            CHECK(r2.offset >= r1.offset + r1.size);
+            CHECK(std::memcmp(r2.data, testData.data(), testData.size()) == 0);
+        }
+
+        SUBCASE("Exhausted bins are replaced and large regions get their own bin")
+        {
+            // GIVEN
+            KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+            KDGpuUtils::ConcurrentStagingBufferPool pool(&device, &deleter, { .binSize = 1024 });
+
+            // WHEN
+            const KDGpuUtils::StagingRegion r1 = pool.allocate(768);
+            const KDGpuUtils::StagingRegion r2 = pool.allocate(768);
+            const KDGpuUtils::StagingRegion r3 = pool.allocate(4096);
+
+            // THEN
+            CHECK(pool.binCount() == 3);
+            CHECK(r1.buffer != r2.buffer);
+            CHECK(r2.offset == 0);
+            CHECK(r3.isValid());
+            CHECK(r3.size == 4096);
+        }
+
+        SUBCASE("Threads write into non overlapping regions")
+        {
+            // GIVEN
+            KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+            KDGpuUtils::ConcurrentStagingBufferPool pool(&device, &deleter, { .binSize = 4096 });
+            constexpr size_t ThreadCount = 4;
+            constexpr size_t AllocationsPerThread = 64;
+            constexpr size_t AllocationSize = 100;
+            std::vector<std::vector<KDGpuUtils::StagingRegion>> regions(ThreadCount);
+
+            // WHEN
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < ThreadCount; ++t) {
+                threads.emplace_back([&, t] {
+                    for (size_t i = 0; i < AllocationsPerThread; ++i) {
+                        KDGpuUtils::StagingRegion region = pool.allocate(AllocationSize, 16);
+                        if (region.isValid())
+                            std::memset(region.data, static_cast<int>(t), AllocationSize);
+                        regions[t].push_back(region);
+                    }
+                });
+            }
+            for (std::thread &thread : threads)
+                thread.join();
+
+            // THEN
+            std::vector<KDGpuUtils::StagingRegion> allRegions;
+            for (size_t t = 0; t < ThreadCount; ++t) {
+                for (const KDGpuUtils::StagingRegion &region : regions[t]) {
+                    REQUIRE(region.isValid());
+                    CHECK(region.offset % 16 == 0);
+                    CHECK(static_cast<const uint8_t *>(region.data)[0] == t);
+                    CHECK(static_cast<const uint8_t *>(region.data)[AllocationSize - 1] == t);
+                    allRegions.push_back(region);
+                }
+            }
+
+            std::sort(allRegions.begin(), allRegions.end(), [](const auto &a, const auto &b) {
+                return std::make_pair(a.buffer.index(), a.offset) < std::make_pair(b.buffer.index(), b.offset);
+            });
+            for (size_t i = 1; i < allRegions.size(); ++i) {
+                if (allRegions[i].buffer == allRegions[i - 1].buffer)
+                    CHECK(allRegions[i].offset >= allRegions[i - 1].offset + AllocationSize);
+            }
+        }
+    }
+
+    TEST_CASE("Copies")
+    {
+        // GIVEN
+        KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+        KDGpuUtils::ConcurrentStagingBufferPool pool(&device, &deleter);
+        KDGpu::Buffer dst = device.createBuffer(KDGpu::BufferOptions{
+                .size = 256,
+                .usage = KDGpu::BufferUsageFlagBits::TransferDstBit,
+                .memoryUsage = KDGpu::MemoryUsage::GpuOnly,
+        });
+        const std::vector<uint8_t> testData(128, 0xee);
+
+        // WHEN
+        std::thread worker([&] {
+            const KDGpuUtils::StagingRegion region = pool.stage(testData.data(), testData.size());
+            pool.enqueueBufferCopy(region, dst, 128);
+        });
+        worker.join();
+
+        KDGpu::CommandRecorder commandRecorder = device.createCommandRecorder();
+
+        // THEN
+        CHECK(pool.recordCopies(commandRecorder) == 1);
+        CHECK(pool.recordCopies(commandRecorder) == 0);
+    }
+
+    TEST_CASE("Bins are recycled when their frame comes back")
+    {
+        // GIVEN
+        KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+        KDGpuUtils::ConcurrentStagingBufferPool pool(&device, &deleter, { .binSize = 1024, .maxFreeBinCount = 1 });
+
+        // WHEN
+        const KDGpuUtils::StagingRegion frame0Region = pool.allocate(512);
+        pool.derefFrameIndex(1);
+        const KDGpuUtils::StagingRegion frame1Region = pool.allocate(512);
+
+        // THEN -> Each frame uses its own bin
+        CHECK(pool.binCount() == 2);
+        CHECK(frame0Region.buffer != frame1Region.buffer);
+
+        // WHEN
+        pool.derefFrameIndex(0);
+        const KDGpuUtils::StagingRegion recycledRegion = pool.allocate(512);
+
+        // THEN
+        CHECK(pool.binCount() == 2);
+        CHECK(recycledRegion.buffer == frame0Region.buffer);
+        CHECK(recycledRegion.offset == 0);
+    }
+}
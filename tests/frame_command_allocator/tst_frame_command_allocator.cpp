@@ -0,0 +1,80 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/frame_command_allocator.h>
+
+#include <KDGpu/device.h>
+#include <KDGpu/instance.h>
+#include <KDGpu/vulkan/vulkan_graphics_api.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_SUITE("FrameCommandAllocator")
+{
+    std::unique_ptr<KDGpu::GraphicsApi> api = std::make_unique<KDGpu::VulkanGraphicsApi>();
+    KDGpu::Instance instance = api->createInstance(KDGpu::InstanceOptions{
+            .applicationName = "FrameCommandAllocator",
+            .applicationVersion = KDGPU_MAKE_API_VERSION(0, 1, 0, 0) });
+    KDGpu::Adapter *discreteGPUAdapter = instance.selectAdapter(KDGpu::AdapterDeviceType::Default);
+    KDGpu::Device device = discreteGPUAdapter->createDevice();
+    constexpr size_t MAX_FRAMES_IN_FLIGHT = 2;
+
+    TEST_CASE("Creation")
+    {
+        // GIVEN
+        KDGpuUtils::FrameCommandAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT);
+
+        // THEN
+        CHECK(allocator.frameIndex() == 0);
+        REQUIRE(allocator.commandPools().size() == MAX_FRAMES_IN_FLIGHT);
+        for (const KDGpu::CommandPool &pool : allocator.commandPools())
+            CHECK(pool.isValid());
+    }
+
+    TEST_CASE("Command buffers are recycled once their frame is dereferenced")
+    {
+        // GIVEN
+        KDGpuUtils::FrameCommandAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT);
+        auto vkCommandBuffer = [](const KDGpu::CommandBuffer &commandBuffer) {
+            return api->resourceManager()->getCommandBuffer(commandBuffer)->commandBuffer;
+        };
+
+        // WHEN
+        VkCommandBuffer firstFrameCommandBuffer = VK_NULL_HANDLE;
+        {
+            KDGpu::CommandRecorder recorder = allocator.createCommandRecorder();
+            KDGpu::CommandBuffer commandBuffer = recorder.finish();
+            REQUIRE(commandBuffer.isValid());
+            firstFrameCommandBuffer = vkCommandBuffer(commandBuffer);
+
+            device.queues()[0].submit(KDGpu::SubmitOptions{ .commandBuffers = { commandBuffer } });
+            device.waitUntilIdle();
+        }
+
+        // THEN -> Another frame uses another pool
+        allocator.derefFrameIndex(1);
+        {
+            KDGpu::CommandRecorder recorder = allocator.createCommandRecorder();
+            KDGpu::CommandBuffer commandBuffer = recorder.finish();
+            REQUIRE(commandBuffer.isValid());
+            CHECK(vkCommandBuffer(commandBuffer) != firstFrameCommandBuffer);
+        }
+
+        // THEN -> Going back to the first frame reuses its command buffer
+        allocator.derefFrameIndex(0);
+        {
+            KDGpu::CommandRecorder recorder = allocator.createCommandRecorder();
+            KDGpu::CommandBuffer commandBuffer = recorder.finish();
+            REQUIRE(commandBuffer.isValid());
+            CHECK(vkCommandBuffer(commandBuffer) == firstFrameCommandBuffer);
+        }
+    }
+}
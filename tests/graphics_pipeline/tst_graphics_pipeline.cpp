@@ -529,4 +529,110 @@ TEST_SUITE("GraphicsPipeline")
             CHECK(hashValue1 == hashValue2);
         }
     }
+
+    TEST_CASE("Deduplication")
+    {
+        // GIVEN
+        Device dedupDevice = adapter->createDevice(DeviceOptions{
+                .requestedFeatures = adapter->features(),
+                .deduplicateGraphicsPipelines = true,
+        });
+        auto dedupVertexShader = dedupDevice.createShaderModule(readShaderFile(vertexShaderPath));
+        auto dedupFragmentShader = dedupDevice.createShaderModule(readShaderFile(fragmentShaderPath));
+        PipelineLayout pipelineLayout = dedupDevice.createPipelineLayout(PipelineLayoutOptions{});
+
+        const GraphicsPipelineOptions pipelineOptions = {
+            .shaderStages = {
+                    { .shaderModule = dedupVertexShader.handle(), .stage = ShaderStageFlagBits::VertexBit },
+                    { .shaderModule = dedupFragmentShader.handle(), .stage = ShaderStageFlagBits::FragmentBit },
+            },
+            .layout = pipelineLayout.handle(),
+            .vertex = {
+                    .buffers = {
+                            { .binding = 0, .stride = 2 * 4 * sizeof(float) },
+                    },
+                    .attributes = {
+                            { .location = 0, .binding = 0, .format = Format::R32G32B32A32_SFLOAT }, // Position
+                            { .location = 1, .binding = 0, .format = Format::R32G32B32A32_SFLOAT, .offset = 4 * sizeof(float) } // Color
+                    },
+            },
+            .renderTargets = {
+                    { .format = Format::R8G8B8A8_UNORM },
+            },
+        };
+
+        SUBCASE("Identical options share the same pipeline")
+        {
+            // WHEN
+            GraphicsPipeline a = dedupDevice.createGraphicsPipeline(pipelineOptions);
+            GraphicsPipeline b = dedupDevice.createGraphicsPipeline(pipelineOptions);
+
+            // THEN
+            CHECK(a.isValid());
+            CHECK(a == b);
+            const CacheStatistics stats = dedupDevice.graphicsPipelineRegistryStatistics();
+            CHECK(stats.hits == 1);
+            CHECK(stats.misses == 1);
+            CHECK(stats.entryCount == 1);
+        }
+
+        SUBCASE("Different options yield different pipelines")
+        {
+            // GIVEN
+            GraphicsPipelineOptions otherOptions = pipelineOptions;
+            otherOptions.primitive.topology = PrimitiveTopology::LineList;
+
+            // WHEN
+            GraphicsPipeline a = dedupDevice.createGraphicsPipeline(pipelineOptions);
+            GraphicsPipeline b = dedupDevice.createGraphicsPipeline(otherOptions);
+
+            // THEN
+            CHECK(a != b);
+            CHECK(dedupDevice.graphicsPipelineRegistryStatistics().entryCount == 2);
+        }
+
+        SUBCASE("Identical options within a batch are only compiled once")
+        {
+            // GIVEN
+            GraphicsPipelineOptions otherOptions = pipelineOptions;
+            otherOptions.primitive.topology = PrimitiveTopology::LineList;
+            const std::vector<GraphicsPipelineOptions> batch = { pipelineOptions, otherOptions, pipelineOptions };
+
+            // WHEN
+            std::vector<GraphicsPipeline> pipelines = dedupDevice.createGraphicsPipelines(batch);
+
+            // THEN
+            REQUIRE(pipelines.size() == 3);
+            CHECK(pipelines[0].isValid());
+            CHECK(pipelines[1].isValid());
+            CHECK(pipelines[0] == pipelines[2]);
+            CHECK(pipelines[0] != pipelines[1]);
+            const CacheStatistics stats = dedupDevice.graphicsPipelineRegistryStatistics();
+            CHECK(stats.misses == 2);
+            CHECK(stats.hits == 1);
+            CHECK(stats.entryCount == 2);
+        }
+
+        SUBCASE("The shared pipeline is kept alive until its last user is released")
+        {
+            // GIVEN
+            GraphicsPipeline a = dedupDevice.createGraphicsPipeline(pipelineOptions);
+            const Handle<GraphicsPipeline_t> sharedHandle = a.handle();
+
+            {
+                GraphicsPipeline b = dedupDevice.createGraphicsPipeline(pipelineOptions);
+                REQUIRE(b.handle() == sharedHandle);
+            }
+
+            // THEN
+            CHECK(api->resourceManager()->getGraphicsPipeline(sharedHandle) != nullptr);
+            CHECK(dedupDevice.graphicsPipelineRegistryStatistics().entryCount == 1);
+
+            // WHEN
+            a = {};
+
+            // THEN
+            CHECK(dedupDevice.graphicsPipelineRegistryStatistics().entryCount == 0);
+        }
+    }
 }
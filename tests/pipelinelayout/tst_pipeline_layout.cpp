@@ -8,6 +8,8 @@
   Contact KDAB at <info@kdab.com> for commercial licensing options.
 */
 
+#include <KDGpu/bind_group_layout.h>
+#include <KDGpu/bind_group_layout_options.h>
 #include <KDGpu/pipeline_layout.h>
 #include <KDGpu/pipeline_layout_options.h>
 #include <KDGpu/device.h>
@@ -126,4 +128,87 @@ TEST_SUITE("PipelineLayout")
             CHECK(a == a);
         }
     }
+
+    TEST_CASE("Deduplication")
+    {
+        // GIVEN
+        Device dedupDevice = discreteGPUAdapter->createDevice(DeviceOptions{
+                .deduplicateLayouts = true,
+        });
+        const BindGroupLayoutOptions bindGroupLayoutOptions = {
+            .bindings = { { .binding = 0,
+                            .resourceType = ResourceBindingType::UniformBuffer,
+                            .shaderStages = ShaderStageFlags(ShaderStageFlagBits::VertexBit) } }
+        };
+        const BindGroupLayout bindGroupLayout = dedupDevice.createBindGroupLayout(bindGroupLayoutOptions);
+        const PipelineLayoutOptions pipelineLayoutOptions = {
+            .bindGroupLayouts = { bindGroupLayout },
+            .pushConstantRanges = { { .offset = 0, .size = 16, .shaderStages = ShaderStageFlags(ShaderStageFlagBits::VertexBit) } },
+        };
+
+        SUBCASE("Identical options share the same PipelineLayout")
+        {
+            // GIVEN
+            PipelineLayoutOptions labelledOptions = pipelineLayoutOptions;
+            labelledOptions.label = "Labelled";
+
+            // WHEN
+            PipelineLayout a = dedupDevice.createPipelineLayout(pipelineLayoutOptions);
+            PipelineLayout b = dedupDevice.createPipelineLayout(labelledOptions);
+
+            // THEN
+            CHECK(a.isValid());
+            CHECK(a == b);
+        }
+
+        SUBCASE("Identical BindGroupLayouts yield the same PipelineLayout")
+        {
+            // GIVEN
+            const BindGroupLayout otherBindGroupLayout = dedupDevice.createBindGroupLayout(bindGroupLayoutOptions);
+            REQUIRE(otherBindGroupLayout.handle() == bindGroupLayout.handle());
+
+            // WHEN
+            PipelineLayout a = dedupDevice.createPipelineLayout(pipelineLayoutOptions);
+            PipelineLayout b = dedupDevice.createPipelineLayout(PipelineLayoutOptions{
+                    .bindGroupLayouts = { otherBindGroupLayout },
+                    .pushConstantRanges = pipelineLayoutOptions.pushConstantRanges,
+            });
+
+            // THEN
+            CHECK(a == b);
+        }
+
+        SUBCASE("Different push constant ranges yield different PipelineLayouts")
+        {
+            // WHEN
+            PipelineLayout a = dedupDevice.createPipelineLayout(pipelineLayoutOptions);
+            PipelineLayout b = dedupDevice.createPipelineLayout(PipelineLayoutOptions{
+                    .bindGroupLayouts = { bindGroupLayout },
+            });
+
+            // THEN
+            CHECK(a != b);
+        }
+
+        SUBCASE("The shared PipelineLayout is kept alive until its last user is released")
+        {
+            // GIVEN
+            PipelineLayout a = dedupDevice.createPipelineLayout(pipelineLayoutOptions);
+            const Handle<PipelineLayout_t> sharedHandle = a.handle();
+
+            {
+                PipelineLayout b = dedupDevice.createPipelineLayout(pipelineLayoutOptions);
+                REQUIRE(b.handle() == sharedHandle);
+            }
+
+            // THEN
+            CHECK(api->resourceManager()->getPipelineLayout(sharedHandle) != nullptr);
+
+            // WHEN
+            a = {};
+
+            // THEN
+            CHECK(api->resourceManager()->getPipelineLayout(sharedHandle) == nullptr);
+        }
+    }
 }
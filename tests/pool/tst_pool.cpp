@@ -10,7 +10,10 @@
 
 #include <KDGpu/pool.h>
 
+#include <atomic>
 #include <set>
+#include <thread>
+#include <vector>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest.h>
@@ -257,3 +260,75 @@ TEST_CASE("Non-trivial types")
         MyType::ms_destructorCalled = false;
     }
 }
+
+struct ThreadSafeIntPool_tag;
+using ThreadSafeIntPool = KDGpu::Pool<int, ThreadSafeIntPool_tag, true>;
+
+TEST_CASE("Thread safety")
+{
+    SUBCASE("Values can be inserted concurrently from several threads")
+    {
+        ThreadSafeIntPool pool;
+        constexpr int threadCount = 4;
+        constexpr int valuesPerThread = 256;
+
+        std::vector<std::vector<KDGpu::Handle<ThreadSafeIntPool_tag>>> handles(threadCount);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < valuesPerThread; ++i)
+                    handles[t].push_back(pool.emplace(t * valuesPerThread + i));
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+
+        REQUIRE(pool.size() == threadCount * valuesPerThread);
+        for (int t = 0; t < threadCount; ++t) {
+            for (int i = 0; i < valuesPerThread; ++i)
+                REQUIRE(*pool.get(handles[t][i]) == t * valuesPerThread + i);
+        }
+    }
+
+    SUBCASE("Entries can be removed and reused concurrently")
+    {
+        ThreadSafeIntPool pool(4);
+        constexpr int threadCount = 4;
+        constexpr int iterations = 1000;
+
+        std::vector<std::thread> threads;
+        std::atomic<int> failures{ 0 };
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < iterations; ++i) {
+                    const auto handle = pool.emplace(t);
+                    if (pool.get(handle) == nullptr || *pool.get(handle) != t)
+                        ++failures;
+                    pool.remove(handle);
+                    if (pool.get(handle) != nullptr)
+                        ++failures;
+                }
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+
+        REQUIRE(failures == 0);
+        REQUIRE(pool.size() == 0);
+        // Removed slots are recycled rather than growing the pool
+        REQUIRE(pool.capacity() <= 8);
+    }
+
+    SUBCASE("Pointers remain valid while the pool grows")
+    {
+        ThreadSafeIntPool pool(1);
+        const auto handle = pool.emplace(42);
+        const int *value = pool.get(handle);
+
+        for (int i = 0; i < 1024; ++i)
+            pool.emplace(i);
+
+        REQUIRE(pool.get(handle) == value);
+        REQUIRE(*value == 42);
+    }
+}
@@ -0,0 +1,151 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/readback_pool.h>
+
+#include <KDGpu/buffer_options.h>
+#include <KDGpu/device.h>
+#include <KDGpu/fence.h>
+#include <KDGpu/instance.h>
+#include <KDGpu/vulkan/vulkan_graphics_api.h>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_SUITE("ReadbackPool")
+{
+    std::unique_ptr<KDGpu::GraphicsApi> api = std::make_unique<KDGpu::VulkanGraphicsApi>();
+    KDGpu::Instance instance = api->createInstance(KDGpu::InstanceOptions{
+            .applicationName = "ReadbackPool",
+            .applicationVersion = KDGPU_MAKE_API_VERSION(0, 1, 0, 0) });
+    KDGpu::Adapter *discreteGPUAdapter = instance.selectAdapter(KDGpu::AdapterDeviceType::Default);
+    KDGpu::Device device = discreteGPUAdapter->createDevice();
+    KDGpu::Queue &queue = device.queues()[0];
+    constexpr size_t MAX_FRAMES_IN_FLIGHT = 2;
+
+    const std::array<uint32_t, 4> sourceData = { 0xdead, 0xbeef, 0xcafe, 0xf00d };
+    KDGpu::Buffer srcBuffer = device.createBuffer(KDGpu::BufferOptions{
+                                                          .size = sizeof(sourceData),
+                                                          .usage = KDGpu::BufferUsageFlagBits::TransferSrcBit,
+                                                          .memoryUsage = KDGpu::MemoryUsage::CpuToGpu,
+                                                  },
+                                                  sourceData.data());
+
+    KDGpuUtils::ReadbackFuture recordAndSubmitReadback(KDGpuUtils::ReadbackPool & pool, KDGpu::Fence & fence)
+    {
+        KDGpu::CommandRecorder commandRecorder = device.createCommandRecorder();
+        KDGpuUtils::ReadbackFuture future = pool.readBuffer(commandRecorder, KDGpuUtils::ReadbackBufferOptions{
+                                                                                     .srcBuffer = srcBuffer,
+                                                                                     .byteSize = sizeof(sourceData),
+                                                                             });
+        KDGpu::CommandBuffer commandBuffer = commandRecorder.finish();
+        queue.submit(KDGpu::SubmitOptions{ .commandBuffers = { commandBuffer }, .signalFence = fence });
+        pool.markSubmitted(fence);
+        fence.wait();
+        return future;
+    }
+
+    TEST_CASE("Futures resolve once the fence has signalled")
+    {
+        // GIVEN
+        KDGpuUtils::ReadbackPool pool(&device, MAX_FRAMES_IN_FLIGHT);
+        KDGpu::Fence fence = device.createFence({ .createSignalled = false });
+
+        // WHEN
+        KDGpuUtils::ReadbackFuture future = recordAndSubmitReadback(pool, fence);
+
+        // THEN -> Nothing resolves before polling
+        CHECK(pool.pendingReadbackCount() == 1);
+        CHECK(future.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+        // WHEN
+        const size_t resolvedCount = pool.poll();
+
+        // THEN
+        CHECK(resolvedCount == 1);
+        CHECK(pool.pendingReadbackCount() == 0);
+        REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        const std::span<const std::byte> data = future.get();
+        REQUIRE(data.size() == sizeof(sourceData));
+        CHECK(std::memcmp(data.data(), sourceData.data(), sizeof(sourceData)) == 0);
+    }
+
+    TEST_CASE("Dereferencing a frame resolves its readbacks and later recycles their buffers")
+    {
+        // GIVEN
+        KDGpuUtils::ReadbackPool pool(&device, MAX_FRAMES_IN_FLIGHT);
+        KDGpu::Fence fence = device.createFence({ .createSignalled = false });
+
+        // WHEN
+        KDGpuUtils::ReadbackFuture future = recordAndSubmitReadback(pool, fence);
+        pool.derefFrameIndex(1);
+
+        // THEN -> Frame 0 isn't done as far as the pool knows
+        CHECK(pool.pendingReadbackCount() == 1);
+
+        // WHEN
+        pool.derefFrameIndex(0);
+
+        // THEN -> Resolved but the buffer is kept for the data to be read
+        CHECK(pool.pendingReadbackCount() == 0);
+        REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        CHECK(std::memcmp(future.get().data(), sourceData.data(), sizeof(sourceData)) == 0);
+        CHECK(pool.freeBufferCount() == 0);
+
+        // WHEN
+        pool.derefFrameIndex(1);
+        pool.derefFrameIndex(0);
+
+        // THEN
+        CHECK(pool.freeBufferCount() == 1);
+    }
+
+    TEST_CASE("Dereferencing a frame breaks the promise of readbacks never marked as submitted")
+    {
+        // GIVEN
+        KDGpuUtils::ReadbackPool pool(&device, MAX_FRAMES_IN_FLIGHT);
+        KDGpu::CommandRecorder commandRecorder = device.createCommandRecorder();
+
+        // WHEN -> Recorded but neither submitted nor marked as submitted
+        KDGpuUtils::ReadbackFuture future = pool.readBuffer(commandRecorder, KDGpuUtils::ReadbackBufferOptions{
+                                                                                     .srcBuffer = srcBuffer,
+                                                                                     .byteSize = sizeof(sourceData),
+                                                                             });
+        pool.derefFrameIndex(1);
+        pool.derefFrameIndex(0);
+
+        // THEN
+        CHECK(pool.pendingReadbackCount() == 0);
+        REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        CHECK_THROWS_AS(future.get(), std::future_error);
+    }
+
+    TEST_CASE("Reading back nothing records nothing")
+    {
+        // GIVEN
+        KDGpuUtils::ReadbackPool pool(&device, MAX_FRAMES_IN_FLIGHT);
+        KDGpu::CommandRecorder commandRecorder = device.createCommandRecorder();
+
+        // WHEN
+        KDGpuUtils::ReadbackFuture future = pool.readBuffer(commandRecorder, KDGpuUtils::ReadbackBufferOptions{
+                                                                                     .srcBuffer = srcBuffer,
+                                                                                     .byteSize = 0,
+                                                                             });
+
+        // THEN -> Ready with an empty span, without a pending readback
+        CHECK(pool.pendingReadbackCount() == 0);
+        REQUIRE(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        CHECK(future.get().empty());
+    }
+}
@@ -29,11 +29,14 @@
 #include <KDGpu/bind_group_layout_options.h>
 #include <KDGpu/bind_group_options.h>
 #include <KDGpu/sampler.h>
+#include <KDGpu/shader_module.h>
 #include <KDGpu/pipeline_layout_options.h>
 
 #include <KDUtils/file.h>
 #include <KDUtils/dir.h>
 
+#include <array>
+
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest.h>
 
@@ -78,6 +81,8 @@ TEST_SUITE("RenderPassCommandRecorder")
 
     Adapter *discreteGPUAdapter = instance.selectAdapter(AdapterDeviceType::Default);
     const bool hasDynamicRenderingSupport = discreteGPUAdapter->features().dynamicRendering;
+    const bool hasMultiDrawIndirectSupport = discreteGPUAdapter->features().multiDrawIndirect;
+    const bool hasDrawIndirectCountSupport = discreteGPUAdapter->features().drawIndirectCount;
 
     TEST_CASE("RenderPassCommandRecorder")
     {
@@ -356,6 +361,141 @@ TEST_SUITE("RenderPassCommandRecorder")
             CHECK(renderPassRecorderNoDepth.isValid());
         }
 
+        SUBCASE("Skips redundant state changes")
+        {
+            // GIVEN
+            CommandRecorder commandRecorder = device.createCommandRecorder();
+            const RenderPassCommandRecorderOptions renderPassOptions{
+                .colorAttachments = {
+                        { .view = colorTextureView,
+                          .clearValue = { 0.3f, 0.3f, 0.3f, 1.0f },
+                          .finalLayout = TextureLayout::PresentSrc } },
+                .depthStencilAttachment = {
+                        .view = depthTextureView,
+                }
+            };
+            const Buffer vertexBuffer = device.createBuffer(BufferOptions{
+                    .size = 3 * 2 * 4 * sizeof(float),
+                    .usage = BufferUsageFlagBits::VertexBufferBit,
+                    .memoryUsage = MemoryUsage::CpuToGpu,
+            });
+            const Buffer indexBuffer = device.createBuffer(BufferOptions{
+                    .size = 3 * sizeof(uint32_t),
+                    .usage = BufferUsageFlagBits::IndexBufferBit,
+                    .memoryUsage = MemoryUsage::CpuToGpu,
+            });
+            const Viewport viewport{ .x = 0.0f, .y = 0.0f, .width = 128.0f, .height = 128.0f };
+            const Rect2D scissor{ .offset = { 0, 0 }, .extent = { 128, 128 } };
+
+            // WHEN
+            RenderPassCommandRecorder renderPassRecorder = commandRecorder.beginRenderPass(renderPassOptions);
+            renderPassRecorder.setPipeline(pipeline);
+            renderPassRecorder.setPipeline(pipeline);
+            renderPassRecorder.setVertexBuffer(0, vertexBuffer);
+            renderPassRecorder.setVertexBuffer(0, vertexBuffer);
+            renderPassRecorder.setVertexBuffer(0, vertexBuffer, 4 * sizeof(float));
+            renderPassRecorder.setIndexBuffer(indexBuffer);
+            renderPassRecorder.setIndexBuffer(indexBuffer);
+            renderPassRecorder.setIndexBuffer(indexBuffer, 0, IndexType::Uint16);
+            renderPassRecorder.setViewport(viewport);
+            renderPassRecorder.setViewport(viewport);
+            renderPassRecorder.setScissor(scissor);
+            renderPassRecorder.setScissor(scissor);
+            renderPassRecorder.end();
+
+            CommandBuffer commandBuffer = commandRecorder.finish();
+
+            // THEN
+            const RedundantStateStatistics stats = renderPassRecorder.redundantStateStatistics();
+            CHECK(stats.skippedPipelineBinds == 1);
+            CHECK(stats.skippedVertexBufferBinds == 1);
+            CHECK(stats.skippedIndexBufferBinds == 1);
+            CHECK(stats.skippedBindGroupBinds == 0);
+            CHECK(stats.skippedViewports == 1);
+            CHECK(stats.skippedScissors == 1);
+        }
+
+        SUBCASE("Binds several vertex buffers at once")
+        {
+            // GIVEN
+            CommandRecorder commandRecorder = device.createCommandRecorder();
+            const RenderPassCommandRecorderOptions renderPassOptions{
+                .colorAttachments = {
+                        { .view = colorTextureView,
+                          .clearValue = { 0.3f, 0.3f, 0.3f, 1.0f },
+                          .finalLayout = TextureLayout::PresentSrc } },
+                .depthStencilAttachment = {
+                        .view = depthTextureView,
+                }
+            };
+            const Buffer vertexBuffer = device.createBuffer(BufferOptions{
+                    .size = 3 * 2 * 4 * sizeof(float),
+                    .usage = BufferUsageFlagBits::VertexBufferBit,
+                    .memoryUsage = MemoryUsage::CpuToGpu,
+            });
+            const std::array<Handle<Buffer_t>, 3> buffers = { vertexBuffer, vertexBuffer, vertexBuffer };
+            const std::array<DeviceSize, 3> offsets = { 0, 16, 32 };
+            const std::array<DeviceSize, 3> otherOffsets = { 0, 32, 32 };
+
+            // WHEN
+            RenderPassCommandRecorder renderPassRecorder = commandRecorder.beginRenderPass(renderPassOptions);
+            renderPassRecorder.setPipeline(pipeline);
+            renderPassRecorder.setVertexBuffers(0, buffers, offsets);
+            renderPassRecorder.setVertexBuffers(0, buffers, offsets);
+            renderPassRecorder.setVertexBuffers(0, buffers, otherOffsets);
+            renderPassRecorder.setVertexBuffer(2, vertexBuffer, 32);
+            renderPassRecorder.end();
+
+            CommandBuffer commandBuffer = commandRecorder.finish();
+
+            // THEN -> Fully redundant, then only binding 1 changed, then binding 2 was already set
+            CHECK(renderPassRecorder.redundantStateStatistics().skippedVertexBufferBinds == 3 + 2 + 1);
+        }
+
+        SUBCASE("Records contiguous indirect draws")
+        {
+            // GIVEN
+            CommandRecorder commandRecorder = device.createCommandRecorder();
+            const RenderPassCommandRecorderOptions renderPassOptions{
+                .colorAttachments = {
+                        { .view = colorTextureView,
+                          .clearValue = { 0.3f, 0.3f, 0.3f, 1.0f },
+                          .finalLayout = TextureLayout::PresentSrc } },
+                .depthStencilAttachment = {
+                        .view = depthTextureView,
+                }
+            };
+            const Buffer vertexBuffer = device.createBuffer(BufferOptions{
+                    .size = 3 * 2 * 4 * sizeof(float),
+                    .usage = BufferUsageFlagBits::VertexBufferBit,
+                    .memoryUsage = MemoryUsage::CpuToGpu,
+            });
+            const Buffer indirectBuffer = device.createBuffer(BufferOptions{
+                    .size = 4 * 4 * sizeof(uint32_t),
+                    .usage = BufferUsageFlagBits::IndirectBufferBit,
+                    .memoryUsage = MemoryUsage::CpuToGpu,
+            });
+            const std::array<DrawIndirectCommand, 4> drawCommands = {
+                DrawIndirectCommand{ .buffer = indirectBuffer, .offset = 0, .drawCount = 1 },
+                DrawIndirectCommand{ .buffer = indirectBuffer, .offset = 4 * sizeof(uint32_t), .drawCount = 1 },
+                DrawIndirectCommand{ .buffer = indirectBuffer, .offset = 2 * 4 * sizeof(uint32_t), .drawCount = 1 },
+                DrawIndirectCommand{ .buffer = indirectBuffer, .offset = 0, .drawCount = 1 }, // Not contiguous
+            };
+
+            // WHEN
+            RenderPassCommandRecorder renderPassRecorder = commandRecorder.beginRenderPass(renderPassOptions);
+            renderPassRecorder.setPipeline(pipeline);
+            renderPassRecorder.setVertexBuffer(0, vertexBuffer);
+            renderPassRecorder.drawIndirect(drawCommands);
+            renderPassRecorder.end();
+
+            CommandBuffer commandBuffer = commandRecorder.finish();
+
+            // THEN -> Never merged since multiDrawIndirect wasn't requested on the device
+            CHECK(commandBuffer.isValid());
+            CHECK(renderPassRecorder.redundantStateStatistics().mergedIndirectDraws == 0);
+        }
+
         SUBCASE("Destruction")
         {
             // GIVEN
@@ -524,6 +664,17 @@ TEST_SUITE("RenderPassCommandRecorder")
                                          },
                                          pushBindGroupPipelineLayout);
 
+        // Push the same bindings again through a descriptor update template
+        const std::array<BindingResource, 2> resources = {
+            BindingResource(UniformBufferBinding{ .buffer = uniformBuffer }),
+            BindingResource(TextureViewSamplerBinding{ .textureView = textureView, .sampler = sampler }),
+        };
+        renderPassRecorder.pushBindGroupWithTemplate(0, resources, pushBindGroupPipelineLayout);
+
+        // THEN
+        auto *vulkanPipelineLayout = api->resourceManager()->getPipelineLayout(pushBindGroupPipelineLayout);
+        CHECK(vulkanPipelineLayout->pushDescriptorUpdateTemplates.size() == 1);
+
         renderPassRecorder.end();
         CommandBuffer commandBuffer = commandRecorder.finish();
 
@@ -1023,6 +1174,184 @@ TEST_SUITE("RenderPassCommandRecorder")
         }
     }
 
+    struct IndirectDrawFixture {
+        static constexpr size_t drawRecordSize = 4 * sizeof(uint32_t);
+        static constexpr size_t drawIndexedRecordSize = 5 * sizeof(uint32_t);
+
+        Device device = discreteGPUAdapter->createDevice(DeviceOptions{
+                .requestedFeatures = {
+                        .multiDrawIndirect = hasMultiDrawIndirectSupport,
+                        .drawIndirectCount = hasDrawIndirectCountSupport,
+                },
+        });
+        ShaderModule vertexShader = device.createShaderModule(readShaderFile(assetPath() + "/shaders/tests/render_pass_command_recorder/triangle.vert.spv"));
+        ShaderModule fragmentShader = device.createShaderModule(readShaderFile(assetPath() + "/shaders/tests/render_pass_command_recorder/triangle.frag.spv"));
+        Texture colorTexture = device.createTexture(TextureOptions{
+                .type = TextureType::TextureType2D,
+                .format = Format::R8G8B8A8_UNORM,
+                .extent = { 256, 256, 1 },
+                .mipLevels = 1,
+                .samples = SampleCountFlagBits::Samples1Bit,
+                .usage = TextureUsageFlagBits::ColorAttachmentBit,
+                .memoryUsage = MemoryUsage::GpuOnly,
+        });
+        TextureView colorTextureView = colorTexture.createView();
+        PipelineLayout pipelineLayout = device.createPipelineLayout();
+        GraphicsPipeline pipeline = device.createGraphicsPipeline(GraphicsPipelineOptions{
+                .shaderStages = {
+                        { .shaderModule = vertexShader.handle(), .stage = ShaderStageFlagBits::VertexBit },
+                        { .shaderModule = fragmentShader.handle(), .stage = ShaderStageFlagBits::FragmentBit },
+                },
+                .layout = pipelineLayout.handle(),
+                .vertex = {
+                        .buffers = {
+                                { .binding = 0, .stride = 2 * 4 * sizeof(float) },
+                        },
+                        .attributes = {
+                                { .location = 0, .binding = 0, .format = Format::R32G32B32A32_SFLOAT }, // Position
+                                { .location = 1, .binding = 0, .format = Format::R32G32B32A32_SFLOAT, .offset = 4 * sizeof(float) }, // Color
+                        },
+                },
+                .renderTargets = {
+                        { .format = Format::R8G8B8A8_UNORM },
+                },
+        });
+        RenderPassCommandRecorderOptions renderPassOptions{
+            .colorAttachments = {
+                    { .view = colorTextureView,
+                      .clearValue = { 0.3f, 0.3f, 0.3f, 1.0f },
+                      .finalLayout = TextureLayout::ColorAttachmentOptimal } },
+        };
+        Buffer vertexBuffer = device.createBuffer(BufferOptions{
+                .size = 3 * 2 * 4 * sizeof(float),
+                .usage = BufferUsageFlagBits::VertexBufferBit,
+                .memoryUsage = MemoryUsage::CpuToGpu,
+        });
+        Buffer indexBuffer = device.createBuffer(BufferOptions{
+                .size = 3 * sizeof(uint32_t),
+                .usage = BufferUsageFlagBits::IndexBufferBit,
+                .memoryUsage = MemoryUsage::CpuToGpu,
+        });
+        Buffer indirectBuffer = device.createBuffer(BufferOptions{
+                .size = 8 * drawIndexedRecordSize,
+                .usage = BufferUsageFlagBits::IndirectBufferBit,
+                .memoryUsage = MemoryUsage::CpuToGpu,
+        });
+        Buffer otherIndirectBuffer = device.createBuffer(BufferOptions{
+                .size = 8 * drawIndexedRecordSize,
+                .usage = BufferUsageFlagBits::IndirectBufferBit,
+                .memoryUsage = MemoryUsage::CpuToGpu,
+        });
+    };
+
+    TEST_CASE_FIXTURE(IndirectDrawFixture, "RenderPassCommandRecorder - Merges contiguous indirect draws" * doctest::skip(!hasMultiDrawIndirectSupport))
+    {
+        REQUIRE(pipeline.isValid());
+
+        SUBCASE("Same buffer, same stride and contiguous offsets")
+        {
+            // GIVEN
+            CommandRecorder commandRecorder = device.createCommandRecorder();
+            const std::array<DrawIndirectCommand, 7> drawCommands = {
+                // Merged into one draw of 3
+                DrawIndirectCommand{ .buffer = indirectBuffer, .offset = 0, .drawCount = 1 },
+                DrawIndirectCommand{ .buffer = indirectBuffer, .offset = drawRecordSize, .drawCount = 1 },
+                DrawIndirectCommand{ .buffer = indirectBuffer, .offset = 2 * drawRecordSize, .drawCount = 1, .stride = drawRecordSize },
+                // Not contiguous
+                DrawIndirectCommand{ .buffer = indirectBuffer, .offset = 0, .drawCount = 1 },
+                // Another buffer
+                DrawIndirectCommand{ .buffer = otherIndirectBuffer, .offset = drawRecordSize, .drawCount = 1 },
+                // Another stride
+                DrawIndirectCommand{ .buffer = otherIndirectBuffer, .offset = 2 * drawRecordSize, .drawCount = 1, .stride = 2 * drawRecordSize },
+                // Merged with the previous one, contiguous for its stride
+                DrawIndirectCommand{ .buffer = otherIndirectBuffer, .offset = 4 * drawRecordSize, .drawCount = 2, .stride = 2 * drawRecordSize },
+            };
+
+            // WHEN
+            RenderPassCommandRecorder renderPassRecorder = commandRecorder.beginRenderPass(renderPassOptions);
+            renderPassRecorder.setPipeline(pipeline);
+            renderPassRecorder.setVertexBuffer(0, vertexBuffer);
+            renderPassRecorder.drawIndirect(drawCommands);
+            renderPassRecorder.end();
+
+            CommandBuffer commandBuffer = commandRecorder.finish();
+
+            // THEN
+            CHECK(commandBuffer.isValid());
+            CHECK(renderPassRecorder.redundantStateStatistics().mergedIndirectDraws == 3);
+        }
+
+        SUBCASE("Indexed draws use their own tight stride")
+        {
+            // GIVEN
+            CommandRecorder commandRecorder = device.createCommandRecorder();
+            const std::array<DrawIndexedIndirectCommand, 3> drawCommands = {
+                DrawIndexedIndirectCommand{ .buffer = indirectBuffer, .offset = 0, .drawCount = 2 },
+                DrawIndexedIndirectCommand{ .buffer = indirectBuffer, .offset = 2 * drawIndexedRecordSize, .drawCount = 1 },
+                // The tight stride of indexed draws is larger, this isn't contiguous
+                DrawIndexedIndirectCommand{ .buffer = indirectBuffer, .offset = 3 * drawIndexedRecordSize + drawRecordSize, .drawCount = 1 },
+            };
+
+            // WHEN
+            RenderPassCommandRecorder renderPassRecorder = commandRecorder.beginRenderPass(renderPassOptions);
+            renderPassRecorder.setPipeline(pipeline);
+            renderPassRecorder.setVertexBuffer(0, vertexBuffer);
+            renderPassRecorder.setIndexBuffer(indexBuffer);
+            renderPassRecorder.drawIndexedIndirect(drawCommands);
+            renderPassRecorder.end();
+
+            CommandBuffer commandBuffer = commandRecorder.finish();
+
+            // THEN
+            CHECK(commandBuffer.isValid());
+            CHECK(renderPassRecorder.redundantStateStatistics().mergedIndirectDraws == 1);
+        }
+    }
+
+    TEST_CASE_FIXTURE(IndirectDrawFixture, "RenderPassCommandRecorder - Indirect count draws" * doctest::skip(!hasDrawIndirectCountSupport))
+    {
+        // GIVEN
+        REQUIRE(pipeline.isValid());
+        CommandRecorder commandRecorder = device.createCommandRecorder();
+        const uint32_t drawCount = 2;
+        const Buffer countBuffer = device.createBuffer(BufferOptions{
+                                                               .size = sizeof(uint32_t),
+                                                               .usage = BufferUsageFlagBits::IndirectBufferBit,
+                                                               .memoryUsage = MemoryUsage::CpuToGpu,
+                                                       },
+                                                       &drawCount);
+
+        // WHEN
+        RenderPassCommandRecorder renderPassRecorder = commandRecorder.beginRenderPass(renderPassOptions);
+        renderPassRecorder.setPipeline(pipeline);
+        renderPassRecorder.setVertexBuffer(0, vertexBuffer);
+        renderPassRecorder.setIndexBuffer(indexBuffer);
+        renderPassRecorder.drawIndirectCount(DrawIndirectCountCommand{
+                .buffer = indirectBuffer,
+                .countBuffer = countBuffer,
+                .maxDrawCount = 4,
+                .stride = drawRecordSize,
+        });
+        renderPassRecorder.drawIndexedIndirectCount(DrawIndexedIndirectCountCommand{
+                .buffer = indirectBuffer,
+                .countBuffer = countBuffer,
+                .maxDrawCount = 4,
+                .stride = drawIndexedRecordSize,
+        });
+        renderPassRecorder.end();
+
+        CommandBuffer commandBuffer = commandRecorder.finish();
+
+        // THEN
+        CHECK(commandBuffer.isValid());
+#if defined(VK_KHR_draw_indirect_count)
+        // Only loaded because the feature was requested
+        VulkanDevice *vulkanDevice = api->resourceManager()->getDevice(device);
+        CHECK(vulkanDevice->vkCmdDrawIndirectCountKHR != nullptr);
+        CHECK(vulkanDevice->vkCmdDrawIndexedIndirectCountKHR != nullptr);
+#endif
+    }
+
 #if defined(VK_KHR_dynamic_rendering)
     TEST_CASE("RenderPassCommandRecorder - Dynamic Rendering" * doctest::skip(!hasDynamicRenderingSupport))
     {
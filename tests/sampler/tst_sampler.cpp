@@ -125,6 +125,75 @@ TEST_SUITE("Sampler")
         }
     }
 
+    TEST_CASE("Deduplication")
+    {
+        Device device = discreteGPUAdapter->createDevice(DeviceOptions{
+                .deduplicateSamplers = true,
+        });
+
+        // GIVEN
+        const SamplerOptions samplerOptions{
+            .magFilter = FilterMode::Linear,
+            .minFilter = FilterMode::Linear,
+        };
+
+        SUBCASE("Identical options share the same Sampler regardless of label")
+        {
+            // GIVEN
+            SamplerOptions labelledOptions = samplerOptions;
+            labelledOptions.label = "Labelled";
+
+            // WHEN
+            Sampler a = device.createSampler(samplerOptions);
+            Sampler b = device.createSampler(labelledOptions);
+
+            // THEN
+            CHECK(a.isValid());
+            CHECK(a == b);
+            const CacheStatistics stats = device.samplerCacheStatistics();
+            CHECK(stats.hits == 1);
+            CHECK(stats.misses == 1);
+            CHECK(stats.entryCount == 1);
+        }
+
+        SUBCASE("Different options yield different Samplers")
+        {
+            // GIVEN
+            SamplerOptions otherOptions = samplerOptions;
+            otherOptions.u = AddressMode::ClampToEdge;
+
+            // WHEN
+            Sampler a = device.createSampler(samplerOptions);
+            Sampler b = device.createSampler(otherOptions);
+
+            // THEN
+            CHECK(a != b);
+            CHECK(device.samplerCacheStatistics().entryCount == 2);
+        }
+
+        SUBCASE("The shared Sampler is kept alive until its last user is released")
+        {
+            // GIVEN
+            Sampler a = device.createSampler(samplerOptions);
+            const Handle<Sampler_t> sharedHandle = a.handle();
+
+            {
+                Sampler b = device.createSampler(samplerOptions);
+                REQUIRE(b.handle() == sharedHandle);
+            }
+
+            // THEN
+            CHECK(api->resourceManager()->getSampler(sharedHandle) != nullptr);
+
+            // WHEN
+            a = {};
+
+            // THEN
+            CHECK(api->resourceManager()->getSampler(sharedHandle) == nullptr);
+            CHECK(device.samplerCacheStatistics().entryCount == 0);
+        }
+    }
+
 #if defined(VK_KHR_sampler_ycbcr_conversion)
     TEST_CASE("YUV Sampling" * doctest::skip(!discreteGPUAdapter->features().samplerYCbCrConversion))
     {
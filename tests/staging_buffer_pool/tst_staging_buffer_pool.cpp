@@ -81,10 +81,8 @@ TEST_SUITE("StagingBufferPool")
             CHECK(bin.buffer.isValid());
             CHECK(bin.buffer.handle() == result.second);
             CHECK(bin.isMapped == true);
-            CHECK(bin.m_allocations.size() == 1);
-            CHECK(bin.m_allocations[0].offset == 0);
-            CHECK(bin.m_allocations[0].offset == result.first);
-            CHECK(bin.m_allocations[0].size == 512);
+            CHECK(result.first == 0);
+            CHECK(bin.cursor == 512);
             CHECK(std::memcmp(bin.mapped, testData.data(), 512) == 0);
         }
 
@@ -106,13 +104,9 @@ TEST_SUITE("StagingBufferPool")
             CHECK(bin.buffer.handle() == r1.second);
             CHECK(bin.buffer.handle() == r2.second);
             CHECK(bin.isMapped == true);
-            CHECK(bin.m_allocations.size() == 2);
-            CHECK(bin.m_allocations[0].offset == 0);
-            CHECK(bin.m_allocations[0].offset == r1.first);
-            CHECK(bin.m_allocations[0].size == 512);
-            CHECK(bin.m_allocations[1].offset == 512);
-            CHECK(bin.m_allocations[1].offset == r2.first);
-            CHECK(bin.m_allocations[1].size == 512);
+            CHECK(r1.first == 0);
+            CHECK(r2.first == 512);
+            CHECK(bin.cursor == 1024);
             CHECK(std::memcmp(bin.mapped, testData.data(), 512) == 0);
             CHECK(std::memcmp(reinterpret_cast<uint8_t *>(bin.mapped) + 512, testData.data(), 512) == 0);
         }
@@ -140,14 +134,10 @@ TEST_SUITE("StagingBufferPool")
             CHECK(bin2.buffer.handle() == r2.second);
             CHECK(bin1.isMapped == false);
             CHECK(bin2.isMapped == true);
-            CHECK(bin1.m_allocations.size() == 1);
-            CHECK(bin2.m_allocations.size() == 1);
-            CHECK(bin1.m_allocations[0].offset == 0);
-            CHECK(bin1.m_allocations[0].offset == r1.first);
-            CHECK(bin1.m_allocations[0].size == 512);
-            CHECK(bin2.m_allocations[0].offset == 0);
-            CHECK(bin2.m_allocations[0].offset == r2.first);
-            CHECK(bin2.m_allocations[0].size == 768);
+            CHECK(r1.first == 0);
+            CHECK(r2.first == 0);
+            CHECK(bin1.cursor == 512);
+            CHECK(bin2.cursor == 768);
 
             // If we could map bin1
             // CHECK(std::memcmp(bin1.mapped, smallTestData.data(), 512) == 0);
@@ -179,17 +169,11 @@ TEST_SUITE("StagingBufferPool")
             CHECK(bin2.buffer.handle() == r2.second);
             CHECK(bin1.isMapped == true);
             CHECK(bin2.isMapped == false);
-            CHECK(bin1.m_allocations.size() == 2);
-            CHECK(bin2.m_allocations.size() == 1);
-            CHECK(bin1.m_allocations[0].offset == 0);
-            CHECK(bin1.m_allocations[0].offset == r1.first);
-            CHECK(bin1.m_allocations[0].size == 512);
-            CHECK(bin1.m_allocations[1].offset == 512);
-            CHECK(bin1.m_allocations[1].offset == r3.first);
-            CHECK(bin1.m_allocations[1].size == 512);
-            CHECK(bin2.m_allocations[0].offset == 0);
-            CHECK(bin2.m_allocations[0].offset == r2.first);
-            CHECK(bin2.m_allocations[0].size == 768);
+            CHECK(r1.first == 0);
+            CHECK(r2.first == 0);
+            CHECK(r3.first == 512);
+            CHECK(bin1.cursor == 1024);
+            CHECK(bin2.cursor == 768);
 
             CHECK(std::memcmp(bin1.mapped, smallTestData.data(), 512) == 0);
             CHECK(std::memcmp(reinterpret_cast<uint8_t *>(bin1.mapped) + 512, smallTestData.data(), 512) == 0);
@@ -233,6 +217,59 @@ TEST_SUITE("StagingBufferPool")
             CHECK(bin2.frameIndex == 1);
             CHECK(bin2.isMapped == true);
         }
+
+        SUBCASE("Aligns offsets when requested")
+        {
+            // GIVEN
+            KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+            KDGpuUtils::StagingBufferPoolImpl<1, 1024> stagingBufferPool(&device, &deleter);
+
+            // WHEN
+            const std::vector<uint8_t> testData = std::vector<uint8_t>(10, 0xaa);
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r1 = stagingBufferPool.stage(testData);
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r2 = stagingBufferPool.stage(testData, 16);
+
+            // THEN
+            REQUIRE(stagingBufferPool.bins().size() == 1);
+            CHECK(r1.first == 0);
+            CHECK(r2.first == 16);
+            CHECK(r2.second == r1.second);
+
+            // WHEN -> Padding that would overflow the bin moves to a new one
+            const std::vector<uint8_t> tailData = std::vector<uint8_t>(1024 - 32, 0xbb);
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r3 = stagingBufferPool.stage(tailData, 64);
+
+            // THEN
+            CHECK(r3.first == 0);
+            CHECK(r3.second != r1.second);
+        }
+
+        SUBCASE("Stages content larger than a bin in an oversized bin")
+        {
+            // GIVEN
+            KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+            KDGpuUtils::StagingBufferPoolImpl<1, 1024> stagingBufferPool(&device, &deleter);
+
+            // WHEN
+            const std::vector<uint8_t> smallTestData = std::vector<uint8_t>(512, 0xaa);
+            const std::vector<uint8_t> hugeTestData = std::vector<uint8_t>(3000, 0xee);
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r1 = stagingBufferPool.stage(smallTestData);
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r2 = stagingBufferPool.stage(hugeTestData);
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r3 = stagingBufferPool.stage(smallTestData);
+
+            // THEN -> Sized to the next power of two and not used for other allocations
+            REQUIRE(stagingBufferPool.bins().size() == 2);
+            const auto &bin1 = stagingBufferPool.bins()[0];
+            const auto &oversizedBin = stagingBufferPool.bins()[1];
+
+            CHECK(oversizedBin.size == 4096);
+            CHECK(oversizedBin.buffer.handle() == r2.second);
+            CHECK(oversizedBin.cursor == 3000);
+            CHECK(r2.first == 0);
+            CHECK(bin1.buffer.handle() == r1.second);
+            CHECK(bin1.buffer.handle() == r3.second);
+            CHECK(r3.first == 512);
+        }
     }
 
     TEST_CASE("Trims when moving to next frame")
@@ -277,7 +314,7 @@ TEST_SUITE("StagingBufferPool")
             // THEN
             REQUIRE(stagingBufferPool.bins().size() == 1);
             const auto &bin = stagingBufferPool.bins()[0];
-            CHECK(bin.m_allocations.size() == 5);
+            CHECK(bin.cursor == 5 * 512);
 
             // WHEN
             stagingBufferPool.flush();
@@ -286,7 +323,7 @@ TEST_SUITE("StagingBufferPool")
             // THEN
             CHECK(stagingBufferPool.bins().size() == 1);
             CHECK(bin.isMapped == false);
-            CHECK(bin.m_allocations.empty());
+            CHECK(bin.cursor == 0);
         }
 
         SUBCASE("Destroys excess bins")
@@ -370,5 +407,65 @@ TEST_SUITE("StagingBufferPool")
             CHECK(bins.size() == 1);
             CHECK(bins[0].resources.get<KDGpu::Buffer>().size() == 9);
         }
+
+        SUBCASE("Recycles oversized bins of the same size class")
+        {
+            // GIVEN
+            KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+            KDGpuUtils::StagingBufferPoolImpl<1, 1024> stagingBufferPool(&device, &deleter);
+            const std::vector<uint8_t> hugeTestData = std::vector<uint8_t>(3000, 0xee);
+            const std::vector<uint8_t> otherHugeTestData = std::vector<uint8_t>(2500, 0xaa);
+            const std::vector<uint8_t> largerTestData = std::vector<uint8_t>(5000, 0xbb);
+
+            // WHEN
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r1 = stagingBufferPool.stage(hugeTestData);
+            stagingBufferPool.stage(hugeTestData);
+            stagingBufferPool.flush();
+            stagingBufferPool.moveToNextFrame();
+
+            // THEN -> One bin is kept per size class
+            REQUIRE(stagingBufferPool.bins().size() == 1);
+            CHECK(stagingBufferPool.bins()[0].cursor == 0);
+            CHECK(deleter.frameBins()[0].resources.get<KDGpu::Buffer>().size() == 1);
+
+            // WHEN
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r2 = stagingBufferPool.stage(otherHugeTestData);
+            const std::pair<size_t, KDGpu::Handle<KDGpu::Buffer_t>> r3 = stagingBufferPool.stage(largerTestData);
+
+            // THEN
+            CHECK(r2.second == r1.second);
+            CHECK(r3.second != r1.second);
+            REQUIRE(stagingBufferPool.bins().size() == 2);
+            CHECK(stagingBufferPool.bins()[1].size == 8192);
+        }
+
+        SUBCASE("Releases oversized bins not used since the previous frame")
+        {
+            // GIVEN
+            KDGpuUtils::ResourceDeleter deleter(&device, MAX_FRAMES_IN_FLIGHT);
+            KDGpuUtils::StagingBufferPoolImpl<1, 1024> stagingBufferPool(&device, &deleter);
+            const std::vector<uint8_t> smallTestData = std::vector<uint8_t>(512, 0xaa);
+            const std::vector<uint8_t> hugeTestData = std::vector<uint8_t>(3000, 0xee);
+
+            // WHEN
+            stagingBufferPool.stage(smallTestData);
+            stagingBufferPool.stage(hugeTestData);
+            stagingBufferPool.flush();
+            stagingBufferPool.moveToNextFrame();
+
+            // THEN -> The oversized bin was used, so it is kept
+            REQUIRE(stagingBufferPool.bins().size() == 2);
+            CHECK(stagingBufferPool.bins()[1].size == 4096);
+
+            // WHEN -> A frame without oversized payloads
+            stagingBufferPool.stage(smallTestData);
+            stagingBufferPool.flush();
+            stagingBufferPool.moveToNextFrame();
+
+            // THEN -> Only the regular bin is left
+            REQUIRE(stagingBufferPool.bins().size() == 1);
+            CHECK(stagingBufferPool.bins()[0].size == 1024);
+            CHECK(deleter.frameBins()[0].resources.get<KDGpu::Buffer>().size() == 1);
+        }
     }
 }
@@ -0,0 +1,122 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/transient_bind_group_allocator.h>
+
+#include <KDGpu/bind_group_layout.h>
+#include <KDGpu/bind_group_layout_options.h>
+#include <KDGpu/buffer.h>
+#include <KDGpu/buffer_options.h>
+#include <KDGpu/device.h>
+#include <KDGpu/instance.h>
+#include <KDGpu/vulkan/vulkan_graphics_api.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_SUITE("TransientBindGroupAllocator")
+{
+    std::unique_ptr<KDGpu::GraphicsApi> api = std::make_unique<KDGpu::VulkanGraphicsApi>();
+    KDGpu::Instance instance = api->createInstance(KDGpu::InstanceOptions{
+            .applicationName = "TransientBindGroupAllocator",
+            .applicationVersion = KDGPU_MAKE_API_VERSION(0, 1, 0, 0) });
+    KDGpu::Adapter *discreteGPUAdapter = instance.selectAdapter(KDGpu::AdapterDeviceType::Default);
+    KDGpu::Device device = discreteGPUAdapter->createDevice();
+    constexpr size_t MAX_FRAMES_IN_FLIGHT = 2;
+
+    KDGpu::Buffer ubo = device.createBuffer(KDGpu::BufferOptions{
+            .size = 16 * sizeof(float),
+            .usage = KDGpu::BufferUsageFlagBits::UniformBufferBit,
+            .memoryUsage = KDGpu::MemoryUsage::CpuToGpu,
+    });
+    KDGpu::BindGroupLayout bindGroupLayout = device.createBindGroupLayout(KDGpu::BindGroupLayoutOptions{
+            .bindings = { { .binding = 0,
+                            .resourceType = KDGpu::ResourceBindingType::UniformBuffer,
+                            .shaderStages = KDGpu::ShaderStageFlags(KDGpu::ShaderStageFlagBits::VertexBit) } },
+    });
+    const KDGpu::BindGroupOptions bindGroupOptions = {
+        .layout = bindGroupLayout,
+        .resources = { { .binding = 0, .resource = KDGpu::UniformBufferBinding{ .buffer = ubo } } },
+    };
+
+    TEST_CASE("Creation")
+    {
+        // GIVEN
+        KDGpuUtils::TransientBindGroupAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT);
+
+        // THEN -> Pools are only created on demand
+        CHECK(allocator.frameIndex() == 0);
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+            CHECK(allocator.bindGroupPools(i).empty());
+    }
+
+    TEST_CASE("BindGroups are released when their frame is dereferenced")
+    {
+        // GIVEN
+        KDGpuUtils::TransientBindGroupAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT);
+
+        // WHEN
+        KDGpu::BindGroup bindGroup = allocator.createBindGroup(bindGroupOptions);
+        KDGpu::BindGroup droppedBindGroup = allocator.createBindGroup(bindGroupOptions);
+        droppedBindGroup = {};
+
+        // THEN
+        CHECK(bindGroup.isValid());
+        REQUIRE(allocator.bindGroupPools(0).size() == 1);
+        CHECK(!api->resourceManager()->getBindGroupPool(allocator.bindGroupPools(0)[0])->flags.testFlag(KDGpu::BindGroupPoolFlagBits::CreateFreeBindGroups));
+        CHECK(allocator.bindGroupPools(0)[0].allocatedBindGroupCount() == 2);
+
+        // WHEN -> Another frame allocates from its own pool
+        allocator.derefFrameIndex(1);
+        KDGpu::BindGroup otherFrameBindGroup = allocator.createBindGroup(bindGroupOptions);
+
+        // THEN
+        CHECK(otherFrameBindGroup.isValid());
+        CHECK(bindGroup.isValid());
+        CHECK(allocator.bindGroupPools(1).size() == 1);
+
+        // WHEN -> Going back to the first frame resets its pool as a whole
+        allocator.derefFrameIndex(0);
+
+        // THEN
+        CHECK(!bindGroup.isValid());
+        CHECK(otherFrameBindGroup.isValid());
+        CHECK(allocator.bindGroupPools(0)[0].allocatedBindGroupCount() == 0);
+    }
+
+    TEST_CASE("Exhausted frames grow an additional pool")
+    {
+        // GIVEN
+        KDGpuUtils::TransientBindGroupAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT,
+                                                          KDGpu::BindGroupPoolOptions{
+                                                                  .uniformBufferCount = 2,
+                                                                  .maxBindGroupCount = 2,
+                                                          });
+
+        // WHEN
+        std::vector<KDGpu::BindGroup> bindGroups;
+        for (size_t i = 0; i < 3; ++i)
+            bindGroups.emplace_back(allocator.createBindGroup(bindGroupOptions));
+
+        // THEN
+        for (const KDGpu::BindGroup &bindGroup : bindGroups)
+            CHECK(bindGroup.isValid());
+        CHECK(allocator.bindGroupPools(0).size() == 2);
+
+        // WHEN -> The pools are kept when the frame comes around again
+        allocator.derefFrameIndex(0);
+        bindGroups.clear();
+        for (size_t i = 0; i < 3; ++i)
+            bindGroups.emplace_back(allocator.createBindGroup(bindGroupOptions));
+
+        // THEN
+        CHECK(allocator.bindGroupPools(0).size() == 2);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+  This file is part of KDGpu.
+
+  SPDX-FileCopyrightText: 2025 Klarälvdalens Datakonsult AB, a KDAB Group company <info@kdab.com>
+
+  SPDX-License-Identifier: MIT
+
+  Contact KDAB at <info@kdab.com> for commercial licensing options.
+*/
+
+#include <KDGpuUtils/uniform_ring_allocator.h>
+
+#include <KDGpu/bind_group_layout.h>
+#include <KDGpu/bind_group_layout_options.h>
+#include <KDGpu/device.h>
+#include <KDGpu/instance.h>
+#include <KDGpu/vulkan/vulkan_graphics_api.h>
+
+#include <array>
+#include <cstring>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest.h>
+
+TEST_SUITE("UniformRingAllocator")
+{
+    std::unique_ptr<KDGpu::GraphicsApi> api = std::make_unique<KDGpu::VulkanGraphicsApi>();
+    KDGpu::Instance instance = api->createInstance(KDGpu::InstanceOptions{
+            .applicationName = "UniformRingAllocator",
+            .applicationVersion = KDGPU_MAKE_API_VERSION(0, 1, 0, 0) });
+    KDGpu::Adapter *discreteGPUAdapter = instance.selectAdapter(KDGpu::AdapterDeviceType::Default);
+    KDGpu::Device device = discreteGPUAdapter->createDevice();
+    constexpr size_t MAX_FRAMES_IN_FLIGHT = 2;
+
+    KDGpu::BindGroupLayout bindGroupLayout = device.createBindGroupLayout(KDGpu::BindGroupLayoutOptions{
+            .bindings = { { .binding = 0,
+                            .resourceType = KDGpu::ResourceBindingType::DynamicUniformBuffer,
+                            .shaderStages = KDGpu::ShaderStageFlags(KDGpu::ShaderStageFlagBits::VertexBit) } },
+    });
+    const KDGpuUtils::UniformRingAllocatorOptions allocatorOptions{
+        .bindGroupLayout = bindGroupLayout,
+        .bindingSize = 64,
+        .frameSegmentSize = 4096,
+    };
+
+    TEST_CASE("Creation")
+    {
+        // GIVEN
+        KDGpuUtils::UniformRingAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT, allocatorOptions);
+
+        // THEN
+        CHECK(allocator.buffer().isValid());
+        CHECK(allocator.bindGroup().isValid());
+        CHECK(allocator.alignment() == std::max<size_t>(discreteGPUAdapter->properties().limits.minUniformBufferOffsetAlignment, 1));
+        CHECK(allocator.frameSegmentSize() % allocator.alignment() == 0);
+        CHECK(allocator.usedSize() == 0);
+    }
+
+    TEST_CASE("Allocations are aligned and share the BindGroup")
+    {
+        // GIVEN
+        KDGpuUtils::UniformRingAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT, allocatorOptions);
+        const std::array<float, 4> color = { 1.0f, 0.0f, 0.0f, 1.0f };
+
+        // WHEN
+        const KDGpuUtils::UniformRingAllocation a = allocator.allocate(color);
+        const KDGpuUtils::UniformRingAllocation b = allocator.allocate(color);
+        allocator.flush();
+
+        // THEN
+        REQUIRE(a.isValid());
+        REQUIRE(b.isValid());
+        CHECK(a.bindGroup == allocator.bindGroup().handle());
+        CHECK(b.bindGroup == a.bindGroup);
+        CHECK(a.dynamicOffset == 0);
+        CHECK(b.dynamicOffset % allocator.alignment() == 0);
+        CHECK(b.dynamicOffset >= sizeof(color));
+        CHECK(std::memcmp(b.data, color.data(), sizeof(color)) == 0);
+    }
+
+    TEST_CASE("Each frame allocates from its own segment")
+    {
+        // GIVEN
+        KDGpuUtils::UniformRingAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT, allocatorOptions);
+
+        // WHEN
+        const KDGpuUtils::UniformRingAllocation frame0Allocation = allocator.allocate(16);
+        allocator.derefFrameIndex(1);
+        const KDGpuUtils::UniformRingAllocation frame1Allocation = allocator.allocate(16);
+
+        // THEN
+        CHECK(frame0Allocation.dynamicOffset == 0);
+        CHECK(frame1Allocation.dynamicOffset == allocator.frameSegmentSize());
+
+        // WHEN -> Coming back to a frame rewinds its segment
+        allocator.derefFrameIndex(0);
+
+        // THEN
+        CHECK(allocator.usedSize() == 0);
+        CHECK(allocator.allocate(16).dynamicOffset == 0);
+    }
+
+    TEST_CASE("A full segment returns invalid allocations")
+    {
+        // GIVEN
+        KDGpuUtils::UniformRingAllocator allocator(&device, MAX_FRAMES_IN_FLIGHT, allocatorOptions);
+        const size_t stride = std::max<size_t>(allocator.alignment(), 64);
+
+        // WHEN
+        for (size_t i = 0; i < allocator.frameSegmentSize() / stride; ++i)
+            REQUIRE(allocator.allocate(64).isValid());
+
+        // THEN
+        CHECK(!allocator.allocate(64).isValid());
+    }
+}